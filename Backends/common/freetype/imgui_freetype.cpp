@@ -16,6 +16,7 @@
 // - v0.63: (2020/06/04) fix for rare case where FT_Get_Char_Index() succeed but FT_Load_Glyph() fails.
 // - v0.64: (2021/01/18) add FT_Error in loading function call flag for a way for get freetype error message when bad font file
 // - v0.65: (2021/01/20) add copy/past function form ImDraw and specific for COLOR support in freetype from PR : https://github.com/ocornut/imgui/pull/336, for avoid modification of ImDraw
+// - v0.66: (2021/02/14) glyphs are rasterized on worker threads (one FT_Library/FT_Face per thread), FT_Library are reused between builds via a pool. see SetBuildThreadsCount()
 
 // Gamma Correct Blending:
 //  FreeType assumes blending in linear space rather than gamma space.
@@ -29,6 +30,11 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include "imgui_internal.h"     // ImMin,ImMax,ImFontAtlasBuild*,
 #include <stdint.h>
+#include <stdlib.h>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <ft2build.h>
 #include FT_FREETYPE_H          // <freetype/freetype.h>
 #include FT_MODULE_H            // <freetype/ftmodapi.h>
@@ -350,6 +356,8 @@ struct ImFontBuildSrcDataFT
 {
     FreeTypeFont        Font;
     stbrp_rect*         Rects;              // Rectangle to pack. We first fill in their size and the packer will give us their position.
+    bool                MultiplyEnabled;    // cfg.RasterizerMultiply != 1.0f
+    unsigned char       MultiplyTable[256];
     const ImWchar*      SrcRanges;          // Ranges as requested by user (user is allowed to request too much, e.g. 0x0020..0xFFFF)
     int                 DstIndex;           // Index into atlas->Fonts[] and dst_tmp_array[]
     int                 GlyphsHighest;      // Highest requested codepoint
@@ -358,6 +366,49 @@ struct ImFontBuildSrcDataFT
     ImVector<ImFontBuildSrcGlyphFT>   GlyphsList;
 };
 
+// A part of the glyphs list of one source font, rasterized by one thread
+struct ImFontBuildRasterJobFT
+{
+    int                 SrcIndex;
+    int                 GlyphBegin;
+    int                 GlyphEnd;
+};
+
+// Temporary rasterization data buffers, allocated in chunks.
+// malloc/free are used (not IM_ALLOC/IM_FREE) because they are thread safe
+struct ImFontBuildBitmapBuffersFT
+{
+    std::vector<unsigned char*> Buffers;
+    int                 CurrentUsedBytes = 0;
+
+    ImFontBuildBitmapBuffersFT() = default;
+    ImFontBuildBitmapBuffersFT(const ImFontBuildBitmapBuffersFT&) = delete; // the buffers are owned
+    ImFontBuildBitmapBuffersFT& operator =(const ImFontBuildBitmapBuffersFT&) = delete;
+
+    unsigned int* Alloc(int size_in_bytes)
+    {
+        const int BITMAP_BUFFERS_CHUNK_SIZE = 256 * 1024;
+        if (Buffers.empty() || CurrentUsedBytes + size_in_bytes > BITMAP_BUFFERS_CHUNK_SIZE)
+        {
+            CurrentUsedBytes = 0;
+            Buffers.push_back((unsigned char*)malloc((size_t)ImMax(BITMAP_BUFFERS_CHUNK_SIZE, size_in_bytes)));
+        }
+        unsigned int* ptr = (unsigned int*)(Buffers.back() + CurrentUsedBytes);
+        CurrentUsedBytes += size_in_bytes;
+        return ptr;
+    }
+
+    void Clear()
+    {
+        for (auto buffer : Buffers)
+            free(buffer);
+        Buffers.clear();
+        CurrentUsedBytes = 0;
+    }
+
+    ~ImFontBuildBitmapBuffersFT() { Clear(); }
+};
+
 // Temporary data for one destination ImFont* (multiple source fonts can be merged into one destination ImFont)
 struct ImFontBuildDstDataFT
 {
@@ -557,6 +608,54 @@ void ImFreeTypeFontAtlasBuildFinish(ImFontAtlas* atlas)
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////////
 
+// Rasterize glyphs [glyph_begin, glyph_end[ of a source font, and fill their rects sizes
+// the glyphs of the range are only touched by one thread, return the surface of the rects
+static int ImFreeTypeRasterizeGlyphs(FreeTypeFont& font, ImFontBuildSrcDataFT& src_tmp, int glyph_begin, int glyph_end, int padding, ImFontBuildBitmapBuffersFT& buffers)
+{
+    int surface = 0;
+    for (int glyph_i = glyph_begin; glyph_i < glyph_end; glyph_i++)
+    {
+        ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
+
+        const FT_Glyph_Metrics* metrics = font.LoadGlyph(src_glyph.Codepoint);
+        if (metrics == NULL)
+            continue;
+
+        // Render glyph into a bitmap (currently held by FreeType)
+        const FT_Bitmap* ft_bitmap = font.RenderGlyphAndGetInfo(&src_glyph.Info);
+        IM_ASSERT(ft_bitmap);
+
+        // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
+        const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height * 4;
+        src_glyph.BitmapData = buffers.Alloc(bitmap_size_in_bytes);
+        font.BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width, src_tmp.MultiplyEnabled ? src_tmp.MultiplyTable : NULL);
+
+        src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
+        src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
+        surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+    }
+    return surface;
+}
+
+// Pool of FT_Library, reused between the builds (one per rasterization thread)
+static FT_Library   ImFreeTypeAcquireLibrary(FT_Error* vFT_Error = NULL);
+static void         ImFreeTypeReleaseLibrary(FT_Library ft_library);
+
+// 0 => std::thread::hardware_concurrency()
+static int GImFreeTypeBuildThreadsCount = 0;
+
+// under this count of glyphs, the threads cost more than they give
+static const int FT_BUILD_MIN_GLYPHS_PER_THREAD = 256;
+
+static int ImFreeTypeGetBuildThreadsCount(int glyphs_count)
+{
+    int threads_count = GImFreeTypeBuildThreadsCount;
+    if (threads_count <= 0)
+        threads_count = (int)std::thread::hardware_concurrency();
+    threads_count = ImMin(threads_count, glyphs_count / FT_BUILD_MIN_GLYPHS_PER_THREAD);
+    return ImMax(threads_count, 1);
+}
+
 bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, unsigned int extra_flags, FT_Error *vFT_Error)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -673,15 +772,16 @@ bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, uns
     // We could not find a way to retrieve accurate glyph size without rendering them.
     // (e.g. slot->metrics->width not always matching bitmap->width, especially considering the Oblique transform)
     // We allocate in chunks of 256 KB to not waste too much extra memory ahead. Hopefully users of FreeType won't find the temporary allocations.
-    const int BITMAP_BUFFERS_CHUNK_SIZE = 256 * 1024;
-    int buf_bitmap_current_used_bytes = 0;
-    ImVector<unsigned char*> buf_bitmap_buffers;
-    buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
+    // one set of buffers per rasterization thread
+    const int threads_count = ImFreeTypeGetBuildThreadsCount(total_glyphs_count);
+    std::vector<ImFontBuildBitmapBuffersFT> buf_bitmap_buffers((size_t)threads_count);
 
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
     // 8. Render/rasterize font characters into the texture
     int total_surface = 0;
     int buf_rects_out_n = 0;
+    std::vector<ImFontBuildRasterJobFT> raster_jobs;
+    const int glyphs_per_job = ImMax(FT_BUILD_MIN_GLYPHS_PER_THREAD / 4, total_glyphs_count / (threads_count * 8));
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcDataFT& src_tmp = src_tmp_array[src_i];
@@ -693,42 +793,100 @@ bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, uns
         buf_rects_out_n += src_tmp.GlyphsCount;
 
         // Compute multiply table if requested
-        const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
-        unsigned char multiply_table[256];
-        if (multiply_enabled)
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        src_tmp.MultiplyEnabled = (cfg.RasterizerMultiply != 1.0f);
+        if (src_tmp.MultiplyEnabled)
+            ImFontAtlasBuildMultiplyCalcLookupTable(src_tmp.MultiplyTable, cfg.RasterizerMultiply);
 
-        // Gather the sizes of all rectangles we will need to pack
-        const int padding = atlas->TexGlyphPadding;
-        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i += glyphs_per_job)
         {
-            ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
+            ImFontBuildRasterJobFT job;
+            job.SrcIndex = src_i;
+            job.GlyphBegin = glyph_i;
+            job.GlyphEnd = ImMin(glyph_i + glyphs_per_job, src_tmp.GlyphsList.Size);
+            raster_jobs.push_back(job);
+        }
+    }
 
-            const FT_Glyph_Metrics* metrics = src_tmp.Font.LoadGlyph(src_glyph.Codepoint);
-            if (metrics == NULL)
-                continue;
+    const int padding = atlas->TexGlyphPadding;
+    if (threads_count == 1)
+    {
+        // Gather the sizes of all rectangles we will need to pack
+        for (const auto& job : raster_jobs)
+        {
+            ImFontBuildSrcDataFT& src_tmp = src_tmp_array[job.SrcIndex];
+            total_surface += ImFreeTypeRasterizeGlyphs(src_tmp.Font, src_tmp, job.GlyphBegin, job.GlyphEnd, padding, buf_bitmap_buffers[0]);
+        }
+    }
+    else
+    {
+        // each thread have is own FT_Library and FT_Face's, a FT_Face cant be used by many threads
+        std::atomic<int> next_job(0);
+        std::atomic<int> surface(0);
+        std::atomic<bool> failed(false);
+        std::atomic<FT_Error> first_error(0); // the first error of the workers, reported to the caller
+        auto set_failed = [&](FT_Error error)
+        {
+            FT_Error no_error = 0;
+            first_error.compare_exchange_strong(no_error, error);
+            failed = true;
+        };
+        auto worker = [&](int thread_i)
+        {
+            FT_Error worker_error = 0;
+            FT_Library worker_library = ImFreeTypeAcquireLibrary(&worker_error);
+            if (worker_library == NULL)
+            {
+                set_failed(worker_error);
+                return;
+            }
 
-            // Render glyph into a bitmap (currently held by FreeType)
-            const FT_Bitmap* ft_bitmap = src_tmp.Font.RenderGlyphAndGetInfo(&src_glyph.Info);
-            IM_ASSERT(ft_bitmap);
+            // faces opened only for the sources this thread work on
+            std::vector<FreeTypeFont> worker_fonts((size_t)src_tmp_array.Size);
+            std::vector<bool> worker_fonts_ok((size_t)src_tmp_array.Size, false);
 
-            // Allocate new temporary chunk if needed
-            const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height * 4;
-            if (buf_bitmap_current_used_bytes + bitmap_size_in_bytes > BITMAP_BUFFERS_CHUNK_SIZE)
+            int worker_surface = 0;
+            int job_i;
+            while (!failed && (job_i = next_job++) < (int)raster_jobs.size())
             {
-                buf_bitmap_current_used_bytes = 0;
-                buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
+                const ImFontBuildRasterJobFT& job = raster_jobs[(size_t)job_i];
+                FreeTypeFont& worker_font = worker_fonts[(size_t)job.SrcIndex];
+                if (!worker_fonts_ok[(size_t)job.SrcIndex])
+                {
+                    if (!worker_font.InitFont(worker_library, atlas->ConfigData[job.SrcIndex], extra_flags, &worker_error))
+                    {
+                        set_failed(worker_error);
+                        break;
+                    }
+                    worker_fonts_ok[(size_t)job.SrcIndex] = true;
+                }
+
+                ImFontBuildSrcDataFT& src_tmp = src_tmp_array[job.SrcIndex];
+                worker_surface += ImFreeTypeRasterizeGlyphs(worker_font, src_tmp, job.GlyphBegin, job.GlyphEnd, padding, buf_bitmap_buffers[(size_t)thread_i]);
             }
+            surface += worker_surface;
+
+            // the faces must be closed before the library go back in the pool
+            for (auto& worker_font : worker_fonts)
+                worker_font.CloseFont();
+            ImFreeTypeReleaseLibrary(worker_library);
+        };
 
-            // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
-            src_glyph.BitmapData = (unsigned int*)(buf_bitmap_buffers.back() + buf_bitmap_current_used_bytes);
-            buf_bitmap_current_used_bytes += bitmap_size_in_bytes;
-            src_tmp.Font.BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width, multiply_enabled ? multiply_table : NULL);
+        std::vector<std::thread> workers;
+        for (int thread_i = 0; thread_i < threads_count; thread_i++)
+            workers.emplace_back(worker, thread_i);
+        for (auto& thread : workers)
+            thread.join();
 
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
-            total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+        if (failed)
+        {
+            if (vFT_Error)
+                *vFT_Error = first_error;
+            for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+                src_tmp_array[src_i].~ImFontBuildSrcDataFT();
+            return false;
         }
+
+        total_surface = surface;
     }
 
     // We need a width for the skyline algorithm, any width!
@@ -854,8 +1012,7 @@ bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, uns
     }
 
     // Cleanup
-    for (int buf_i = 0; buf_i < buf_bitmap_buffers.Size; buf_i++)
-        IM_FREE(buf_bitmap_buffers[buf_i]);
+    buf_bitmap_buffers.clear();
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
         src_tmp_array[src_i].~ImFontBuildSrcDataFT();
 
@@ -865,8 +1022,10 @@ bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, uns
 }
 
 // Default memory allocators
-static void* ImFreeTypeDefaultAllocFunc(size_t size, void* user_data)   { IM_UNUSED(user_data); return IM_ALLOC(size); }
-static void  ImFreeTypeDefaultFreeFunc(void* ptr, void* user_data)      { IM_UNUSED(user_data); IM_FREE(ptr); }
+// malloc/free and not IM_ALLOC/IM_FREE, because FreeType is called from the rasterization threads
+// and the imgui allocation counter is not thread safe
+static void* ImFreeTypeDefaultAllocFunc(size_t size, void* user_data)   { IM_UNUSED(user_data); return malloc(size); }
+static void  ImFreeTypeDefaultFreeFunc(void* ptr, void* user_data)      { IM_UNUSED(user_data); free(ptr); }
 
 // Current memory allocators
 static void* (*GImFreeTypeAllocFunc)(size_t size, void* user_data) = ImFreeTypeDefaultAllocFunc;
@@ -917,32 +1076,77 @@ const char* ImGuiFreeType::GetErrorMessage(FT_Error err)
     return "(Unknown error)";
 }
 
-bool ImGuiFreeType::BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags, FT_Error* vFreetypeError)
+// FreeType memory management: https://www.freetype.org/freetype2/docs/design/design-4.html
+// the FT_Library keep a pointer on it, so it must live as long as the pooled libraries
+static FT_MemoryRec_ GImFreeTypeMemoryRec = { NULL, &FreeType_Alloc, &FreeType_Free, &FreeType_Realloc };
+
+static std::mutex GImFreeTypeLibraryPoolMutex;
+static std::vector<FT_Library> GImFreeTypeLibraryPool;
+
+static FT_Library ImFreeTypeAcquireLibrary(FT_Error* vFT_Error)
 {
-    // FreeType memory management: https://www.freetype.org/freetype2/docs/design/design-4.html
-    FT_MemoryRec_ memory_rec = {};
-    memory_rec.user = NULL;
-    memory_rec.alloc = &FreeType_Alloc;
-    memory_rec.free = &FreeType_Free;
-    memory_rec.realloc = &FreeType_Realloc;
+    {
+        std::lock_guard<std::mutex> lock(GImFreeTypeLibraryPoolMutex);
+        if (!GImFreeTypeLibraryPool.empty())
+        {
+            FT_Library ft_library = GImFreeTypeLibraryPool.back();
+            GImFreeTypeLibraryPool.pop_back();
+            return ft_library;
+        }
+    }
 
     // https://www.freetype.org/freetype2/docs/reference/ft2-module_management.html#FT_New_Library
-    FT_Library ft_library;
-    FT_Error error = FT_New_Library(&memory_rec, &ft_library);
+    FT_Library ft_library = NULL;
+    FT_Error error = FT_New_Library(&GImFreeTypeMemoryRec, &ft_library);
+    if (vFT_Error)
+        *vFT_Error = error;
     if (error != 0)
-        return false;
+        return NULL;
 
     // If you don't call FT_Add_Default_Modules() the rest of code may work, but FreeType won't use our custom allocator.
     FT_Add_Default_Modules(ft_library);
 
+    return ft_library;
+}
+
+static void ImFreeTypeReleaseLibrary(FT_Library ft_library)
+{
+    if (ft_library == NULL)
+        return;
+    std::lock_guard<std::mutex> lock(GImFreeTypeLibraryPoolMutex);
+    GImFreeTypeLibraryPool.push_back(ft_library);
+}
+
+bool ImGuiFreeType::BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags, FT_Error* vFreetypeError)
+{
+    FT_Library ft_library = ImFreeTypeAcquireLibrary(vFreetypeError);
+    if (ft_library == NULL)
+        return false;
+
     bool ret = ImFontAtlasBuildWithFreeType(ft_library, atlas, extra_flags, vFreetypeError);
-    FT_Done_Library(ft_library);
+    ImFreeTypeReleaseLibrary(ft_library);
 
     return ret;
 }
 
+void ImGuiFreeType::SetBuildThreadsCount(int threads_count)
+{
+    GImFreeTypeBuildThreadsCount = threads_count;
+}
+
+void ImGuiFreeType::ReleaseLibraryPool()
+{
+    std::lock_guard<std::mutex> lock(GImFreeTypeLibraryPoolMutex);
+    for (auto ft_library : GImFreeTypeLibraryPool)
+        FT_Done_Library(ft_library);
+    GImFreeTypeLibraryPool.clear();
+}
+
 void ImGuiFreeType::SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void (*free_func)(void* ptr, void* user_data), void* user_data)
 {
+    // the pooled libraries was created with the previous allocators
+    ReleaseLibraryPool();
+
     GImFreeTypeAllocFunc = alloc_func;
     GImFreeTypeFreeFunc = free_func;
     GImFreeTypeAllocatorUserData = user_data;
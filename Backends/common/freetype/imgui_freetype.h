@@ -39,6 +39,13 @@ namespace ImGuiFreeType
 
     IMGUI_API bool BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags = 0, FT_Error* vFreetypeError = 0);
 
+    // The glyphs are rasterized on many threads (one FT_Library/FT_Face per thread) when there is enough glyphs.
+    // 0 (default) => std::thread::hardware_concurrency(), 1 => no threads
+    IMGUI_API void SetBuildThreadsCount(int threads_count);
+
+    // The FT_Library are reused between builds. Call it at exit for destroy them.
+    IMGUI_API void ReleaseLibraryPool();
+
     // By default ImGuiFreeType will use IM_ALLOC()/IM_FREE().
     // However, as FreeType does lots of allocations we provide a way for the user to redirect it to a separate memory heap if desired:
     IMGUI_API void SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void (*free_func)(void* ptr, void* user_data), void* user_data = NULL);
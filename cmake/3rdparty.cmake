@@ -6,6 +6,9 @@ if (CMAKE_SYSTEM_NAME STREQUAL Linux)
   endif ()
 endif ()
 
+## for the worker threads (card rendering)
+find_package(Threads REQUIRED)
+
 if (USE_VULKAN)
 	find_package(Vulkan REQUIRED)
 	add_definitions(-DVULKAN)
@@ -8,6 +8,9 @@
 
 #include <ctools/FileHelper.h>
 #include <MainFrame.h>
+#include <Helper/EventLoopHelper.h>
+#include <Helper/MemoryTracker.h>
+#include <Generator/GeneratorBenchmark.h>
 #include <Res/CustomFont.cpp>
 #include <Res/Roboto_Medium.cpp>
 #include <common/freetype/imgui_freetype.h>
@@ -41,8 +44,10 @@ static void glfw_window_close_callback(GLFWwindow* window)
     MainFrame::Instance()->IWantToCloseTheApp();
 }
 
-int main(int, char** argv)
+int main(int argc, char** argv)
 {
+    MemoryTracker::Instance()->InstallAllocators(); // before any imgui allocation
+
     FileHelper::Instance()->SetAppPath(std::string(argv[0]));
 #ifdef _DEBUG
     FileHelper::Instance()->SetCurDirectory(PROJECT_PATH);
@@ -71,6 +76,11 @@ int main(int, char** argv)
     //glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);            // 3.0+ only
 #endif
 
+    // the benchmark need a gl context for the fonts atlas, but not a visible window
+    const bool benchmarkAsked = GeneratorBenchmark::IsBenchmarkAsked(argc, argv);
+    if (benchmarkAsked)
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
     // Create window with graphics context
     GLFWwindow* mainWindow = glfwCreateWindow(1280, 720, "ImGuiFontStudio", nullptr, nullptr);
     if (mainWindow == 0)
@@ -127,6 +137,23 @@ int main(int, char** argv)
         return 1;
     }
 
+    if (benchmarkAsked)
+    {
+        int exitCode = 1;
+        GeneratorBenchmarkParams benchmarkParams;
+        if (GeneratorBenchmark::ParseArgs(argc, argv, &benchmarkParams))
+            exitCode = GeneratorBenchmark(benchmarkParams).Run();
+
+        ImGui_ImplOpenGL3_Shutdown();
+        ImGui_ImplGlfw_Shutdown();
+        ImGui::DestroyContext();
+        ImGuiFreeType::ReleaseLibraryPool();
+        glfwDestroyWindow(mainWindow);
+        glfwTerminate();
+
+        return exitCode;
+    }
+
     MainFrame::Instance(mainWindow)->Init();
 
     // Main loop
@@ -137,8 +164,9 @@ int main(int, char** argv)
         // maintain active, prevent user change via imgui dialog
         io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
 
+        // wait for events when idle (event driven mode), else poll
+        EventLoopHelper::Instance()->WaitOrPollEvents();
         glfwGetFramebufferSize(mainWindow, &display_w, &display_h);
-        glfwPollEvents();
 
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
@@ -178,6 +206,8 @@ int main(int, char** argv)
         }
 
         glfwSwapBuffers(mainWindow);
+
+        EventLoopHelper::Instance()->EndFrame();
     }
 
     MainFrame::Instance()->Unit();
@@ -185,6 +215,7 @@ int main(int, char** argv)
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
+    ImGuiFreeType::ReleaseLibraryPool();
 
     glfwDestroyWindow(mainWindow);
     glfwTerminate();
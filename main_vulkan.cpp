@@ -18,6 +18,8 @@
 
 #include <ctools/FileHelper.h>
 #include <MainFrame.h>
+#include <Helper/EventLoopHelper.h>
+#include <Helper/MemoryTracker.h>
 #include <Res/CustomFont.cpp>
 #include <Res/Roboto_Medium.cpp>
 #include <common/freetype/imgui_freetype.h>
@@ -375,6 +377,8 @@ static void glfw_error_callback(int error, const char* description)
 
 int main(int, char** argv)
 {
+    MemoryTracker::Instance()->InstallAllocators(); // before any imgui allocation
+
     FileHelper::Instance()->SetAppPath(std::string(argv[0]));
 #ifdef _DEBUG
     FileHelper::Instance()->SetCurDirectory(PROJECT_PATH);
@@ -510,8 +514,9 @@ int main(int, char** argv)
         // maintain active, prevent user change via imgui dialog
         io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
 
+        // wait for events when idle (event driven mode), else poll
+        EventLoopHelper::Instance()->WaitOrPollEvents();
         glfwGetFramebufferSize(mainWindow, &display_w, &display_h);
-        glfwPollEvents();
 
         // Resize swap chain?
         if (g_SwapChainRebuild)
@@ -574,6 +579,11 @@ int main(int, char** argv)
         // Present Main Platform Window
         if (!main_is_minimized && !TextureHelper::sNeedToSkipRendering)
             FramePresent(wd);
+
+        if (g_SwapChainRebuild)
+            EventLoopHelper::Instance()->RequestFrames(); // the swap chain will be rebuilt at next frame
+
+        EventLoopHelper::Instance()->EndFrame();
     }
 
     MainFrame::Instance()->Unit();
@@ -584,6 +594,7 @@ int main(int, char** argv)
     ImGui_ImplVulkan_Shutdown();
     ImGui_ImplGlfw_Shutdown();
     ImGui::DestroyContext();
+    ImGuiFreeType::ReleaseLibraryPool();
 
     CleanupVulkanWindow();
     CleanupVulkan();
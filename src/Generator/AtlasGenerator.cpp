@@ -0,0 +1,537 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AtlasGenerator.h"
+
+#include <Generator/GenerationProfiler.h>
+#include <Generator/Generator.h>
+#include <Helper/Messaging.h>
+#include <Project/FontInfos.h>
+#include <ctools/cTools.h>
+#include <ctools/FileHelper.h>
+
+#include <imgui/imgui.h>
+
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+
+#define PREBAKED_ATLAS_MAGIC "IFSA"
+#define PREBAKED_ATLAS_PADDING 1U // empty texels between two glyphs, avoid bleeding with linear filtering
+#define PREBAKED_ATLAS_WHITE_RECT_SIZE 2U
+
+static FILE* OpenFile(const std::string& vFilePathName, const char* vMode)
+{
+#ifdef MSVC
+	FILE* f = nullptr;
+	errno_t err = fopen_s(&f, vFilePathName.c_str(), vMode);
+	if (err) return nullptr;
+	return f;
+#else
+	return fopen(vFilePathName.c_str(), vMode);
+#endif
+}
+
+static void PushU32(std::vector<uint8_t>& vBuffer, const uint32_t& vValue)
+{
+	vBuffer.push_back((uint8_t)(vValue & 0xFF));
+	vBuffer.push_back((uint8_t)((vValue >> 8) & 0xFF));
+	vBuffer.push_back((uint8_t)((vValue >> 16) & 0xFF));
+	vBuffer.push_back((uint8_t)((vValue >> 24) & 0xFF));
+}
+
+static void PushF32(std::vector<uint8_t>& vBuffer, const float& vValue)
+{
+	uint32_t bits = 0U;
+	memcpy(&bits, &vValue, sizeof(float));
+	PushU32(vBuffer, bits);
+}
+
+// float as a valid c++ literal, ex : 1 => 1.0f, 0.5 => 0.5f
+static std::string ToFloatLiteral(const float& vValue)
+{
+	std::string res = ct::toStr("%.9g", vValue);
+	if (res.find_first_of(".eE") == std::string::npos)
+		res += ".0";
+	else if (res.find('.') == std::string::npos) // exponent without dot
+		res = ct::toStr("%.1f", vValue);
+	return res + "f";
+}
+
+static uint32_t NextPowerOfTwo(const uint32_t& vValue)
+{
+	uint32_t res = 1U;
+	while (res < vValue)
+		res <<= 1;
+	return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool AtlasGenerator::BakeAtlas(const std::vector<std::shared_ptr<FontInfos>>& vFonts, PrebakedAtlasStruct* vOutAtlas)
+{
+	GenerationStageScope stage("AtlasGenerator::BakeAtlas");
+
+	if (vFonts.empty() || !vOutAtlas)
+		return false;
+
+	*vOutAtlas = PrebakedAtlasStruct();
+
+	std::vector<PrebakedRectStruct> rects;
+
+	size_t fontIdx = 0U;
+	for (auto fontInfos : vFonts)
+	{
+		// the glyphs are already rasterized, so only checked between the fonts
+		if (Generator::Instance()->CheckCancel())
+			return false;
+		Generator::Instance()->SetOutputProgress((float)(fontIdx++) / (float)vFonts.size());
+
+		if (!fontInfos) continue;
+
+		auto font = fontInfos->GetImFont();
+		auto atlas = &fontInfos->m_ImFontAtlas;
+		if (!font || atlas->TexWidth <= 0 || atlas->TexHeight <= 0)
+		{
+			Messaging::Instance()->AddError(true, nullptr, nullptr,
+				"The atlas of the font %s is not built. aborting.", fontInfos->m_FontFileName.c_str());
+			return false;
+		}
+
+		// we read the texture already built, GetTexDataAsAlpha8 would rebuild it when only the rgba32 one exist
+		PrebakedRectStruct srcRect;
+		srcRect.srcPitch = (uint32_t)atlas->TexWidth;
+		if (atlas->TexPixelsAlpha8)
+		{
+			srcRect.srcPixels = atlas->TexPixelsAlpha8;
+			srcRect.srcBpp = 1U;
+		}
+		else if (atlas->TexPixelsRGBA32)
+		{
+			srcRect.srcPixels = (const uint8_t*)atlas->TexPixelsRGBA32;
+			srcRect.srcBpp = 4U;
+		}
+		else
+		{
+			Messaging::Instance()->AddError(true, nullptr, nullptr,
+				"No pixels found in the atlas of the font %s. aborting.", fontInfos->m_FontFileName.c_str());
+			return false;
+		}
+
+		// the first font give the metrics
+		if (vOutAtlas->fontSize <= 0.0f)
+		{
+			vOutAtlas->fontSize = font->FontSize;
+			vOutAtlas->ascent = font->Ascent;
+			vOutAtlas->descent = font->Descent;
+		}
+
+		// glyphs of the others fonts are scaled to the size of the first, with the same baseline
+		const float scale = font->FontSize > 0.0f ? vOutAtlas->fontSize / font->FontSize : 1.0f;
+		const float offsetY = vOutAtlas->ascent - font->Ascent * scale;
+
+		for (const auto& it : fontInfos->m_SelectedGlyphs)
+		{
+			auto glyphInfos = it.second;
+			if (!glyphInfos) continue;
+
+			auto glyph = font->FindGlyphNoFallback((ImWchar)it.first);
+			if (!glyph) continue;
+
+			// glyph transform, in font units
+			const float tx = glyphInfos->m_Translation.x * fontInfos->m_Point * scale;
+			const float ty = -glyphInfos->m_Translation.y * fontInfos->m_Point * scale; // y down in imgui
+			const float sx = glyphInfos->m_Scale.x;
+			const float sy = glyphInfos->m_Scale.y;
+
+			PrebakedGlyphStruct pg;
+			pg.codePoint = glyphInfos->newCodePoint ? glyphInfos->newCodePoint : it.first;
+			pg.advanceX = glyph->AdvanceX * scale * sx;
+			pg.x0 = glyph->X0 * scale * sx + tx;
+			pg.x1 = glyph->X1 * scale * sx + tx;
+			pg.y0 = (glyph->Y0 * scale + offsetY) * sy + ty;
+			pg.y1 = (glyph->Y1 * scale + offsetY) * sy + ty;
+
+			PrebakedRectStruct rect = srcRect;
+			rect.srcX = (uint32_t)(glyph->U0 * atlas->TexWidth + 0.5f);
+			rect.srcY = (uint32_t)(glyph->V0 * atlas->TexHeight + 0.5f);
+			rect.w = (uint32_t)(glyph->U1 * atlas->TexWidth + 0.5f) - rect.srcX;
+			rect.h = (uint32_t)(glyph->V1 * atlas->TexHeight + 0.5f) - rect.srcY;
+			rect.glyphIdx = vOutAtlas->glyphs.size();
+
+			vOutAtlas->glyphs.push_back(pg);
+			if (rect.w && rect.h) // the space have no pixels
+				rects.push_back(rect);
+		}
+	}
+
+	return PackAtlas(rects, vOutAtlas);
+}
+
+bool AtlasGenerator::PackAtlas(std::vector<PrebakedRectStruct>& vRects, PrebakedAtlasStruct* vOutAtlas)
+{
+	if (!vOutAtlas)
+		return false;
+
+	if (vOutAtlas->glyphs.empty())
+	{
+		Messaging::Instance()->AddError(true, nullptr, nullptr, "No glyphs to bake in the atlas. aborting.");
+		return false;
+	}
+
+	auto& rects = vRects;
+	const uint32_t channels = vOutAtlas->channels;
+
+	// shelf packing, higher rects first
+	std::sort(rects.begin(), rects.end(), [](const PrebakedRectStruct& a, const PrebakedRectStruct& b)
+	{
+		return a.h > b.h;
+	});
+
+	size_t area = (size_t)(PREBAKED_ATLAS_WHITE_RECT_SIZE + PREBAKED_ATLAS_PADDING) *
+		(size_t)(PREBAKED_ATLAS_WHITE_RECT_SIZE + PREBAKED_ATLAS_PADDING);
+	uint32_t maxWidth = PREBAKED_ATLAS_WHITE_RECT_SIZE;
+	for (const auto& rect : rects)
+	{
+		area += (size_t)(rect.w + PREBAKED_ATLAS_PADDING) * (size_t)(rect.h + PREBAKED_ATLAS_PADDING);
+		maxWidth = ct::maxi(maxWidth, rect.w + PREBAKED_ATLAS_PADDING * 2U);
+	}
+
+	const uint32_t width = ct::maxi(NextPowerOfTwo(maxWidth),
+		ct::mini(NextPowerOfTwo((uint32_t)std::sqrt((double)area) + 1U), 4096U));
+
+	// the white rect is in the first shelf
+	uint32_t shelfX = PREBAKED_ATLAS_PADDING + PREBAKED_ATLAS_WHITE_RECT_SIZE + PREBAKED_ATLAS_PADDING;
+	uint32_t shelfY = PREBAKED_ATLAS_PADDING;
+	uint32_t shelfH = PREBAKED_ATLAS_WHITE_RECT_SIZE;
+	for (auto& rect : rects)
+	{
+		if (shelfX + rect.w + PREBAKED_ATLAS_PADDING > width) // new shelf
+		{
+			shelfX = PREBAKED_ATLAS_PADDING;
+			shelfY += shelfH + PREBAKED_ATLAS_PADDING;
+			shelfH = 0U;
+		}
+		rect.dstX = shelfX;
+		rect.dstY = shelfY;
+		shelfX += rect.w + PREBAKED_ATLAS_PADDING;
+		shelfH = ct::maxi(shelfH, rect.h);
+	}
+
+	const uint32_t height = NextPowerOfTwo(shelfY + shelfH + PREBAKED_ATLAS_PADDING);
+
+	vOutAtlas->width = width;
+	vOutAtlas->height = height;
+	vOutAtlas->pixels.clear();
+	vOutAtlas->pixels.resize((size_t)width * (size_t)height * channels, 0U);
+
+	// white rect (also the inside of a distance field)
+	for (uint32_t y = 0U; y < PREBAKED_ATLAS_WHITE_RECT_SIZE; ++y)
+	{
+		memset(vOutAtlas->pixels.data() + ((size_t)(PREBAKED_ATLAS_PADDING + y) * width + PREBAKED_ATLAS_PADDING) * channels,
+			0xFF, PREBAKED_ATLAS_WHITE_RECT_SIZE * channels);
+	}
+	vOutAtlas->whiteU = (PREBAKED_ATLAS_PADDING + PREBAKED_ATLAS_WHITE_RECT_SIZE * 0.5f) / (float)width;
+	vOutAtlas->whiteV = (PREBAKED_ATLAS_PADDING + PREBAKED_ATLAS_WHITE_RECT_SIZE * 0.5f) / (float)height;
+
+	// glyphs
+	for (const auto& rect : rects)
+	{
+		for (uint32_t y = 0U; y < rect.h; ++y)
+		{
+			uint8_t* dst = vOutAtlas->pixels.data() + ((size_t)(rect.dstY + y) * width + rect.dstX) * channels;
+			const uint8_t* src = rect.srcPixels + ((size_t)(rect.srcY + y) * rect.srcPitch + rect.srcX) * rect.srcBpp;
+			if (rect.srcBpp == channels)
+			{
+				memcpy(dst, src, (size_t)rect.w * channels);
+			}
+			else
+			{
+				for (uint32_t x = 0U; x < rect.w; ++x)
+					dst[x] = src[x * rect.srcBpp + 3U];
+			}
+		}
+
+		auto& pg = vOutAtlas->glyphs[rect.glyphIdx];
+		pg.u0 = (float)rect.dstX / (float)width;
+		pg.v0 = (float)rect.dstY / (float)height;
+		pg.u1 = (float)(rect.dstX + rect.w) / (float)width;
+		pg.v1 = (float)(rect.dstY + rect.h) / (float)height;
+	}
+
+	return true;
+}
+
+bool AtlasGenerator::WriteBinary(const std::string& vFilePathName, const PrebakedAtlasStruct& vAtlas)
+{
+	GenerationStageScope stage("AtlasGenerator::WriteBinary");
+
+	std::vector<uint8_t> buffer;
+	buffer.reserve(64U + vAtlas.glyphs.size() * 40U + vAtlas.pixels.size());
+
+	buffer.insert(buffer.end(), PREBAKED_ATLAS_MAGIC, PREBAKED_ATLAS_MAGIC + 4);
+	PushU32(buffer, PREBAKED_ATLAS_VERSION);
+	PushU32(buffer, (uint32_t)vAtlas.format);
+	PushU32(buffer, vAtlas.channels);
+	PushF32(buffer, vAtlas.pxRange);
+	PushF32(buffer, vAtlas.fontSize);
+	PushF32(buffer, vAtlas.ascent);
+	PushF32(buffer, vAtlas.descent);
+	PushU32(buffer, vAtlas.width);
+	PushU32(buffer, vAtlas.height);
+	PushF32(buffer, vAtlas.whiteU);
+	PushF32(buffer, vAtlas.whiteV);
+	PushU32(buffer, (uint32_t)vAtlas.glyphs.size());
+	for (const auto& glyph : vAtlas.glyphs)
+	{
+		PushU32(buffer, glyph.codePoint);
+		PushF32(buffer, glyph.advanceX);
+		PushF32(buffer, glyph.x0);
+		PushF32(buffer, glyph.y0);
+		PushF32(buffer, glyph.x1);
+		PushF32(buffer, glyph.y1);
+		PushF32(buffer, glyph.u0);
+		PushF32(buffer, glyph.v0);
+		PushF32(buffer, glyph.u1);
+		PushF32(buffer, glyph.v1);
+	}
+	buffer.insert(buffer.end(), vAtlas.pixels.begin(), vAtlas.pixels.end());
+
+	bool res = false;
+
+	FILE* f = OpenFile(vFilePathName, "wb");
+	if (f)
+	{
+		res = (fwrite(buffer.data(), 1, buffer.size(), f) == buffer.size());
+		fclose(f);
+		GenerationProfiler::Instance()->AddOutputFile(vFilePathName);
+	}
+
+	if (!res)
+	{
+		Messaging::Instance()->AddError(true, nullptr, nullptr, "Cannot write the atlas file %s", vFilePathName.c_str());
+	}
+
+	return res;
+}
+
+bool AtlasGenerator::WriteSource(const std::string& vFilePathName, const std::string& vPrefix, const PrebakedAtlasStruct& vAtlas)
+{
+	GenerationStageScope stage("AtlasGenerator::WriteSource");
+
+	std::string prefix = vPrefix;
+	ct::replaceString(prefix, "-", "_");
+	if (prefix.empty())
+		prefix = "Font";
+
+	std::string source;
+	source.reserve(1024U + vAtlas.glyphs.size() * 128U + vAtlas.pixels.size() * 5U);
+
+	source += "// generated by ImGuiFontStudio (https://github.com/aiekick/ImGuiFontStudio)\n";
+	source += "// prebaked atlas, glyphs already rasterized, no font file needed\n";
+	source += "// use : " + prefix + "_LoadPrebakedAtlas(ImGui::GetIO().Fonts);\n";
+	source += "#pragma once\n\n";
+	source += "#include \"" PREBAKED_ATLAS_LOADER_FILE_NAME ".h\"\n\n";
+
+	source += ct::toStr("static const ImGuiPrebakedGlyph %s_prebaked_glyphs[%u] =\n{\n", prefix.c_str(), (uint32_t)vAtlas.glyphs.size());
+	for (const auto& glyph : vAtlas.glyphs)
+	{
+		source += ct::toStr("\t{ 0x%X, %s, %s, %s, %s, %s, %s, %s, %s, %s },\n",
+			glyph.codePoint,
+			ToFloatLiteral(glyph.advanceX).c_str(),
+			ToFloatLiteral(glyph.x0).c_str(), ToFloatLiteral(glyph.y0).c_str(),
+			ToFloatLiteral(glyph.x1).c_str(), ToFloatLiteral(glyph.y1).c_str(),
+			ToFloatLiteral(glyph.u0).c_str(), ToFloatLiteral(glyph.v0).c_str(),
+			ToFloatLiteral(glyph.u1).c_str(), ToFloatLiteral(glyph.v1).c_str());
+	}
+	source += "};\n\n";
+
+	source += ct::toStr("static const unsigned char %s_prebaked_pixels[%u] =\n{", prefix.c_str(), (uint32_t)vAtlas.pixels.size());
+	for (size_t i = 0; i < vAtlas.pixels.size(); ++i)
+	{
+		if (i % 32U == 0U)
+			source += "\n\t";
+		source += ct::toStr("%u,", (uint32_t)vAtlas.pixels[i]);
+	}
+	source += "\n};\n\n";
+
+	source += ct::toStr("inline ImFont* %s_LoadPrebakedAtlas(ImFontAtlas* vAtlas)\n{\n", prefix.c_str());
+	source += "\tImGuiPrebakedAtlas atlas;\n";
+	source += ct::toStr("\tatlas.format = %u;\n", (uint32_t)vAtlas.format);
+	source += ct::toStr("\tatlas.channels = %u;\n", vAtlas.channels);
+	source += "\tatlas.pxRange = " + ToFloatLiteral(vAtlas.pxRange) + ";\n";
+	source += "\tatlas.fontSize = " + ToFloatLiteral(vAtlas.fontSize) + ";\n";
+	source += "\tatlas.ascent = " + ToFloatLiteral(vAtlas.ascent) + ";\n";
+	source += "\tatlas.descent = " + ToFloatLiteral(vAtlas.descent) + ";\n";
+	source += ct::toStr("\tatlas.width = %u;\n", vAtlas.width);
+	source += ct::toStr("\tatlas.height = %u;\n", vAtlas.height);
+	source += "\tatlas.whiteU = " + ToFloatLiteral(vAtlas.whiteU) + ";\n";
+	source += "\tatlas.whiteV = " + ToFloatLiteral(vAtlas.whiteV) + ";\n";
+	source += ct::toStr("\tatlas.countGlyphs = %u;\n", (uint32_t)vAtlas.glyphs.size());
+	source += ct::toStr("\tatlas.glyphs = %s_prebaked_glyphs;\n", prefix.c_str());
+	source += ct::toStr("\tatlas.pixels = %s_prebaked_pixels;\n", prefix.c_str());
+	source += "\treturn ImGuiPrebakedAtlas_Load(vAtlas, atlas);\n";
+	source += "}\n";
+
+	FileHelper::Instance()->SaveStringToFile(source, vFilePathName);
+	GenerationProfiler::Instance()->AddOutputFile(vFilePathName);
+
+	return FileHelper::Instance()->IsFileExist(vFilePathName);
+}
+
+// the loader is the same for all the generated atlas
+bool AtlasGenerator::WriteLoader(const std::string& vPath)
+{
+	std::string source;
+
+	source += "// generated by ImGuiFontStudio (https://github.com/aiekick/ImGuiFontStudio)\n";
+	source += "// loader of the prebaked atlas (*." PREBAKED_ATLAS_FILE_EXT " files or *_Atlas.h sources)\n";
+	source += "// the atlas replace all the fonts of the ImFontAtlas, the texture must be created after, like with a normal build\n";
+	source += "// need ImGui 1.80+ (ImFont::AddGlyph with a ImFontConfig param)\n";
+	source += "// the sdf / msdf atlas need a shader in the renderer, for the coverage :\n";
+	source += "//   float d = msdf ? median(tex.r, tex.g, tex.b) : tex.a; // the sdf is also in alpha for msdf\n";
+	source += "//   float screenPxRange = max(0.5 * dot(vec2(pxRange) / texSize, 1.0 / fwidth(uv)), 1.0);\n";
+	source += "//   float alpha = clamp(screenPxRange * (d - 0.5) + 0.5, 0.0, 1.0);\n";
+	source += "#pragma once\n\n";
+	source += "#include \"imgui.h\"\n";
+	source += "#include \"imgui_internal.h\"\n";
+	source += "#include <string.h>\n\n";
+
+	source += "struct ImGuiPrebakedGlyph\n{\n";
+	source += "\tunsigned int codePoint;\n";
+	source += "\tfloat advanceX;\n";
+	source += "\tfloat x0, y0, x1, y1;\n";
+	source += "\tfloat u0, v0, u1, v1;\n";
+	source += "};\n\n";
+
+	source += "enum ImGuiPrebakedAtlasFormat\n{\n";
+	source += ct::toStr("\tImGuiPrebakedAtlasFormat_Alpha8 = %u,\n", (uint32_t)PrebakedAtlasFormatEnum::PREBAKED_ATLAS_FORMAT_ALPHA8);
+	source += ct::toStr("\tImGuiPrebakedAtlasFormat_Sdf = %u,\n", (uint32_t)PrebakedAtlasFormatEnum::PREBAKED_ATLAS_FORMAT_SDF);
+	source += ct::toStr("\tImGuiPrebakedAtlasFormat_Msdf = %u\n", (uint32_t)PrebakedAtlasFormatEnum::PREBAKED_ATLAS_FORMAT_MSDF);
+	source += "};\n\n";
+
+	source += "struct ImGuiPrebakedAtlas\n{\n";
+	source += "\tunsigned int format; // ImGuiPrebakedAtlasFormat\n";
+	source += "\tunsigned int channels; // 1 => TexPixelsAlpha8, 4 => TexPixelsRGBA32 (use GetTexDataAsRGBA32)\n";
+	source += "\tfloat pxRange; // distance range in texels, for sdf / msdf\n";
+	source += "\tfloat fontSize;\n";
+	source += "\tfloat ascent;\n";
+	source += "\tfloat descent;\n";
+	source += "\tunsigned int width;\n";
+	source += "\tunsigned int height;\n";
+	source += "\tfloat whiteU;\n";
+	source += "\tfloat whiteV;\n";
+	source += "\tunsigned int countGlyphs;\n";
+	source += "\tconst ImGuiPrebakedGlyph* glyphs;\n";
+	source += "\tconst unsigned char* pixels; // width * height * channels\n";
+	source += "};\n\n";
+
+	source += "inline ImFont* ImGuiPrebakedAtlas_Load(ImFontAtlas* vAtlas, const ImGuiPrebakedAtlas& vPrebaked)\n{\n";
+	source += "\tif (!vAtlas || !vPrebaked.countGlyphs || !vPrebaked.glyphs || !vPrebaked.pixels || !vPrebaked.width || !vPrebaked.height ||\n";
+	source += "\t\t(vPrebaked.channels != 1 && vPrebaked.channels != 4))\n";
+	source += "\t\treturn NULL;\n\n";
+	source += "\tvAtlas->Clear();\n";
+	source += "\tvAtlas->Flags |= ImFontAtlasFlags_NoMouseCursors | ImFontAtlasFlags_NoBakedLines;\n";
+	source += "\tvAtlas->TexWidth = (int)vPrebaked.width;\n";
+	source += "\tvAtlas->TexHeight = (int)vPrebaked.height;\n";
+	source += "\tvAtlas->TexUvScale = ImVec2(1.0f / vAtlas->TexWidth, 1.0f / vAtlas->TexHeight);\n";
+	source += "\tvAtlas->TexUvWhitePixel = ImVec2(vPrebaked.whiteU, vPrebaked.whiteV);\n";
+	source += "\tconst size_t size = (size_t)vPrebaked.width * (size_t)vPrebaked.height * vPrebaked.channels;\n";
+	source += "\tunsigned char* pixels = (unsigned char*)IM_ALLOC(size);\n";
+	source += "\tmemcpy(pixels, vPrebaked.pixels, size);\n";
+	source += "\tif (vPrebaked.channels == 4)\n";
+	source += "\t\tvAtlas->TexPixelsRGBA32 = (unsigned int*)pixels;\n";
+	source += "\telse\n";
+	source += "\t\tvAtlas->TexPixelsAlpha8 = pixels;\n\n";
+	source += "\tImFont* font = IM_NEW(ImFont);\n";
+	source += "\tvAtlas->Fonts.push_back(font);\n";
+	source += "\tfont->ContainerAtlas = vAtlas;\n";
+	source += "\tfont->FontSize = vPrebaked.fontSize;\n";
+	source += "\tfont->Ascent = vPrebaked.ascent;\n";
+	source += "\tfont->Descent = vPrebaked.descent;\n";
+	source += "\tfor (unsigned int i = 0; i < vPrebaked.countGlyphs; ++i)\n\t{\n";
+	source += "\t\tconst ImGuiPrebakedGlyph& g = vPrebaked.glyphs[i];\n";
+	source += "\t\tif (g.codePoint > IM_UNICODE_CODEPOINT_MAX) continue;\n";
+	source += "\t\tfont->AddGlyph(NULL, (ImWchar)g.codePoint, g.x0, g.y0, g.x1, g.y1, g.u0, g.v0, g.u1, g.v1, g.advanceX);\n";
+	source += "\t}\n";
+	source += "\tfont->BuildLookupTable();\n";
+	source += "#if IMGUI_VERSION_NUM >= 18700\n";
+	source += "\tvAtlas->TexReady = true;\n";
+	source += "#endif\n";
+	source += "\treturn font;\n";
+	source += "}\n\n";
+
+	source += "// parse a *." PREBAKED_ATLAS_FILE_EXT " file loaded in memory (little endian)\n";
+	source += "inline ImFont* ImGuiPrebakedAtlas_LoadFromMemory(ImFontAtlas* vAtlas, const void* vDatas, size_t vSize)\n{\n";
+	source += "\tconst unsigned char* p = (const unsigned char*)vDatas;\n";
+	source += "\tconst unsigned char* end = p + vSize;\n";
+	source += "\tif (!p || vSize < 40U || memcmp(p, \"" PREBAKED_ATLAS_MAGIC "\", 4) != 0)\n";
+	source += "\t\treturn NULL;\n";
+	source += "\tp += 4;\n";
+	source += "\tstruct Reader\n\t{\n";
+	source += "\t\tstatic unsigned int U32(const unsigned char*& v) { unsigned int r = v[0] | (v[1] << 8) | (v[2] << 16) | ((unsigned int)v[3] << 24); v += 4; return r; }\n";
+	source += "\t\tstatic float F32(const unsigned char*& v) { unsigned int b = U32(v); float r; memcpy(&r, &b, 4); return r; }\n";
+	source += "\t};\n";
+	source += "\tconst unsigned int version = Reader::U32(p);\n";
+	source += ct::toStr("\tif (version == 0 || version > %uU)\n", PREBAKED_ATLAS_VERSION);
+	source += "\t\treturn NULL;\n";
+	source += "\tImGuiPrebakedAtlas atlas;\n";
+	source += "\tatlas.format = ImGuiPrebakedAtlasFormat_Alpha8;\n";
+	source += "\tatlas.channels = 1;\n";
+	source += "\tatlas.pxRange = 0.0f;\n";
+	source += "\tif (version >= 2)\n\t{\n";
+	source += "\t\tif (vSize < 52U)\n";
+	source += "\t\t\treturn NULL;\n";
+	source += "\t\tatlas.format = Reader::U32(p);\n";
+	source += "\t\tatlas.channels = Reader::U32(p);\n";
+	source += "\t\tatlas.pxRange = Reader::F32(p);\n";
+	source += "\t}\n";
+	source += "\tatlas.fontSize = Reader::F32(p);\n";
+	source += "\tatlas.ascent = Reader::F32(p);\n";
+	source += "\tatlas.descent = Reader::F32(p);\n";
+	source += "\tatlas.width = Reader::U32(p);\n";
+	source += "\tatlas.height = Reader::U32(p);\n";
+	source += "\tatlas.whiteU = Reader::F32(p);\n";
+	source += "\tatlas.whiteV = Reader::F32(p);\n";
+	source += "\tatlas.countGlyphs = Reader::U32(p);\n";
+	source += "\tif ((size_t)(end - p) < (size_t)atlas.countGlyphs * 40U + (size_t)atlas.width * (size_t)atlas.height * atlas.channels)\n";
+	source += "\t\treturn NULL;\n";
+	source += "\tImVector<ImGuiPrebakedGlyph> glyphs;\n";
+	source += "\tglyphs.resize((int)atlas.countGlyphs);\n";
+	source += "\tfor (unsigned int i = 0; i < atlas.countGlyphs; ++i)\n\t{\n";
+	source += "\t\tImGuiPrebakedGlyph& g = glyphs[(int)i];\n";
+	source += "\t\tg.codePoint = Reader::U32(p);\n";
+	source += "\t\tg.advanceX = Reader::F32(p);\n";
+	source += "\t\tg.x0 = Reader::F32(p); g.y0 = Reader::F32(p); g.x1 = Reader::F32(p); g.y1 = Reader::F32(p);\n";
+	source += "\t\tg.u0 = Reader::F32(p); g.v0 = Reader::F32(p); g.u1 = Reader::F32(p); g.v1 = Reader::F32(p);\n";
+	source += "\t}\n";
+	source += "\tatlas.glyphs = glyphs.Data;\n";
+	source += "\tatlas.pixels = p;\n";
+	source += "\treturn ImGuiPrebakedAtlas_Load(vAtlas, atlas);\n";
+	source += "}\n";
+
+	const std::string filePathName = PathStruct(vPath, PREBAKED_ATLAS_LOADER_FILE_NAME, "h").GetFPNE();
+	FileHelper::Instance()->SaveStringToFile(source, filePathName);
+	GenerationProfiler::Instance()->AddOutputFile(filePathName);
+
+	return FileHelper::Instance()->IsFileExist(filePathName);
+}
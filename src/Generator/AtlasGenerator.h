@@ -0,0 +1,94 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+// prebaked atlas : the selected glyphs already rasterized in the FontInfos atlas (size, oversample, rasterizer)
+// are packed in a new alpha8 atlas, with the ImFontGlyph table and the font metrics
+// so an app can register the font in ImGui without any rasterization at startup
+// the same container is used for the distance field atlas (see SdfGenerator)
+//
+// outputs :
+// - name.ifsa : binary blob, little endian :
+//   "IFSA" / version:u32 / format, channels:u32 / pxRange:f32 / fontSize, ascent, descent:f32 / width, height:u32 / whiteU, whiteV:f32 / countGlyphs:u32
+//   countGlyphs * (codePoint:u32 / advanceX, x0, y0, x1, y1, u0, v0, u1, v1:f32) / width * height * channels pixels
+//   (the version 1 have no format, channels and pxRange, so is alpha8)
+// - name_Atlas.h : the same datas embedded in C++ arrays, with a load function
+// - ImGuiPrebakedAtlas.h : the loader used by both, to add in the app
+
+#define PREBAKED_ATLAS_FILE_EXT "ifsa"
+#define PREBAKED_ATLAS_LOADER_FILE_NAME "ImGuiPrebakedAtlas"
+#define PREBAKED_ATLAS_VERSION 2U
+
+enum class PrebakedAtlasFormatEnum : uint32_t
+{
+	PREBAKED_ATLAS_FORMAT_ALPHA8 = 0, // coverage, 1 channel
+	PREBAKED_ATLAS_FORMAT_SDF, // signed distance field, 1 channel
+	PREBAKED_ATLAS_FORMAT_MSDF // multi channel signed distance field in rgb, sdf in alpha
+};
+
+struct PrebakedGlyphStruct
+{
+	uint32_t codePoint = 0U;
+	float advanceX = 0.0f;
+	float x0 = 0.0f, y0 = 0.0f, x1 = 0.0f, y1 = 0.0f; // quad, in pixels
+	float u0 = 0.0f, v0 = 0.0f, u1 = 0.0f, v1 = 0.0f; // uvs in the prebaked atlas
+};
+
+struct PrebakedAtlasStruct
+{
+	PrebakedAtlasFormatEnum format = PrebakedAtlasFormatEnum::PREBAKED_ATLAS_FORMAT_ALPHA8;
+	uint32_t channels = 1U; // bytes per pixel, 1 or 4
+	float pxRange = 0.0f; // distance range in texels, for sdf/msdf only
+	float fontSize = 0.0f;
+	float ascent = 0.0f;
+	float descent = 0.0f;
+	uint32_t width = 0U;
+	uint32_t height = 0U;
+	float whiteU = 0.0f; // uv of a white texel, needed by imgui for the shapes
+	float whiteV = 0.0f;
+	std::vector<PrebakedGlyphStruct> glyphs;
+	std::vector<uint8_t> pixels; // width * height * channels
+};
+
+// a glyph bitmap to copy in the prebaked atlas
+struct PrebakedRectStruct
+{
+	const uint8_t* srcPixels = nullptr;
+	uint32_t srcPitch = 0U; // in texels
+	uint32_t srcBpp = 1U; // 4 => rgba32, only the alpha is copied in a 1 channel atlas
+	uint32_t srcX = 0U, srcY = 0U;
+	uint32_t w = 0U, h = 0U;
+	uint32_t dstX = 0U, dstY = 0U;
+	size_t glyphIdx = 0U; // in PrebakedAtlasStruct::glyphs
+};
+
+class FontInfos;
+class AtlasGenerator
+{
+public:
+	// the first font give the metrics, the glyphs of the others are scaled to his size
+	static bool BakeAtlas(const std::vector<std::shared_ptr<FontInfos>>& vFonts, PrebakedAtlasStruct* vOutAtlas);
+	// pack the rects and set the uvs of the glyphs, vOutAtlas->channels must be set
+	static bool PackAtlas(std::vector<PrebakedRectStruct>& vRects, PrebakedAtlasStruct* vOutAtlas);
+	static bool WriteBinary(const std::string& vFilePathName, const PrebakedAtlasStruct& vAtlas);
+	static bool WriteSource(const std::string& vFilePathName, const std::string& vPrefix, const PrebakedAtlasStruct& vAtlas);
+	static bool WriteLoader(const std::string& vPath);
+};
@@ -19,6 +19,8 @@
 
 #include "Compress.h"
 
+#include <Generator/GenerationProfiler.h>
+
 #include <ctools/cTools.h>
 
 #pragma warning( disable : 4244 )
@@ -48,6 +50,8 @@ std::string Compress::GetCompressedBase85BytesArray(
 	std::string *vBufferName, 
 	size_t *vBufferSize)
 {
+	GenerationStageScope stage("Compress::GetCompressedBase85BytesArray");
+
 	UNUSED(vPrefix);
 
 	std::string res;
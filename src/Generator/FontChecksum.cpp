@@ -0,0 +1,233 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FontChecksum.h"
+
+#include <chrono>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FONT_CHECKSUM_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#define SFNT_HEADER_SIZE 12U
+#define SFNT_TABLE_RECORD_SIZE 16U
+#define HEAD_ADJUSTMENT_OFFSET 8U // offset of checkSumAdjustment in the head table
+#define CHECKSUM_MAGIC 0xB1B0AFBAU
+
+static uint32_t ReadBigEndian32(const uint8_t* vDatas)
+{
+	return ((uint32_t)vDatas[0] << 24) | ((uint32_t)vDatas[1] << 16) | ((uint32_t)vDatas[2] << 8) | (uint32_t)vDatas[3];
+}
+
+static void WriteBigEndian32(uint8_t* vDatas, uint32_t vValue)
+{
+	vDatas[0] = (uint8_t)((vValue >> 24) & 0xff);
+	vDatas[1] = (uint8_t)((vValue >> 16) & 0xff);
+	vDatas[2] = (uint8_t)((vValue >> 8) & 0xff);
+	vDatas[3] = (uint8_t)(vValue & 0xff);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+double FontChecksumReportStruct::GetThroughputInMBs() const
+{
+	if (computeTimeInMs > 0.0)
+		return ((double)fileSize / (1024.0 * 1024.0)) / (computeTimeInMs / 1000.0);
+	return 0.0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+uint32_t FontChecksum::ComputeChecksum(const uint8_t* vDatas, size_t vLength)
+{
+	if (!vDatas || !vLength)
+		return 0U;
+
+	uint32_t sum = 0U;
+	size_t i = 0U;
+
+#ifdef FONT_CHECKSUM_USE_SSE2
+	// 4 big endian uint32 per step, the additions modulo 2^32 are done per lane
+	// the lanes are summed at end, the result is the same modulo 2^32
+	__m128i acc = _mm_setzero_si128();
+	for (; i + 16U <= vLength; i += 16U)
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(vDatas + i));
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)); // swap bytes of 16 bits words
+		v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)); // then swap the words
+		v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		acc = _mm_add_epi32(acc, v);
+	}
+	uint32_t lanes[4];
+	_mm_storeu_si128((__m128i*)lanes, acc);
+	sum = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+#else
+	// 4 accumulators for let the compiler vectorize
+	uint32_t acc[4] = { 0U, 0U, 0U, 0U };
+	for (; i + 16U <= vLength; i += 16U)
+	{
+		acc[0] += ReadBigEndian32(vDatas + i);
+		acc[1] += ReadBigEndian32(vDatas + i + 4U);
+		acc[2] += ReadBigEndian32(vDatas + i + 8U);
+		acc[3] += ReadBigEndian32(vDatas + i + 12U);
+	}
+	sum = acc[0] + acc[1] + acc[2] + acc[3];
+#endif
+
+	for (; i + 4U <= vLength; i += 4U)
+	{
+		sum += ReadBigEndian32(vDatas + i);
+	}
+
+	if (i < vLength) // zero padding
+	{
+		uint8_t last[4] = { 0U, 0U, 0U, 0U };
+		memcpy(last, vDatas + i, vLength - i);
+		sum += ReadBigEndian32(last);
+	}
+
+	return sum;
+}
+
+uint32_t FontChecksum::ComputeTableChecksum(const std::string& vTag, const uint8_t* vTableDatas, size_t vLength)
+{
+	uint32_t sum = ComputeChecksum(vTableDatas, vLength);
+
+	if (vTag == "head" && vLength >= HEAD_ADJUSTMENT_OFFSET + 4U)
+	{
+		sum -= ReadBigEndian32(vTableDatas + HEAD_ADJUSTMENT_OFFSET);
+	}
+
+	return sum;
+}
+
+bool FontChecksum::ReadTableDirectory(const uint8_t* vDatas, size_t vSize, FontChecksumReportStruct* vReport)
+{
+	if (!vDatas || vSize < SFNT_HEADER_SIZE || !vReport)
+		return false;
+
+	const uint16_t numTables = (uint16_t)(((uint16_t)vDatas[4] << 8) | vDatas[5]);
+	if (SFNT_HEADER_SIZE + (size_t)numTables * SFNT_TABLE_RECORD_SIZE > vSize)
+		return false;
+
+	vReport->tables.resize(numTables);
+	for (size_t i = 0U; i < numTables; ++i)
+	{
+		const uint8_t* record = vDatas + SFNT_HEADER_SIZE + i * SFNT_TABLE_RECORD_SIZE;
+		auto& table = vReport->tables[i];
+		table.tag = std::string((const char*)record, 4U);
+		table.storedCheckSum = ReadBigEndian32(record + 4U);
+		table.offset = ReadBigEndian32(record + 8U);
+		table.length = ReadBigEndian32(record + 12U);
+		table.inBounds = ((size_t)table.offset + (size_t)table.length <= vSize);
+	}
+
+	return true;
+}
+
+// checksum of the whole font with checkSumAdjustment at 0
+uint32_t FontChecksum::ComputeAdjustment(const uint8_t* vDatas, size_t vSize, uint32_t vHeadOffset)
+{
+	uint32_t fileSum = ComputeChecksum(vDatas, vSize);
+
+	const size_t adjustmentPos = (size_t)vHeadOffset + HEAD_ADJUSTMENT_OFFSET;
+	if (adjustmentPos + 4U <= vSize)
+	{
+		if (adjustmentPos % 4U == 0U) // the tables are 4 bytes aligned in a valid font
+		{
+			fileSum -= ReadBigEndian32(vDatas + adjustmentPos);
+		}
+		else
+		{
+			// not aligned, the bytes of the value are in two words of the sum
+			for (size_t i = 0U; i < 4U; ++i)
+			{
+				const size_t pos = adjustmentPos + i;
+				fileSum -= ((uint32_t)vDatas[pos]) << (8U * (3U - (pos % 4U)));
+			}
+		}
+	}
+
+	return CHECKSUM_MAGIC - fileSum;
+}
+
+bool FontChecksum::ValidateFont(const uint8_t* vDatas, size_t vSize, FontChecksumReportStruct* vReport)
+{
+	if (!vReport)
+		return false;
+
+	*vReport = FontChecksumReportStruct();
+	vReport->fileSize = vSize;
+
+	const auto start = std::chrono::high_resolution_clock::now();
+
+	vReport->parsed = ReadTableDirectory(vDatas, vSize, vReport);
+	if (vReport->parsed)
+	{
+		for (auto& table : vReport->tables)
+		{
+			if (table.inBounds)
+			{
+				table.computedCheckSum = ComputeTableChecksum(table.tag, vDatas + table.offset, table.length);
+			}
+
+			if (!table.IsValid())
+			{
+				++vReport->countBadTables;
+			}
+
+			if (table.tag == "head" && table.inBounds && table.length >= HEAD_ADJUSTMENT_OFFSET + 4U)
+			{
+				vReport->headFound = true;
+				vReport->storedAdjustment = ReadBigEndian32(vDatas + table.offset + HEAD_ADJUSTMENT_OFFSET);
+				vReport->computedAdjustment = ComputeAdjustment(vDatas, vSize, table.offset);
+			}
+		}
+	}
+
+	const auto end = std::chrono::high_resolution_clock::now();
+	vReport->computeTimeInMs = std::chrono::duration<double, std::milli>(end - start).count();
+
+	return vReport->IsValid();
+}
+
+bool FontChecksum::FixChecksumAdjustment(uint8_t* vDatas, size_t vSize)
+{
+	FontChecksumReportStruct report;
+	if (ReadTableDirectory(vDatas, vSize, &report))
+	{
+		for (const auto& table : report.tables)
+		{
+			if (table.tag == "head" && table.inBounds && table.length >= HEAD_ADJUSTMENT_OFFSET + 4U)
+			{
+				const uint32_t adjustment = ComputeAdjustment(vDatas, vSize, table.offset);
+				WriteBigEndian32(vDatas + table.offset + HEAD_ADJUSTMENT_OFFSET, adjustment);
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
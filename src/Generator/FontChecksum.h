@@ -0,0 +1,67 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// https://docs.microsoft.com/en-us/typography/opentype/spec/otff#calculating-checksums
+// table checksums and head checkSumAdjustment of a sfnt font file (ttf/otf)
+
+struct FontTableChecksumStruct
+{
+	std::string tag;
+	uint32_t offset = 0U;
+	uint32_t length = 0U;
+	uint32_t storedCheckSum = 0U;
+	uint32_t computedCheckSum = 0U;
+	bool inBounds = true; // the table is in the file
+	bool IsValid() const { return inBounds && (storedCheckSum == computedCheckSum); }
+};
+
+struct FontChecksumReportStruct
+{
+	bool parsed = false; // the table directory was readable
+	std::vector<FontTableChecksumStruct> tables;
+	bool headFound = false;
+	uint32_t storedAdjustment = 0U;
+	uint32_t computedAdjustment = 0U;
+	size_t countBadTables = 0U;
+	double computeTimeInMs = 0.0;
+	size_t fileSize = 0U;
+
+	bool IsAdjustmentValid() const { return !headFound || (storedAdjustment == computedAdjustment); }
+	bool IsValid() const { return parsed && countBadTables == 0U && IsAdjustmentValid(); }
+	double GetThroughputInMBs() const; // MB/s of the last validation
+};
+
+class FontChecksum
+{
+public:
+	// sum of the big endian uint32 of the datas, zero padded to 4 bytes
+	static uint32_t ComputeChecksum(const uint8_t* vDatas, size_t vLength);
+	// the head table checksum is computed with checkSumAdjustment at 0
+	static uint32_t ComputeTableChecksum(const std::string& vTag, const uint8_t* vTableDatas, size_t vLength);
+	// compute and check the checksum of each table and the head checkSumAdjustment
+	static bool ValidateFont(const uint8_t* vDatas, size_t vSize, FontChecksumReportStruct* vReport);
+	// write the good checkSumAdjustment in the head table, return false if no head table
+	static bool FixChecksumAdjustment(uint8_t* vDatas, size_t vSize);
+
+private:
+	static bool ReadTableDirectory(const uint8_t* vDatas, size_t vSize, FontChecksumReportStruct* vReport);
+	static uint32_t ComputeAdjustment(const uint8_t* vDatas, size_t vSize, uint32_t vHeadOffset);
+};
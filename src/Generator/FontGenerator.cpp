@@ -40,6 +40,13 @@
 #include "FontGenerator.h"
 
 #include "MemoryStream.h"
+#include "FontChecksum.h"
+#include "GenerationProfiler.h"
+#include "Generator.h"
+
+#include <Helper/FontBlobRegistry.h>
+#include <Helper/Messaging.h>
+#include <Project/FontInfos.h>
 
 #include <ctools/FileHelper.h>
 #include <ctools/cTools.h>
@@ -48,9 +55,11 @@
 #include <set>
 #include <map>
 
+#define FONT_ASSEMBLY_GLYPHS_PER_PROGRESS 64 // the cancel and the progress are checked each n glyphs
+
 #include <sfntly/font_factory.h>
 #include <sfntly/port/memory_output_stream.h>
-#include <sfntly/port/file_input_stream.h>
+#include <sfntly/port/memory_input_stream.h>
 #include <sfntly/table/core/maximum_profile_table.h>
 #include <sfntly/table/core/horizontal_header_table.h>
 #include <sfntly/table/core/horizontal_metrics_table.h>
@@ -59,6 +68,34 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
+std::shared_ptr<SfntlyFont> SfntlyFont::Create(std::shared_ptr<const FontBlob> vFontBlob)
+{
+	auto res = std::make_shared<SfntlyFont>();
+	res->m_FontBlob = vFontBlob;
+	res->m_Font.Attach(FontGenerator::LoadFontBlob(vFontBlob));
+	if (res->m_Font)
+	{
+		sfntly::Ptr<sfntly::CMapTable> cmap_table = down_cast<sfntly::CMapTable*>(res->m_Font->GetTable(sfntly::Tag::cmap));
+		if (cmap_table)
+			res->m_CMapTable.Attach(cmap_table->GetCMap(sfntly::CMapTable::WINDOWS_BMP));
+		res->m_GlyfTable = down_cast<sfntly::GlyphTable*>(res->m_Font->GetTable(sfntly::Tag::glyf));
+		res->m_LocaTable = down_cast<sfntly::LocaTable*>(res->m_Font->GetTable(sfntly::Tag::loca));
+		res->m_HeadTable = down_cast<sfntly::FontHeaderTable*>(res->m_Font->GetTable(sfntly::Tag::head));
+	}
+	if (!res->IsValid())
+		return nullptr;
+	return res;
+}
+
+bool SfntlyFont::IsValid() const
+{
+	return (m_Font && m_CMapTable && m_GlyfTable && m_LocaTable);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
 FontGenerator::FontGenerator()
 {
 	m_InvertedStandardNames = InvertNameMap();
@@ -71,50 +108,47 @@ FontGenerator::~FontGenerator() = default;
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 bool FontGenerator::OpenFontFile(
-	const std::string& vFontFilePathName, 
+	std::shared_ptr<FontInfos> vFontInfos,
 	std::map<CodePoint, std::string> vNewNames,
 	std::map<CodePoint, CodePoint> vNewCodePoints,
 	std::map<CodePoint, std::shared_ptr<GlyphInfos>> vNewGlyphInfos,
 	bool vBaseFontFileToMergeIn)
 {
+	GenerationStageScope stage("FontGenerator::OpenFontFile");
+
 	bool res = false;
 
-	if (FileHelper::Instance()->IsFileExist(vFontFilePathName))
+	if (vFontInfos)
 	{
-		FontInstance fontInstance;
-
-		fontInstance.m_Font.Attach(LoadFontFile(vFontFilePathName.c_str()));
-		if (fontInstance.m_Font)
+		// the parsed font is cached by the FontInfos, only the tables refs are copied
+		auto sfntlyFontPtr = vFontInfos->GetSfntlyFont();
+		if (sfntlyFontPtr && sfntlyFontPtr->m_HeadTable)
 		{
-			sfntly::Ptr<sfntly::CMapTable> cmap_table = down_cast<sfntly::CMapTable*>(fontInstance.m_Font->GetTable(sfntly::Tag::cmap));
-			fontInstance.m_CMapTable.Attach(cmap_table->GetCMap(sfntly::CMapTable::WINDOWS_BMP));
-			if (fontInstance.m_CMapTable)
-			{
-				fontInstance.m_GlyfTable = down_cast<sfntly::GlyphTable*>(fontInstance.m_Font->GetTable(sfntly::Tag::glyf));
-				fontInstance.m_LocaTable = down_cast<sfntly::LocaTable*>(fontInstance.m_Font->GetTable(sfntly::Tag::loca));
-				fontInstance.m_HeadTable = down_cast<sfntly::FontHeaderTable*>(fontInstance.m_Font->GetTable(sfntly::Tag::head));
-				if (fontInstance.m_GlyfTable && fontInstance.m_LocaTable && fontInstance.m_HeadTable)
-				{
-					m_FontBoundingBox.lowerBound.x = fontInstance.m_HeadTable->XMin();
-					m_FontBoundingBox.lowerBound.y = fontInstance.m_HeadTable->YMin();
-					m_FontBoundingBox.upperBound.x = fontInstance.m_HeadTable->XMax();
-					m_FontBoundingBox.upperBound.y = fontInstance.m_HeadTable->YMax();
+			FontInstance fontInstance;
+			fontInstance.m_Font = sfntlyFontPtr->m_Font;
+			fontInstance.m_CMapTable = sfntlyFontPtr->m_CMapTable;
+			fontInstance.m_GlyfTable = sfntlyFontPtr->m_GlyfTable;
+			fontInstance.m_LocaTable = sfntlyFontPtr->m_LocaTable;
+			fontInstance.m_HeadTable = sfntlyFontPtr->m_HeadTable;
 
-					fontInstance.m_NewGlyphNames = std::move(vNewNames);
-					fontInstance.m_NewGlyphCodePoints = std::move(vNewCodePoints);
-					fontInstance.m_NewGlyphInfos = std::move(vNewGlyphInfos);
+			m_FontBoundingBox.lowerBound.x = fontInstance.m_HeadTable->XMin();
+			m_FontBoundingBox.lowerBound.y = fontInstance.m_HeadTable->YMin();
+			m_FontBoundingBox.upperBound.x = fontInstance.m_HeadTable->XMax();
+			m_FontBoundingBox.upperBound.y = fontInstance.m_HeadTable->YMax();
 
-					FillCharacterMap(&fontInstance, fontInstance.m_NewGlyphNames);
-					FillResolvedCompositeGlyphs(&fontInstance, fontInstance.m_CharMap);
+			fontInstance.m_NewGlyphNames = std::move(vNewNames);
+			fontInstance.m_NewGlyphCodePoints = std::move(vNewCodePoints);
+			fontInstance.m_NewGlyphInfos = std::move(vNewGlyphInfos);
 
-					if (vBaseFontFileToMergeIn)
-						m_BaseFontIdx = m_Fonts.size();
+			FillCharacterMap(&fontInstance, fontInstance.m_NewGlyphNames);
+			FillResolvedCompositeGlyphs(&fontInstance, fontInstance.m_CharMap);
 
-					m_Fonts.push_back(fontInstance);
+			if (vBaseFontFileToMergeIn)
+				m_BaseFontIdx = m_Fonts.size();
 
-					res = true;
-				}
-			}
+			m_Fonts.push_back(fontInstance);
+
+			res = true;
 		}
 	}
 
@@ -263,6 +297,8 @@ void FontGenerator::FillResolvedCompositeGlyphs(FontInstance *vFontInstance, con
 
 int32_t FontGenerator::MergeCharacterMaps()
 {
+	GenerationStageScope stage("FontGenerator::MergeCharacterMaps");
+
 	m_CharMap.clear(); // codepoint to glyph id
 	m_ReversedCharMap.clear(); // glyph id to codepoint
 	m_ResolvedSet.clear();
@@ -311,15 +347,16 @@ sfntly::Font* FontGenerator::AssembleFont(bool vUsePostTable)
 			m_FontBuilder.Attach(m_FontFactory->NewFontBuilder());
 
 			// Assemble tables
+			// the generation can be cancelled between two tables, and during the glyphs
 			bool CanWeGo = true;
-			CanWeGo &= Assemble_Glyf_Loca_Maxp_Tables();
-			CanWeGo &= Assemble_CMap_Table();
-			CanWeGo &= Assemble_Hmtx_Hhea_Tables();
-			CanWeGo &= Assemble_Name_Table(); // todo: not made for the moment
-			CanWeGo &= Assemble_Head_Table();
+			CanWeGo &= Assemble_Glyf_Loca_Maxp_Tables(); // progress 0 to 0.8
+			CanWeGo &= ContinueAssembly(0.8f) && Assemble_CMap_Table();
+			CanWeGo &= ContinueAssembly(0.85f) && Assemble_Hmtx_Hhea_Tables();
+			CanWeGo &= ContinueAssembly(0.9f) && Assemble_Name_Table(); // todo: not made for the moment
+			CanWeGo &= ContinueAssembly(0.9f) && Assemble_Head_Table();
 			if (vUsePostTable)
-				CanWeGo &= Assemble_Post_Table(m_GlyphNames);
-			if (CanWeGo)
+				CanWeGo &= ContinueAssembly(0.95f) && Assemble_Post_Table(m_GlyphNames);
+			if (CanWeGo && ContinueAssembly(1.0f))
 			{
 				// include for the moment only head, before generate it
 				// head table is needed else it will be a not loadable font
@@ -340,12 +377,23 @@ sfntly::Font* FontGenerator::AssembleFont(bool vUsePostTable)
 	return nullptr;
 }
 
+// report the progress of the assembly [0:1], return false if the generation is cancelled
+bool FontGenerator::ContinueAssembly(const float& vProgress)
+{
+	if (Generator::Instance()->CheckCancel())
+		return false;
+	Generator::Instance()->SetOutputProgress(vProgress);
+	return true;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/font_assembler.cc*/
 bool FontGenerator::Assemble_Glyf_Loca_Maxp_Tables()
 {
+	GenerationStageScope stage("FontGenerator::Assemble_Glyf_Loca_Maxp_Tables");
+
 	auto baseFontInstance = GetBaseFontInstance();
 	if (baseFontInstance)
 	{
@@ -361,8 +409,13 @@ bool FontGenerator::Assemble_Glyf_Loca_Maxp_Tables()
 		my_loca_list.emplace_back(glyphOffset);
 		int32_t fontId = 0;
 		int32_t new_glyphid = 0;
+		const float countGlyphs = (float)ct::maxi<size_t>(m_ResolvedSet.size(), 1U);
 		for (const auto & it : m_ResolvedSet)
 		{
+			if (new_glyphid % FONT_ASSEMBLY_GLYPHS_PER_PROGRESS == 0 &&
+				!ContinueAssembly(0.8f * (float)new_glyphid / countGlyphs))
+				return false;
+
 			// Get the glyph for this resolved_glyph_id.
 			fontId = it.first;
 			int32_t resolved_glyph_id = it.second;
@@ -482,10 +535,20 @@ sfntly::Ptr<sfntly::WritableFontData> FontGenerator::ReScale_Glyph(
 					// https://developer.apple.com/fonts/TrueType-Reference-Manual/RM06/Chap6glyf.html
 					/////////////////////////////////////////////////////////////////////////////////////////////
 
+					size_t countPoints = 0U;
+					for (const auto &contour : simpleGlyph.coords)
+						countPoints += contour.size();
+
+					// the points are collected, then written in one bulk per stream
+					std::vector<uint8_t> flags;
+					std::vector<int16_t> xCoords;
+					std::vector<int16_t> yCoords;
+					flags.reserve(countPoints);
+					xCoords.reserve(countPoints);
+					yCoords.reserve(countPoints);
+
 					MemoryStream headerStream;
-					MemoryStream flagStream;
-					MemoryStream xCoordStream;
-					MemoryStream yCoordStream;
+					headerStream.Reserve(10U + (size_t)ct::maxi(countContours, 0) * 2U + 2U); // header + end pts + instructions length
 
 					ct::iAABB boundingBox(
 						glyphInfos->simpleGlyph.rc.xy(), 
@@ -505,11 +568,11 @@ sfntly::Ptr<sfntly::WritableFontData> FontGenerator::ReScale_Glyph(
 							uint8_t flag = 0;
 							if (simpleGlyph.onCurve[contourIdx][pointIdx])
 								flag = flag | (1 << 0);
-							flagStream.WriteByte(flag);
+							flags.push_back(flag);
 
 							// relative points
-							xCoordStream.WriteShort(dv.x);
-							yCoordStream.WriteShort(dv.y);
+							xCoords.push_back((int16_t)dv.x);
+							yCoords.push_back((int16_t)dv.y);
 
 							// conbine absolute points
 							boundingBox.Combine(pt);
@@ -535,18 +598,20 @@ sfntly::Ptr<sfntly::WritableFontData> FontGenerator::ReScale_Glyph(
 						headerStream.WriteShort(sglyph->ContourEndPoint(contour));
 					headerStream.WriteShort(0);
 
+					// one stream for the whole glyph, flags then x coords then y coords
+					MemoryStream glyphStream;
+					glyphStream.Reserve(headerStream.Size() + flags.size() + (xCoords.size() + yCoords.size()) * 2U);
+					glyphStream.WriteBytes(headerStream.GetDatas(), headerStream.Size());
+					glyphStream.WriteBytes(flags.data(), flags.size());
+					glyphStream.WriteShorts(xCoords.data(), xCoords.size());
+					glyphStream.WriteShorts(yCoords.data(), yCoords.size());
+
 					/////////////////////////////////////////////////////////////////////////////////////////////
 					/////////////////////////////////////////////////////////////////////////////////////////////
 
 					sfntly::Ptr<sfntly::WritableFontData> finalStream;
-					size_t new_lengthInBytes = headerStream.Size() + flagStream.Size() + xCoordStream.Size() + yCoordStream.Size();
-					finalStream.Attach(sfntly::WritableFontData::CreateWritableFontData((int32_t)new_lengthInBytes));
-
-					int32_t offset = 0;
-					finalStream->WriteBytes(offset, headerStream.Get(), 0, (int32_t)headerStream.Size()); offset += (int32_t)headerStream.Size();
-					finalStream->WriteBytes(offset, flagStream.Get(), 0, (int32_t)flagStream.Size()); offset += (int32_t)flagStream.Size();
-					finalStream->WriteBytes(offset, xCoordStream.Get(), 0, (int32_t)xCoordStream.Size()); offset += (int32_t)xCoordStream.Size();
-					finalStream->WriteBytes(offset, yCoordStream.Get(), 0, (int32_t)yCoordStream.Size());
+					finalStream.Attach(sfntly::WritableFontData::CreateWritableFontData((int32_t)glyphStream.Size()));
+					finalStream->WriteBytes(0, glyphStream.Get(), 0, (int32_t)glyphStream.Size());
 
 					/////////////////////////////////////////////////////////////////////////////////////////////
 					/////////////////////////////////////////////////////////////////////////////////////////////
@@ -579,6 +644,8 @@ sfntly::Ptr<sfntly::WritableFontData> FontGenerator::ReScale_Glyph(
 /* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/font_assembler.cc*/
 bool FontGenerator::Assemble_CMap_Table()
 {
+	GenerationStageScope stage("FontGenerator::Assemble_CMap_Table");
+
 	// Creating the new CMapTable and the new format 4 CMap
 	sfntly::Ptr<sfntly::CMapTable::Builder> cmap_table_builder =
 		down_cast<sfntly::CMapTable::Builder*>
@@ -672,6 +739,8 @@ struct LongHorMetric
 /* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/font_assembler.cc*/
 bool FontGenerator::Assemble_Hmtx_Hhea_Tables()
 {
+	GenerationStageScope stage("FontGenerator::Assemble_Hmtx_Hhea_Tables");
+
 	auto baseFontInstance = GetBaseFontInstance();
 	if (baseFontInstance)
 	{
@@ -753,6 +822,8 @@ bool FontGenerator::Assemble_Hmtx_Hhea_Tables()
 
 bool FontGenerator::Assemble_Post_Table(std::map<CodePoint, std::string> vSelection)
 {
+	GenerationStageScope stage("FontGenerator::Assemble_Post_Table");
+
 	if (m_NewToOldGlyfId.empty() || 
 		vSelection.empty())
 	{
@@ -851,6 +922,8 @@ bool FontGenerator::Assemble_Post_Table(std::map<CodePoint, std::string> vSelect
 
 bool FontGenerator::Assemble_Name_Table()
 {
+	GenerationStageScope stage("FontGenerator::Assemble_Name_Table");
+
 	//todo: la table Meta contient les infos sur les font, comme la license , l'auteur etc..
 	return true;
 }
@@ -860,6 +933,8 @@ bool FontGenerator::Assemble_Name_Table()
 
 bool FontGenerator::Assemble_Head_Table()
 {
+	GenerationStageScope stage("FontGenerator::Assemble_Head_Table");
+
 	sfntly::WritableFontDataPtr head;
 	head.Attach(sfntly::WritableFontData::CreateWritableFontData(54));
 	
@@ -951,20 +1026,37 @@ std::unordered_map<std::string, int32_t> FontGenerator::InvertNameMap()
 /* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/utils.cc*/
 sfntly::Font* FontGenerator::LoadFontFile(const std::string& font_path)
 {
+	// the shared copy of the file, not read again
+	// not a mapping, the output file can be this font file
+	return LoadFontBlob(FontBlobRegistry::Instance()->GetOwnedBlob(font_path));
+}
+
+sfntly::Font* FontGenerator::LoadFontBlob(const std::shared_ptr<const FontBlob>& vFontBlob)
+{
+	if (!vFontBlob || !vFontBlob->IsValid())
+		return nullptr;
+
 	sfntly::Ptr<sfntly::FontFactory> font_factory;
 	font_factory.Attach(sfntly::FontFactory::GetInstance());
 	sfntly::FontArray fonts;
-	LoadFontFiles(font_path, font_factory, &fonts);
+	LoadFontFiles(vFontBlob, font_factory, &fonts);
+	if (fonts.empty())
+		return nullptr;
 	return fonts[0].Detach();
 }
 
 /* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/utils.cc*/
-void FontGenerator::LoadFontFiles(const std::string& font_path, sfntly::FontFactory* factory, sfntly::FontArray* fonts)
+void FontGenerator::LoadFontFiles(const std::shared_ptr<const FontBlob>& vFontBlob, sfntly::FontFactory* factory, sfntly::FontArray* fonts)
 {
-	sfntly::FileInputStream input_stream;
-	input_stream.Open(font_path.c_str());
-	factory->LoadFonts(&input_stream, fonts);
-	input_stream.Close();
+	if (vFontBlob)
+	{
+		sfntly::MemoryInputStream input_stream;
+		if (input_stream.Attach(vFontBlob->GetDatas(), vFontBlob->GetSize()))
+		{
+			factory->LoadFonts(&input_stream, fonts);
+		}
+		input_stream.Close();
+	}
 }
 
 /* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/utils.cc*/
@@ -980,6 +1072,8 @@ bool FontGenerator::SerializeFont(const std::string& font_path, sfntly::Font* fo
 /* based on https://github.com/rillig/sfntly/blob/master/cpp/src/sample/subtly/utils.cc*/
 bool FontGenerator::SerializeFont(const std::string& font_path, sfntly::FontFactory* factory, sfntly::Font* font)
 {
+	GenerationStageScope stage("FontGenerator::SerializeFont");
+
     bool res = false;
 
 	if (font_path.empty() || !factory || !font)
@@ -992,6 +1086,36 @@ bool FontGenerator::SerializeFont(const std::string& font_path, sfntly::FontFact
 	size_t bufferLen = output_stream.Size();
 	if (bufferLen > 0)
 	{
+		// sfntly compute the tables checksums but not the head checkSumAdjustment
+		FontChecksum::FixChecksumAdjustment(output_stream.Get(), bufferLen);
+
+		// the font is validated before write
+		FontChecksumReportStruct report;
+		if (!FontChecksum::ValidateFont(output_stream.Get(), bufferLen, &report))
+		{
+			for (const auto& table : report.tables)
+			{
+				if (!table.IsValid())
+				{
+					Messaging::Instance()->AddError(true, nullptr, nullptr,
+						"Checksum mismatch of table %s in font %s (stored 0x%08X, computed 0x%08X)",
+						table.tag.c_str(), font_path.c_str(), table.storedCheckSum, table.computedCheckSum);
+				}
+			}
+			if (!report.IsAdjustmentValid())
+			{
+				Messaging::Instance()->AddError(true, nullptr, nullptr,
+					"Bad head checkSumAdjustment in font %s (stored 0x%08X, expected 0x%08X)",
+					font_path.c_str(), report.storedAdjustment, report.computedAdjustment);
+			}
+			if (!report.parsed)
+			{
+				Messaging::Instance()->AddError(true, nullptr, nullptr,
+					"Cant read the table directory of font %s", font_path.c_str());
+			}
+			return res;
+		}
+
 		FILE* output_file = nullptr;
 #if defined(MSVC)
 		fopen_s(&output_file, font_path.c_str(), "wb");
@@ -1003,6 +1127,7 @@ bool FontGenerator::SerializeFont(const std::string& font_path, sfntly::FontFact
 			fwrite(output_stream.Get(), 1, bufferLen, output_file);
 			fflush(output_file);
 			fclose(output_file);
+			GenerationProfiler::Instance()->AddOutputFile(font_path);
 			res = true;
 		}
 	}
@@ -49,6 +49,28 @@ struct Glyph
 };
 typedef std::pair<int32_t, std::string> CodePointName;
 
+class FontBlob;
+
+// font parsed by sfntly with the tables we need, read only
+// parsed one time per font file datas and cached by FontInfos (see FontInfos::GetSfntlyFont)
+// so shared by the FontGenerator and the GlyphPane
+class SfntlyFont
+{
+public:
+	static std::shared_ptr<SfntlyFont> Create(std::shared_ptr<const FontBlob> vFontBlob);
+
+public:
+	std::shared_ptr<const FontBlob> m_FontBlob = nullptr; // datas the font was parsed from
+	sfntly::Ptr<sfntly::Font> m_Font;
+	sfntly::Ptr<sfntly::FontHeaderTable> m_HeadTable;
+	sfntly::Ptr<sfntly::CMapTable::CMap> m_CMapTable;
+	sfntly::Ptr<sfntly::LocaTable> m_LocaTable;
+	sfntly::Ptr<sfntly::GlyphTable> m_GlyfTable;
+
+public:
+	bool IsValid() const;
+};
+
 class FontInstance
 {
 public:
@@ -75,7 +97,7 @@ public:
 
 public:
 	bool OpenFontFile(
-		const std::string& vFontFilePathName,
+		std::shared_ptr<FontInfos> vFontInfos,
 		std::map<CodePoint, std::string> vNewNames,
 		std::map<CodePoint, CodePoint> vNewCodePoints,
 		std::map<CodePoint, std::shared_ptr<GlyphInfos>> vNewGlyphInfos,
@@ -108,12 +130,14 @@ private: // post table - version / count / size / offsets
 
 public:
 	static sfntly::Font* LoadFontFile(const std::string& font_path);
+	static sfntly::Font* LoadFontBlob(const std::shared_ptr<const FontBlob>& vFontBlob);
 
 private: // imported/based or/modified from sfntly
-	static void LoadFontFiles(const std::string& font_path, sfntly::FontFactory* factory, sfntly::FontArray* fonts);
+	static void LoadFontFiles(const std::shared_ptr<const FontBlob>& vFontBlob, sfntly::FontFactory* factory, sfntly::FontArray* fonts);
 	static bool SerializeFont(const std::string& font_path, sfntly::Font* font);
 	static bool SerializeFont(const std::string& font_path, sfntly::FontFactory* factory, sfntly::Font* font);
 	sfntly::Font* AssembleFont(bool vUsePostTable);
+	bool ContinueAssembly(const float& vProgress);
 
 private:
 	bool Assemble_Glyf_Loca_Maxp_Tables();
@@ -20,13 +20,19 @@ enum _GenModeFlags
 	GENERATOR_MODE_LANG_PYTHON = (1 << 13),
 	GENERATOR_MODE_LANG_RUST = (1 << 14),
 	GENERATOR_MODE_OPEN_GENERATED_FILES_AUTO = (1 << 15),
+	GENERATOR_MODE_SKIP_UNCHANGED_OUTPUTS = (1 << 16), // see GenerationCache
+	GENERATOR_MODE_ATLAS = (1 << 17), // prebaked atlas, see AtlasGenerator
+	GENERATOR_MODE_ATLAS_SETTINGS_SDF = (1 << 18), // + distance field atlas, see SdfGenerator
+	GENERATOR_MODE_ATLAS_SETTINGS_MSDF = (1 << 19), // + multi channel distance field atlas
+	GENERATOR_MODE_HEADER_SETTINGS_NAMES_TABLE = (1 << 20), // sorted name to codepoint table in header
 
 	// Mix's
 
 	 // for radio widget's
 	 GENERATOR_MODE_RADIO_LANG = GENERATOR_MODE_LANG_C | GENERATOR_MODE_LANG_CPP | GENERATOR_MODE_LANG_CSHARP | GENERATOR_MODE_LANG_LUA | GENERATOR_MODE_LANG_PYTHON | GENERATOR_MODE_LANG_RUST,
-	 GENERATOR_MODE_RADIO_FONT_SRC = GENERATOR_MODE_FONT | GENERATOR_MODE_SRC,
+	 GENERATOR_MODE_RADIO_FONT_SRC = GENERATOR_MODE_FONT | GENERATOR_MODE_SRC | GENERATOR_MODE_ATLAS,
 	 GENERATOR_MODE_RADIO_CUR_BAT_MER = GENERATOR_MODE_CURRENT | GENERATOR_MODE_BATCH | GENERATOR_MODE_MERGED,
+	 GENERATOR_MODE_RADIO_ATLAS_DISTANCE_FIELD = GENERATOR_MODE_ATLAS_SETTINGS_SDF | GENERATOR_MODE_ATLAS_SETTINGS_MSDF,
 
 	 // for group's
 
@@ -0,0 +1,296 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GenerationCache.h"
+
+#include <fstream>
+#include <sstream>
+#include <cinttypes>
+
+#include <ctools/cTools.h>
+#include <ctools/FileHelper.h>
+#include <Helper/FontBlobRegistry.h>
+#include <Project/FontInfos.h>
+#include <Project/GlyphInfos.h>
+#include <Project/ProjectFile.h>
+
+// the flags who not change the content of the outputs
+// the mode (current, batch, merged) change the output file name, who is the key of the entry
+#define GENERATION_CACHE_IGNORED_FLAGS (GENERATOR_MODE_RADIO_CUR_BAT_MER | GENERATOR_MODE_OPEN_GENERATED_FILES_AUTO | GENERATOR_MODE_SKIP_UNCHANGED_OUTPUTS)
+
+// FNV-1a 64 bits
+#define GENERATION_CACHE_HASH_SEED 14695981039346656037ULL
+#define GENERATION_CACHE_HASH_PRIME 1099511628211ULL
+
+///////////////////////////////////////////////////////////////////////////////////
+//// HASH /////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+uint64_t GenerationCache::Hash(const void* vDatas, const size_t& vSize, uint64_t vHash)
+{
+	const uint8_t* datas = (const uint8_t*)vDatas;
+	if (datas)
+	{
+		for (size_t i = 0U; i < vSize; ++i)
+		{
+			vHash ^= (uint64_t)datas[i];
+			vHash *= GENERATION_CACHE_HASH_PRIME;
+		}
+	}
+	return vHash;
+}
+
+static uint64_t HashString(const std::string& vString, uint64_t vHash)
+{
+	const uint64_t len = (uint64_t)vString.size(); // the size avoid the collision between "ab" + "c" and "a" + "bc"
+	vHash = GenerationCache::Hash(&len, sizeof(len), vHash);
+	return GenerationCache::Hash(vString.data(), vString.size(), vHash);
+}
+
+template<typename T>
+static uint64_t HashValue(const T& vValue, uint64_t vHash)
+{
+	return GenerationCache::Hash(&vValue, sizeof(T), vHash);
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PUBLIC ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+void GenerationCache::Clear()
+{
+	m_FontHashs.clear();
+	m_Path.clear();
+	m_Entries.clear();
+	m_NeedSave = false;
+	m_CountSkippedOutputs = 0U;
+}
+
+uint64_t GenerationCache::ComputeKey_One(std::shared_ptr<FontInfos> vFontInfos, const GenModeFlags& vFlags)
+{
+	uint64_t hash = HashValue(GENERATION_CACHE_VERSION, GENERATION_CACHE_HASH_SEED);
+	hash = HashValue((GenModeFlags)(vFlags & ~GENERATION_CACHE_IGNORED_FLAGS), hash);
+	hash = HashFont(vFontInfos, hash);
+	hash = HashValue(ProjectFile::Instance()->m_AtlasSdfGlyphSizeInPixel, hash); // project wide
+	hash = HashValue(ProjectFile::Instance()->m_AtlasSdfPxRange, hash);
+	hash = HashValue(ProjectFile::Instance()->m_HeaderRangesGapTolerance, hash);
+	return hash;
+}
+
+uint64_t GenerationCache::ComputeKey_Merged(const GenModeFlags& vFlags)
+{
+	auto prj = ProjectFile::Instance();
+
+	uint64_t hash = HashValue(GENERATION_CACHE_VERSION, GENERATION_CACHE_HASH_SEED);
+	hash = HashValue((GenModeFlags)(vFlags & ~GENERATION_CACHE_IGNORED_FLAGS), hash);
+	hash = HashString(prj->m_MergedFontPrefix, hash);
+	hash = HashValue(prj->m_MergedCardGlyphHeightInPixel, hash);
+	hash = HashValue(prj->m_MergedCardCountRowsMax, hash);
+	hash = HashValue(prj->m_AtlasSdfGlyphSizeInPixel, hash);
+	hash = HashValue(prj->m_AtlasSdfPxRange, hash);
+	hash = HashValue(prj->m_HeaderRangesGapTolerance, hash);
+	hash = HashString(prj->m_FontToMergeIn, hash);
+	for (auto& font : prj->m_Fonts) // std::map, so always the same order
+	{
+		hash = HashFont(font.second, hash);
+	}
+	return hash;
+}
+
+bool GenerationCache::IsUpToDate(const std::string& vFilePathName, const uint64_t& vKey)
+{
+	std::string fileName;
+	if (SelectPath(vFilePathName, &fileName))
+	{
+		auto it = m_Entries.find(fileName);
+		if (it != m_Entries.end() &&
+			it->second == vKey &&
+			FileHelper::Instance()->IsFileExist(vFilePathName)) // deleted by the user since the last generation
+		{
+			++m_CountSkippedOutputs;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void GenerationCache::Store(const std::string& vFilePathName, const uint64_t& vKey)
+{
+	std::string fileName;
+	if (SelectPath(vFilePathName, &fileName))
+	{
+		m_Entries[fileName] = vKey;
+		m_NeedSave = true;
+	}
+}
+
+void GenerationCache::Remove(const std::string& vFilePathName)
+{
+	std::string fileName;
+	if (SelectPath(vFilePathName, &fileName))
+	{
+		if (m_Entries.erase(fileName))
+			m_NeedSave = true;
+	}
+}
+
+void GenerationCache::Save()
+{
+	if (m_NeedSave && !m_Path.empty())
+	{
+		std::string str;
+		for (const auto& entry : m_Entries)
+		{
+			str += ct::toStr("%016" PRIx64 " ", entry.second) + entry.first + "\n";
+		}
+
+		PathStruct ps(m_Path, GENERATION_CACHE_FILE_NAME, GENERATION_CACHE_FILE_EXT);
+		FileHelper::Instance()->SaveStringToFile(str, ps.GetFPNE());
+
+		m_NeedSave = false;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PRIVATE //////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+uint64_t GenerationCache::HashFont(std::shared_ptr<FontInfos> vFontInfos, uint64_t vHash)
+{
+	if (vFontInfos)
+	{
+		vHash = HashValue(GetFontFileHash(vFontInfos), vHash);
+		vHash = HashString(vFontInfos->m_FontFileName, vHash);
+		vHash = HashString(vFontInfos->m_FontPrefix, vHash);
+		vHash = HashValue(vFontInfos->m_GenModeFlags & ~GENERATION_CACHE_IGNORED_FLAGS, vHash);
+		vHash = HashValue(vFontInfos->m_CardGlyphHeightInPixel, vHash);
+		vHash = HashValue(vFontInfos->m_CardCountRowsMax, vHash);
+		// rasterizer settings, the prebaked atlas contain the pixels
+		vHash = HashValue(vFontInfos->m_Oversample, vHash);
+		vHash = HashValue(vFontInfos->m_FontSize, vHash);
+		vHash = HashValue(vFontInfos->m_FontMultiply, vHash);
+		vHash = HashValue(vFontInfos->m_FontPadding, vHash);
+		vHash = HashValue(vFontInfos->m_RasterizerMode, vHash);
+		vHash = HashValue(vFontInfos->m_FreeTypeFlag, vHash);
+		vHash = HashValue((uint64_t)vFontInfos->m_SelectedGlyphs.size(), vHash);
+		for (const auto& glyph : vFontInfos->m_SelectedGlyphs)
+		{
+			vHash = HashValue(glyph.first, vHash);
+			if (glyph.second)
+			{
+				vHash = HashValue(glyph.second->newCodePoint, vHash);
+				vHash = HashString(glyph.second->oldHeaderName, vHash);
+				vHash = HashString(glyph.second->newHeaderName, vHash);
+				vHash = HashValue(glyph.second->m_Translation.x, vHash);
+				vHash = HashValue(glyph.second->m_Translation.y, vHash);
+				vHash = HashValue(glyph.second->m_Scale.x, vHash);
+				vHash = HashValue(glyph.second->m_Scale.y, vHash);
+			}
+		}
+	}
+	return vHash;
+}
+
+// the hash of the font file is computed one time per file version (mtime + size)
+uint64_t GenerationCache::GetFontFileHash(std::shared_ptr<FontInfos> vFontInfos)
+{
+	uint64_t hash = GENERATION_CACHE_HASH_SEED;
+
+	std::string fontFilePathName = ProjectFile::Instance()->GetAbsolutePath(vFontInfos->m_FontFilePathName);
+	auto blob = FontBlobRegistry::Instance()->GetBlob(fontFilePathName);
+	if (blob && blob->IsValid())
+	{
+		auto& fontHash = m_FontHashs[fontFilePathName];
+		if (fontHash.modificationTime != blob->GetModificationTime() ||
+			fontHash.size != blob->GetSize() ||
+			fontHash.hash == 0U)
+		{
+			fontHash.modificationTime = blob->GetModificationTime();
+			fontHash.size = blob->GetSize();
+			fontHash.hash = Hash(blob->GetDatas(), blob->GetSize(), GENERATION_CACHE_HASH_SEED);
+		}
+		hash = fontHash.hash;
+	}
+	else
+	{
+		// font file not readable, the key will be unique, so the output will be generated (and the error reported)
+		hash = HashString(fontFilePathName, hash);
+		hash = HashValue((uint64_t)(size_t)vFontInfos.get(), hash);
+	}
+
+	return hash;
+}
+
+// load the cache file of the path of vFilePathName if not the current one
+bool GenerationCache::SelectPath(const std::string& vFilePathName, std::string* vFileName)
+{
+	auto ps = FileHelper::Instance()->ParsePathFileName(vFilePathName);
+	if (ps.isOk)
+	{
+		if (ps.path != m_Path)
+		{
+			Save(); // the entries of the previous path
+			Load(ps.path);
+		}
+
+		if (vFileName)
+		{
+			*vFileName = ps.name;
+			if (!ps.ext.empty())
+				*vFileName += "." + ps.ext;
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
+void GenerationCache::Load(const std::string& vPath)
+{
+	m_Path = vPath;
+	m_Entries.clear();
+	m_NeedSave = false;
+
+	PathStruct ps(m_Path, GENERATION_CACHE_FILE_NAME, GENERATION_CACHE_FILE_EXT);
+	std::ifstream file(ps.GetFPNE());
+	if (file.is_open())
+	{
+		std::string line;
+		while (std::getline(file, line))
+		{
+			// "hash file name", the file name can contain spaces
+			const size_t sep = line.find(' ');
+			if (sep != std::string::npos && sep > 0U && sep + 1U < line.size())
+			{
+				uint64_t key = 0U;
+				std::istringstream iss(line.substr(0U, sep));
+				iss >> std::hex >> key;
+				if (!iss.fail())
+				{
+					std::string fileName = line.substr(sep + 1U);
+					if (!fileName.empty() && fileName.back() == '\r') // file edited on windows
+						fileName.pop_back();
+					m_Entries[fileName] = key;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <map>
+
+#include <Generator/GenMode.h>
+
+// cache of the generation results, keyed by a hash of what produce the outputs :
+// source font bytes + selected glyphs (codepoints, names, transforms) + gen mode flags + font / project settings
+// the hashs are stored next to the outputs, in .ImGuiFontStudio.gencache (one line per output : "hash file name")
+// an output with the same hash as the last generation, and still on disk, is not generated again,
+// so his files are left untouched (no rebuild of the downstream projects)
+
+#define GENERATION_CACHE_FILE_NAME ".ImGuiFontStudio"
+#define GENERATION_CACHE_FILE_EXT "gencache"
+#define GENERATION_CACHE_VERSION 4U // to increase when the generator change his outputs for same inputs
+
+class FontInfos;
+class GenerationCache
+{
+private:
+	struct FontHashStruct
+	{
+		int64_t modificationTime = 0;
+		size_t size = 0U;
+		uint64_t hash = 0U;
+	};
+
+private:
+	std::map<std::string, FontHashStruct> m_FontHashs; // key is font file path name
+	std::string m_Path; // output path of m_Entries
+	std::map<std::string, uint64_t> m_Entries; // key is output file name, value is content hash
+	bool m_NeedSave = false;
+	size_t m_CountSkippedOutputs = 0U;
+
+public:
+	static uint64_t Hash(const void* vDatas, const size_t& vSize, uint64_t vHash);
+
+public:
+	void Clear();
+
+	uint64_t ComputeKey_One(std::shared_ptr<FontInfos> vFontInfos, const GenModeFlags& vFlags);
+	uint64_t ComputeKey_Merged(const GenModeFlags& vFlags);
+
+	bool IsUpToDate(const std::string& vFilePathName, const uint64_t& vKey);
+	void Store(const std::string& vFilePathName, const uint64_t& vKey);
+	void Remove(const std::string& vFilePathName);
+	void Save();
+
+	void ResetCountSkippedOutputs() { m_CountSkippedOutputs = 0U; }
+	size_t GetCountSkippedOutputs() const { return m_CountSkippedOutputs; }
+
+private:
+	uint64_t HashFont(std::shared_ptr<FontInfos> vFontInfos, uint64_t vHash);
+	uint64_t GetFontFileHash(std::shared_ptr<FontInfos> vFontInfos);
+	bool SelectPath(const std::string& vFilePathName, std::string* vFileName);
+	void Load(const std::string& vPath);
+};
@@ -0,0 +1,188 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GenerationProfiler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+
+#define GENERATION_NO_FONT SIZE_MAX
+
+// index in m_Fonts of the current font of the thread
+static thread_local size_t s_CurrentFontIdx = GENERATION_NO_FONT;
+
+GenerationProfiler::GenerationProfiler()
+	: m_Enabled(false)
+{
+
+}
+
+void GenerationProfiler::AddStageTime(const char* vStageName, const double& vTimeInMs)
+{
+	if (vStageName)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		size_t idx = 0U;
+		auto it = m_StageIndexs.find(vStageName);
+		if (it == m_StageIndexs.end()) // not found
+		{
+			idx = m_Stages.size();
+			m_StageIndexs[vStageName] = idx;
+			m_Stages.emplace_back();
+			m_Stages.back().name = vStageName;
+		}
+		else
+		{
+			idx = it->second;
+		}
+
+		auto& stage = m_Stages[idx];
+		++stage.countCalls;
+		stage.totalTimeInMs += vTimeInMs;
+		if (vTimeInMs > stage.maxTimeInMs)
+			stage.maxTimeInMs = vTimeInMs;
+
+		// same for the current font, few stages per font, so a linear search
+		if (s_CurrentFontIdx < m_Fonts.size())
+		{
+			auto& fontStages = m_Fonts[s_CurrentFontIdx].stages;
+			auto it = std::find_if(fontStages.begin(), fontStages.end(),
+				[vStageName](const GenerationStageStruct& vStage) { return vStage.name == vStageName; });
+			if (it == fontStages.end()) // not found
+			{
+				fontStages.emplace_back();
+				fontStages.back().name = vStageName;
+				it = fontStages.end() - 1;
+			}
+
+			++it->countCalls;
+			it->totalTimeInMs += vTimeInMs;
+			if (vTimeInMs > it->maxTimeInMs)
+				it->maxTimeInMs = vTimeInMs;
+		}
+	}
+}
+
+void GenerationProfiler::AddOutputFile(const std::string& vFilePathName)
+{
+	if (!m_Enabled || vFilePathName.empty())
+		return;
+
+	GenerationOutputFileStruct file;
+	file.filePathName = vFilePathName;
+	std::ifstream stream(vFilePathName, std::ios::binary | std::ios::ate);
+	if (stream.is_open())
+		file.sizeInBytes = (size_t)stream.tellg();
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (s_CurrentFontIdx < m_Fonts.size())
+	{
+		auto& files = m_Fonts[s_CurrentFontIdx].outputFiles;
+		auto it = std::find_if(files.begin(), files.end(),
+			[&vFilePathName](const GenerationOutputFileStruct& vFile) { return vFile.filePathName == vFilePathName; });
+		if (it == files.end()) // not found
+			files.push_back(file);
+		else
+			*it = file; // rewritten
+	}
+}
+
+void GenerationProfiler::RemoveOutputFile(const std::string& vFilePathName)
+{
+	if (!m_Enabled || vFilePathName.empty())
+		return;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (s_CurrentFontIdx < m_Fonts.size())
+	{
+		auto& files = m_Fonts[s_CurrentFontIdx].outputFiles;
+		files.erase(std::remove_if(files.begin(), files.end(),
+			[&vFilePathName](const GenerationOutputFileStruct& vFile) { return vFile.filePathName == vFilePathName; }), files.end());
+	}
+}
+
+std::vector<GenerationStageStruct> GenerationProfiler::GetStages()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_Stages;
+}
+
+std::vector<GenerationFontStruct> GenerationProfiler::GetFonts()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_Fonts;
+}
+
+void GenerationProfiler::Reset()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_Stages.clear();
+	m_StageIndexs.clear();
+	m_Fonts.clear();
+}
+
+size_t GenerationProfiler::BeginFont(const std::string& vFontName, const size_t& vCountGlyphs)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_Fonts.emplace_back();
+	m_Fonts.back().name = vFontName;
+	m_Fonts.back().countGlyphs = vCountGlyphs;
+	return m_Fonts.size() - 1U;
+}
+
+void GenerationProfiler::EndFont(const size_t& vFontIdx, const double& vTimeInMs, const bool& vSkipped, const bool& vSuccess)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (vFontIdx < m_Fonts.size()) // can be reset during the generation
+	{
+		auto& font = m_Fonts[vFontIdx];
+		font.totalTimeInMs = vTimeInMs;
+		font.skipped = vSkipped;
+		font.success = vSuccess;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// FONT SCOPE ///////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+GenerationFontScope::GenerationFontScope(const std::string& vFontName, const size_t& vCountGlyphs)
+	: m_Active(GenerationProfiler::Instance()->IsEnabled())
+{
+	if (m_Active)
+	{
+		m_LastFontIdx = s_CurrentFontIdx;
+		m_FontIdx = GenerationProfiler::Instance()->BeginFont(vFontName, vCountGlyphs);
+		s_CurrentFontIdx = m_FontIdx;
+		m_Start = std::chrono::steady_clock::now();
+	}
+}
+
+GenerationFontScope::~GenerationFontScope()
+{
+	if (m_Active)
+	{
+		GenerationProfiler::Instance()->EndFont(m_FontIdx,
+			std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_Start).count(),
+			m_Skipped, m_Success);
+		s_CurrentFontIdx = m_LastFontIdx;
+	}
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+// time spent in each stage of the generation pipeline (font assembly, serialization, compression, header, card)
+// the stages are measured with a GenerationStageScope at the start of the function
+// nothing is measured while disabled (only one atomic read per stage)
+// the stages and the written files are also given to the current font of the thread (see GenerationFontScope)
+// for the summary per font (see GenerationSummaryDialog)
+
+struct GenerationStageStruct
+{
+	std::string name;
+	size_t countCalls = 0U;
+	double totalTimeInMs = 0.0;
+	double maxTimeInMs = 0.0;
+
+	double GetAverageTimeInMs() const { return countCalls ? totalTimeInMs / (double)countCalls : 0.0; }
+};
+
+struct GenerationOutputFileStruct
+{
+	std::string filePathName;
+	size_t sizeInBytes = 0U;
+};
+
+struct GenerationFontStruct
+{
+	std::string name; // font name, or merged
+	size_t countGlyphs = 0U;
+	double totalTimeInMs = 0.0;
+	bool skipped = false; // up to date in the generation cache
+	bool success = false;
+	std::vector<GenerationStageStruct> stages; // in order of the first call
+	std::vector<GenerationOutputFileStruct> outputFiles;
+};
+
+class GenerationProfiler
+{
+private:
+	std::atomic<bool> m_Enabled;
+	std::mutex m_Mutex;
+	std::vector<GenerationStageStruct> m_Stages; // in order of the first call
+	std::map<std::string, size_t> m_StageIndexs; // key is stage name, value is index in m_Stages
+	std::vector<GenerationFontStruct> m_Fonts; // in order of generation
+
+public:
+	void SetEnabled(bool vEnabled) { m_Enabled = vEnabled; }
+	bool IsEnabled() const { return m_Enabled; }
+
+	void AddStageTime(const char* vStageName, const double& vTimeInMs);
+	// a file written by the generation, for the current font of the thread
+	void AddOutputFile(const std::string& vFilePathName);
+	void RemoveOutputFile(const std::string& vFilePathName); // temporary file
+	std::vector<GenerationStageStruct> GetStages();
+	std::vector<GenerationFontStruct> GetFonts();
+	void Reset();
+
+private:
+	friend class GenerationFontScope;
+	size_t BeginFont(const std::string& vFontName, const size_t& vCountGlyphs);
+	void EndFont(const size_t& vFontIdx, const double& vTimeInMs, const bool& vSkipped, const bool& vSuccess);
+
+public: // singleton
+	static GenerationProfiler* Instance()
+	{
+		static GenerationProfiler _instance;
+		return &_instance;
+	}
+
+protected:
+	GenerationProfiler(); // Prevent construction
+	GenerationProfiler(const GenerationProfiler&) {}; // Prevent construction by copying
+	GenerationProfiler& operator =(const GenerationProfiler&) { return *this; }; // Prevent assignment
+	~GenerationProfiler() = default; // Prevent unwanted destruction
+};
+
+// measure the scope as a stage of the GenerationProfiler
+class GenerationStageScope
+{
+private:
+	const char* m_StageName = nullptr; // static string
+	bool m_Active = false;
+	std::chrono::steady_clock::time_point m_Start;
+
+public:
+	explicit GenerationStageScope(const char* vStageName)
+		: m_StageName(vStageName), m_Active(GenerationProfiler::Instance()->IsEnabled())
+	{
+		if (m_Active)
+			m_Start = std::chrono::steady_clock::now();
+	}
+
+	~GenerationStageScope()
+	{
+		if (m_Active)
+		{
+			GenerationProfiler::Instance()->AddStageTime(m_StageName,
+				std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_Start).count());
+		}
+	}
+
+	GenerationStageScope(const GenerationStageScope&) = delete;
+	GenerationStageScope& operator =(const GenerationStageScope&) = delete;
+};
+
+// the stages measured in this scope, in the same thread, are given to this font
+class GenerationFontScope
+{
+private:
+	bool m_Active = false;
+	size_t m_FontIdx = 0U;
+	size_t m_LastFontIdx = 0U; // the scopes can be nested
+	bool m_Skipped = false;
+	bool m_Success = false;
+	std::chrono::steady_clock::time_point m_Start;
+
+public:
+	GenerationFontScope(const std::string& vFontName, const size_t& vCountGlyphs);
+	~GenerationFontScope();
+
+	void SetSkipped() { m_Skipped = true; }
+	void SetSuccess(const bool& vSuccess) { m_Success = vSuccess; }
+
+	GenerationFontScope(const GenerationFontScope&) = delete;
+	GenerationFontScope& operator =(const GenerationFontScope&) = delete;
+};
@@ -18,5 +18,204 @@
  */
 #include "GenerationSummaryDialog.h"
 
+#include <MainFrame.h>
+#include <Gui/ImWidgets.h>
+
+#include <imgui/imgui.h>
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include <imgui/imgui_internal.h>
+
+#include <ctools/cTools.h>
+
+#include <array>
+
 GenerationSummaryDialog::GenerationSummaryDialog() = default;
 GenerationSummaryDialog::~GenerationSummaryDialog() = default;
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PUBLIC ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+void GenerationSummaryDialog::OpenDialog(const std::vector<GenerationFontStruct>& vFonts,
+	const double& vTotalTimeInMs, const bool& vSuccess, const bool& vCancelled)
+{
+	m_Fonts = vFonts;
+	m_TotalTimeInMs = vTotalTimeInMs;
+	m_Success = vSuccess;
+	m_Cancelled = vCancelled;
+	m_ShowDialog = true;
+}
+
+void GenerationSummaryDialog::CloseDialog()
+{
+	m_ShowDialog = false;
+}
+
+void GenerationSummaryDialog::DrawDialog()
+{
+	if (m_ShowDialog)
+	{
+		ImGui::SetNextWindowSize(MainFrame::Instance()->m_DisplaySize * 0.5f, ImGuiCond_FirstUseEver);
+
+		if (ImGui::Begin("Generation Summary", &m_ShowDialog, ImGuiWindowFlags_NoDocking))
+		{
+			const char* status = m_Cancelled ? "Cancelled" : (m_Success ? "Done" : "Failed");
+			ImGui::Text("%s in %.2f ms", status, m_TotalTimeInMs);
+
+			if (m_Fonts.empty())
+			{
+				ImGui::Text("Nothing was generated");
+			}
+			else
+			{
+				DrawFontsTable();
+				DrawFontsDetails();
+			}
+		}
+		ImGui::End();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PRIVATE //////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// one row per font, one column per category of stage
+void GenerationSummaryDialog::DrawFontsTable()
+{
+	static ImGuiTableFlags flags =
+		ImGuiTableFlags_SizingFixedFit |
+		ImGuiTableFlags_RowBg |
+		ImGuiTableFlags_Borders |
+		ImGuiTableFlags_Resizable;
+
+	const int countCategories = (int)GenerationStageCategoryEnum::GENERATION_STAGE_Count;
+	if (ImGui::BeginTable("##GenerationSummaryTable", countCategories + 4, flags))
+	{
+		ImGui::TableSetupColumn("Font", ImGuiTableColumnFlags_WidthStretch);
+		ImGui::TableSetupColumn("Glyphs");
+		for (int i = 0; i < countCategories; ++i)
+			ImGui::TableSetupColumn(GetStageCategoryLabel((GenerationStageCategoryEnum)i));
+		ImGui::TableSetupColumn("Total");
+		ImGui::TableSetupColumn("Output");
+		ImGui::TableHeadersRow();
+
+		for (const auto& font : m_Fonts)
+		{
+			std::array<double, (size_t)GenerationStageCategoryEnum::GENERATION_STAGE_Count> times = {};
+			for (const auto& stage : font.stages)
+				times[(size_t)GetStageCategory(stage.name)] += stage.totalTimeInMs;
+
+			size_t outputSize = 0U;
+			for (const auto& file : font.outputFiles)
+				outputSize += file.sizeInBytes;
+
+			ImGui::TableNextRow();
+			int col = 0;
+			if (ImGui::TableSetColumnIndex(col++))
+			{
+				if (font.skipped)
+					ImGui::Text("%s (up to date)", font.name.c_str());
+				else if (!font.success)
+					ImGui::TextColored(ImVec4(1.0f, 0.0f, 0.0f, 1.0f), "%s (failed)", font.name.c_str());
+				else
+					ImGui::Text("%s", font.name.c_str());
+			}
+			if (ImGui::TableSetColumnIndex(col++))
+				ImGui::Text("%u", (uint32_t)font.countGlyphs);
+			for (const auto& time : times)
+			{
+				if (ImGui::TableSetColumnIndex(col++))
+				{
+					if (time > 0.0)
+						ImGui::Text("%.2f ms", time);
+					else
+						ImGui::TextDisabled("-");
+				}
+			}
+			if (ImGui::TableSetColumnIndex(col++))
+				ImGui::Text("%.2f ms", font.totalTimeInMs);
+			if (ImGui::TableSetColumnIndex(col++))
+				ImGui::Text("%s", GetSizeString(outputSize).c_str());
+		}
+
+		ImGui::EndTable();
+	}
+}
+
+// the written files and the raw stages of each font
+void GenerationSummaryDialog::DrawFontsDetails()
+{
+	if (ImGui::CollapsingHeader("Details"))
+	{
+		int idx = 0;
+		for (const auto& font : m_Fonts)
+		{
+			ImGui::PushID(idx++);
+			if (ImGui::TreeNode("##font", "%s", font.name.c_str()))
+			{
+				for (const auto& file : font.outputFiles)
+				{
+					ImGui::BulletText("%s : %s", file.filePathName.c_str(), GetSizeString(file.sizeInBytes).c_str());
+				}
+				for (const auto& stage : font.stages)
+				{
+					ImGui::BulletText("%s : %u call(s), %.2f ms (max %.2f ms)", stage.name.c_str(),
+						(uint32_t)stage.countCalls, stage.totalTimeInMs, stage.maxTimeInMs);
+				}
+				ImGui::TreePop();
+			}
+			ImGui::PopID();
+		}
+	}
+}
+
+// stage names are given by the GenerationStageScope's (ClassName::FunctionName)
+GenerationStageCategoryEnum GenerationSummaryDialog::GetStageCategory(const std::string& vStageName)
+{
+	if (vStageName == "FontGenerator::OpenFontFile")
+		return GenerationStageCategoryEnum::GENERATION_STAGE_OPEN;
+	if (vStageName == "FontGenerator::MergeCharacterMaps")
+		return GenerationStageCategoryEnum::GENERATION_STAGE_MERGE_CMAP;
+	if (vStageName.find("FontGenerator::Assemble_") == 0U)
+		return GenerationStageCategoryEnum::GENERATION_STAGE_ASSEMBLE_TABLES;
+	if (vStageName == "FontGenerator::SerializeFont")
+		return GenerationStageCategoryEnum::GENERATION_STAGE_SERIALIZE;
+	if (vStageName.find("Compress::") == 0U)
+		return GenerationStageCategoryEnum::GENERATION_STAGE_COMPRESS;
+	if (vStageName.find("HeaderGenerator::") == 0U)
+		return GenerationStageCategoryEnum::GENERATION_STAGE_HEADER;
+	if (vStageName == "Generator::WriteGlyphCardToPicture")
+		return GenerationStageCategoryEnum::GENERATION_STAGE_CARD;
+	if (vStageName.find("AtlasGenerator::") == 0U ||
+		vStageName.find("SdfGenerator::") == 0U)
+		return GenerationStageCategoryEnum::GENERATION_STAGE_ATLAS;
+	return GenerationStageCategoryEnum::GENERATION_STAGE_OTHER;
+}
+
+const char* GenerationSummaryDialog::GetStageCategoryLabel(const GenerationStageCategoryEnum& vCategory)
+{
+	switch (vCategory)
+	{
+	case GenerationStageCategoryEnum::GENERATION_STAGE_OPEN: return "Open";
+	case GenerationStageCategoryEnum::GENERATION_STAGE_MERGE_CMAP: return "Merge CMap";
+	case GenerationStageCategoryEnum::GENERATION_STAGE_ASSEMBLE_TABLES: return "Assemble Tables";
+	case GenerationStageCategoryEnum::GENERATION_STAGE_SERIALIZE: return "Serialize";
+	case GenerationStageCategoryEnum::GENERATION_STAGE_COMPRESS: return "Compress";
+	case GenerationStageCategoryEnum::GENERATION_STAGE_HEADER: return "Header";
+	case GenerationStageCategoryEnum::GENERATION_STAGE_CARD: return "Card";
+	case GenerationStageCategoryEnum::GENERATION_STAGE_ATLAS: return "Atlas";
+	case GenerationStageCategoryEnum::GENERATION_STAGE_OTHER: return "Other";
+	default: break;
+	}
+	return "";
+}
+
+std::string GenerationSummaryDialog::GetSizeString(const size_t& vSizeInBytes)
+{
+	if (vSizeInBytes >= 1024U * 1024U)
+		return ct::toStr("%.2f MB", (double)vSizeInBytes / (1024.0 * 1024.0));
+	if (vSizeInBytes >= 1024U)
+		return ct::toStr("%.2f KB", (double)vSizeInBytes / 1024.0);
+	return ct::toStr("%u B", (uint32_t)vSizeInBytes);
+}
@@ -15,10 +15,53 @@
  */
 #pragma once
 
+#include <Generator/GenerationProfiler.h>
+
+#include <string>
+#include <vector>
+
+// summary of the last generation done by the GeneratorPane
+// per font : the time of each stage, the glyph count and the written files with their sizes
+// the stages of the GenerationProfiler are grouped by category
+
+enum class GenerationStageCategoryEnum
+{
+	GENERATION_STAGE_OPEN = 0,
+	GENERATION_STAGE_MERGE_CMAP,
+	GENERATION_STAGE_ASSEMBLE_TABLES,
+	GENERATION_STAGE_SERIALIZE,
+	GENERATION_STAGE_COMPRESS,
+	GENERATION_STAGE_HEADER,
+	GENERATION_STAGE_CARD,
+	GENERATION_STAGE_ATLAS,
+	GENERATION_STAGE_OTHER,
+	GENERATION_STAGE_Count
+};
+
 class GenerationSummaryDialog
 {
+private:
+	bool m_ShowDialog = false;
+	std::vector<GenerationFontStruct> m_Fonts;
+	double m_TotalTimeInMs = 0.0;
+	bool m_Cancelled = false;
+	bool m_Success = false;
+
 public:
 	GenerationSummaryDialog();
 	~GenerationSummaryDialog();
+
+	void OpenDialog(const std::vector<GenerationFontStruct>& vFonts,
+		const double& vTotalTimeInMs, const bool& vSuccess, const bool& vCancelled);
+	void CloseDialog();
+	void DrawDialog();
+
+private:
+	void DrawFontsTable();
+	void DrawFontsDetails();
+
+	static GenerationStageCategoryEnum GetStageCategory(const std::string& vStageName);
+	static const char* GetStageCategoryLabel(const GenerationStageCategoryEnum& vCategory);
+	static std::string GetSizeString(const size_t& vSizeInBytes);
 };
 
@@ -19,13 +19,23 @@
 
 #include "Generator.h"
 
+#include <Generator/AtlasGenerator.h>
 #include <Generator/Compress.h>
+#include <Generator/GenerationProfiler.h>
+#include <Generator/PngStreamWriter.h>
+#include <Generator/SdfGenerator.h>
 
 #include <imgui/imgui.h>
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui/imgui_internal.h>
 
 #include <ios>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <unordered_map>
+#include <vector>
 #include <sfntly/font.h>
 #include <sfntly/port/file_input_stream.h>
 #include <sfntly/tag.h>
@@ -47,8 +57,8 @@
 #include <Project/FontInfos.h>
 #include <Project/ProjectFile.h>
 #include <Helper/TextureHelper.h>
+#include <Helper/TaskSystem.h>
 
-#include <stb/stb_image_write.h>
 #include <imgui/imstb_truetype.h>
 
 #ifdef _DEBUG
@@ -58,9 +68,73 @@
 Generator::Generator() = default;
 Generator::~Generator() = default;
 
+// the outline of the glyphs (font and source generation, distance field atlas) are read with sfntly
+static bool IsSfntlyNeeded(const GenModeFlags& vFlags)
+{
+	return (vFlags & (GENERATOR_MODE_FONT | GENERATOR_MODE_SRC)) ||
+		((vFlags & GENERATOR_MODE_ATLAS) && (vFlags & GENERATOR_MODE_RADIO_ATLAS_DISTANCE_FIELD));
+}
+
+void Generator::PrepareGeneration()
+{
+	// the fonts deferred at project open are loaded at first generation
+	// and the sfntly font is parsed here, not by the generation (lazy cache of the FontInfos)
+	if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_CURRENT))
+	{
+		auto font = ProjectFile::Instance()->m_SelectedFont;
+		if (font)
+		{
+			font->EnsureLoaded();
+			if (IsSfntlyNeeded(font->m_GenModeFlags))
+				font->GetSfntlyFont();
+		}
+	}
+	else
+	{
+		const GenModeFlags flags = ProjectFile::Instance()->m_GenModeFlags;
+		for (auto& font : ProjectFile::Instance()->m_Fonts)
+		{
+			if (font.second)
+			{
+				font.second->EnsureLoaded();
+				if (IsSfntlyNeeded(ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_MERGED) ? flags : font.second->m_GenModeFlags))
+					font.second->GetSfntlyFont();
+			}
+		}
+	}
+
+	// the imgui atlas is not to read from a worker
+	m_LabelFontDatas.clear();
+	m_LabelFontNo = 0;
+	auto io = &ImGui::GetIO();
+	if (!io->Fonts->ConfigData.empty() &&
+		io->Fonts->ConfigData[0].FontData &&
+		io->Fonts->ConfigData[0].FontDataSize > 0)
+	{
+		const auto datas = (const uint8_t*)io->Fonts->ConfigData[0].FontData;
+		m_LabelFontDatas.assign(datas, datas + io->Fonts->ConfigData[0].FontDataSize);
+		m_LabelFontNo = io->Fonts->ConfigData[0].FontNo;
+	}
+}
+
+void Generator::FinishGeneration()
+{
+	for (const auto& it : m_GeneratedFileNames)
+	{
+		if (it.first)
+			it.first->m_GeneratedFileName = it.second;
+	}
+	m_GeneratedFileNames.clear();
+
+	for (const auto& fontFilePathName : m_FontFilesToOpen)
+		ParamsPane::Instance()->OpenFont(fontFilePathName, false); // directly load the generated font file
+	m_FontFilesToOpen.clear();
+}
+
 bool Generator::Generate(
 	const std::string & vFilePath,
-	const std::string & vFileName)
+	const std::string & vFileName,
+	TaskContext* vTask)
 {
 	bool res = false;
 
@@ -69,78 +143,110 @@ bool Generator::Generate(
 	if (!vFilePath.empty()) mainPS.path = vFilePath;
 	if (!vFileName.empty()) mainPS.name = vFileName;
 
+	m_Task = vTask;
+	m_GenerationCancelled = false;
+	if (!m_Task)
+		PrepareGeneration();
+
+	m_GenerationCache.ResetCountSkippedOutputs();
+
 	if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_CURRENT) &&
 		ProjectFile::Instance()->m_SelectedFont.use_count())
 	{
-		if (ProjectFile::Instance()->m_SelectedFont->IsGenMode(GENERATOR_MODE_SRC))
+		auto font = ProjectFile::Instance()->m_SelectedFont;
+		auto keyFunc = [this, font]() { return m_GenerationCache.ComputeKey_One(font, font->m_GenModeFlags); };
+		const size_t countGlyphs = font->m_SelectedGlyphs.size();
+
+		BeginOutputProgress(0.0f, 1.0f, font->m_FontFileName);
+
+		if (font->IsGenMode(GENERATOR_MODE_SRC))
 		{
-			res = GenerateSource_One(
-				mainPS.GetFPNE(),
-				ProjectFile::Instance()->m_SelectedFont,
-				ProjectFile::Instance()->m_SelectedFont->m_GenModeFlags);
+			res = GenerateIfChanged(GetMainOutputFilePathName(mainPS.GetFPNE(), font->m_GenModeFlags, false), font->m_FontFileName, countGlyphs, keyFunc,
+				[this, &mainPS, font]() { return GenerateSource_One(mainPS.GetFPNE(), font, font->m_GenModeFlags); });
 		}
-		else if (ProjectFile::Instance()->m_SelectedFont->IsGenMode(GENERATOR_MODE_FONT))
+		else if (font->IsGenMode(GENERATOR_MODE_FONT))
 		{
-			res = GenerateFontFile_One(
-				mainPS.GetFPNE(),
-				ProjectFile::Instance()->m_SelectedFont,
-				ProjectFile::Instance()->m_SelectedFont->m_GenModeFlags);
+			res = GenerateIfChanged(GetMainOutputFilePathName(mainPS.GetFPNE(), font->m_GenModeFlags, false), font->m_FontFileName, countGlyphs, keyFunc,
+				[this, &mainPS, font]() { return GenerateFontFile_One(mainPS.GetFPNE(), font, font->m_GenModeFlags); });
 #ifdef AUTO_OPEN_FONT_IN_APP_AFTER_GENERATION_FOR_DEBUG_PURPOSE
 			if (res)
-				ParamsPane::Instance()->OpenFont(mainPS.GetFPNE(), false); // directly load the generated font file
+				m_FontFilesToOpen.push_back(mainPS.GetFPNE());
 #endif
 		}
-		else if (ProjectFile::Instance()->m_SelectedFont->IsGenMode(GENERATOR_MODE_CARD))
+		else if (font->IsGenMode(GENERATOR_MODE_ATLAS))
+		{
+			res = GenerateIfChanged(GetMainOutputFilePathName(mainPS.GetFPNE(), font->m_GenModeFlags, false), font->m_FontFileName, countGlyphs, keyFunc,
+				[this, &mainPS, font]() { return GenerateAtlas_One(mainPS.GetFPNE(), font, font->m_GenModeFlags); });
+		}
+		else if (font->IsGenMode(GENERATOR_MODE_CARD))
 		{
-			res = GenerateCard_One(
-				mainPS.GetFPNE_WithExt("png"),
-				ProjectFile::Instance()->m_SelectedFont);
+			res = GenerateIfChanged(GetMainOutputFilePathName(mainPS.GetFPNE_WithExt("png"), GENERATOR_MODE_CARD, false), font->m_FontFileName, countGlyphs, keyFunc,
+				[this, &mainPS, font]() { return GenerateCard_One(mainPS.GetFPNE_WithExt("png"), font); });
 		}
 	}
 	else if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_BATCH))
 	{
+		size_t countFonts = 0U, fontIdx = 0U;
+		for (auto font : ProjectFile::Instance()->m_Fonts)
+		{
+			if (font.second.use_count() &&
+				font.second->m_EnabledForGeneration)
+				++countFonts;
+		}
+
 		for (auto font : ProjectFile::Instance()->m_Fonts)
 		{
 			if (font.second.use_count() &&
 				font.second->m_EnabledForGeneration) // actif dans le per font pour la generation
 			{
+				if (IsCancelRequested())
+				{
+					m_GenerationCancelled = true; // this font and the next ones are abandoned
+					break;
+				}
+
+				BeginOutputProgress((float)fontIdx / (float)countFonts, (float)(fontIdx + 1U) / (float)countFonts, font.second->m_FontFileName);
+				++fontIdx;
+
 				std::string fileName = font.second->m_FontFileName;
 				if (!font.second->m_GeneratedFileName.empty())
 					fileName = font.second->m_GeneratedFileName;
 				auto ps = FileHelper::Instance()->ParsePathFileName(fileName);
 				if (ps.isOk)
 				{
+					auto fontInfos = font.second;
+					auto keyFunc = [this, fontInfos]() { return m_GenerationCache.ComputeKey_One(fontInfos, fontInfos->m_GenModeFlags); };
+					const std::string& fontName = fontInfos->m_FontFileName;
+					const size_t countGlyphs = fontInfos->m_SelectedGlyphs.size();
+
 					// settings per font
-					if (font.second->IsGenMode(GENERATOR_MODE_SRC))
+					if (fontInfos->IsGenMode(GENERATOR_MODE_SRC))
 					{
-						GenerateSource_One(
-							ps.GetFPNE_WithPath(mainPS.path),
-							font.second,
-							font.second->m_GenModeFlags);
+						const std::string filePathName = ps.GetFPNE_WithPath(mainPS.path);
+						GenerateIfChanged(GetMainOutputFilePathName(filePathName, fontInfos->m_GenModeFlags, false), fontName, countGlyphs, keyFunc,
+							[this, &filePathName, fontInfos]() { return GenerateSource_One(filePathName, fontInfos, fontInfos->m_GenModeFlags); });
 					}
-					else if (font.second->IsGenMode(GENERATOR_MODE_FONT))
+					else if (fontInfos->IsGenMode(GENERATOR_MODE_FONT))
 					{
-						res = GenerateFontFile_One(
-							ps.GetFPNE_WithPath(mainPS.path),
-							font.second,
-							font.second->m_GenModeFlags);
+						const std::string filePathName = ps.GetFPNE_WithPath(mainPS.path);
+						res = GenerateIfChanged(GetMainOutputFilePathName(filePathName, fontInfos->m_GenModeFlags, false), fontName, countGlyphs, keyFunc,
+							[this, &filePathName, fontInfos]() { return GenerateFontFile_One(filePathName, fontInfos, fontInfos->m_GenModeFlags); });
 #ifdef AUTO_OPEN_FONT_IN_APP_AFTER_GENERATION_FOR_DEBUG_PURPOSE
 						if (res)
-							ParamsPane::Instance()->OpenFont(mainPS.GetFPNE(), false); // directly load the generated font file
+							m_FontFilesToOpen.push_back(mainPS.GetFPNE());
 #endif
 					}
-					else if (font.second->IsGenMode(GENERATOR_MODE_CARD))
+					else if (fontInfos->IsGenMode(GENERATOR_MODE_ATLAS))
 					{
-						std::string fileName = font.second->m_FontFileName;
-						if (!font.second->m_GeneratedFileName.empty())
-							fileName = font.second->m_GeneratedFileName;
-						auto ps = FileHelper::Instance()->ParsePathFileName(fileName);
-						if (ps.isOk)
-						{
-							res = GenerateCard_One(
-								ps.GetFPNE_WithPathExt(mainPS.path, "png"),
-								font.second);
-						}
+						const std::string filePathName = ps.GetFPNE_WithPath(mainPS.path);
+						res = GenerateIfChanged(GetMainOutputFilePathName(filePathName, fontInfos->m_GenModeFlags, false), fontName, countGlyphs, keyFunc,
+							[this, &filePathName, fontInfos]() { return GenerateAtlas_One(filePathName, fontInfos, fontInfos->m_GenModeFlags); });
+					}
+					else if (fontInfos->IsGenMode(GENERATOR_MODE_CARD))
+					{
+						const std::string filePathName = ps.GetFPNE_WithPathExt(mainPS.path, "png");
+						res = GenerateIfChanged(GetMainOutputFilePathName(filePathName, GENERATOR_MODE_CARD, false), fontName, countGlyphs, keyFunc,
+							[this, &filePathName, fontInfos]() { return GenerateCard_One(filePathName, fontInfos); });
 					}
 				}
 			}
@@ -148,28 +254,185 @@ bool Generator::Generate(
 	}
 	else if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_MERGED))
 	{
+		const GenModeFlags flags = ProjectFile::Instance()->m_GenModeFlags;
+		auto keyFunc = [this, flags]() { return m_GenerationCache.ComputeKey_Merged(flags); };
+
+		size_t countGlyphs = 0U;
+		for (const auto& font : ProjectFile::Instance()->m_Fonts)
+		{
+			if (font.second)
+				countGlyphs += font.second->m_SelectedGlyphs.size();
+		}
+
+		const std::string fontName = "Merged";
+		BeginOutputProgress(0.0f, 1.0f, fontName);
+
 		if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_SRC))
 		{
-			res = GenerateSource_Merged(
-				mainPS.GetFPNE(),
-				ProjectFile::Instance()->m_GenModeFlags);
+			res = GenerateIfChanged(GetMainOutputFilePathName(mainPS.GetFPNE(), flags, true), fontName, countGlyphs, keyFunc,
+				[this, &mainPS, flags]() { return GenerateSource_Merged(mainPS.GetFPNE(), flags); });
 		}
 		else if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_FONT))
 		{
-			res = GenerateFontFile_Merged(
-				mainPS.GetFPNE(),
-				ProjectFile::Instance()->m_GenModeFlags);
+			res = GenerateIfChanged(GetMainOutputFilePathName(mainPS.GetFPNE(), flags, true), fontName, countGlyphs, keyFunc,
+				[this, &mainPS, flags]() { return GenerateFontFile_Merged(mainPS.GetFPNE(), flags); });
 #ifdef AUTO_OPEN_FONT_IN_APP_AFTER_GENERATION_FOR_DEBUG_PURPOSE
 			if (res)
-				ParamsPane::Instance()->OpenFont(mainPS.GetFPNE(), false); // directly load the generated font file
+				m_FontFilesToOpen.push_back(mainPS.GetFPNE());
 #endif
 		}
+		else if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_ATLAS))
+		{
+			res = GenerateIfChanged(GetMainOutputFilePathName(mainPS.GetFPNE(), flags, true), fontName, countGlyphs, keyFunc,
+				[this, &mainPS, flags]() { return GenerateAtlas_Merged(mainPS.GetFPNE(), flags); });
+		}
 		else if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_CARD))
 		{
-			res = GenerateCard_Merged(mainPS.GetFPNE_WithExt("png"));
+			res = GenerateIfChanged(GetMainOutputFilePathName(mainPS.GetFPNE_WithExt("png"), GENERATOR_MODE_CARD, true), fontName, countGlyphs, keyFunc,
+				[this, &mainPS]() { return GenerateCard_Merged(mainPS.GetFPNE_WithExt("png")); });
 		}
 	}
 
+	m_GenerationCache.Save();
+
+	const size_t countSkipped = m_GenerationCache.GetCountSkippedOutputs();
+	if (countSkipped)
+	{
+		Messaging::Instance()->AddInfos(false, nullptr, nullptr,
+			"%u output(s) not generated, no changes since the last generation", (uint32_t)countSkipped);
+	}
+
+	// a cancel requested after the last output is ignored, all is written
+	if (m_GenerationCancelled)
+	{
+		Messaging::Instance()->AddWarning(true, nullptr, nullptr, "Generation cancelled");
+		res = false;
+	}
+
+	if (!m_Task)
+		FinishGeneration();
+	m_Task = nullptr;
+
+	return res;
+}
+
+bool Generator::IsCancelRequested() const
+{
+	return m_Task && m_Task->IsCancelRequested();
+}
+
+bool Generator::CheckCancel()
+{
+	if (IsCancelRequested())
+	{
+		m_OutputAbandoned = true;
+		return true;
+	}
+	return false;
+}
+
+void Generator::BeginOutputProgress(const float& vStart, const float& vEnd, const std::string& vMsg)
+{
+	m_OutputProgressStart = vStart;
+	m_OutputProgressEnd = vEnd;
+	if (m_Task)
+		m_Task->SetProgress(vStart, vMsg);
+}
+
+void Generator::SetOutputProgress(const float& vProgress)
+{
+	if (m_Task)
+	{
+		const float progress = ct::clamp<float>(vProgress, 0.0f, 1.0f);
+		m_Task->SetProgress(m_OutputProgressStart + (m_OutputProgressEnd - m_OutputProgressStart) * progress);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// GENERATION CACHE /////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// the file who exist after a generation in all cases, must follow the naming of the Generate* functions
+std::string Generator::GetMainOutputFilePathName(
+	const std::string& vFilePathName,
+	const GenModeFlags& vFlags,
+	const bool& vMerged)
+{
+	auto ps = FileHelper::Instance()->ParsePathFileName(vFilePathName);
+	if (ps.isOk)
+	{
+		if (vFlags & GENERATOR_MODE_SRC)
+		{
+			if (vMerged)
+				ct::replaceString(ps.name, "-", "_");
+			if (vFlags & GENERATOR_MODE_LANG_C) return ps.GetFPNE_WithExt("c");
+			else if (vFlags & GENERATOR_MODE_LANG_CPP) return ps.GetFPNE_WithExt("cpp");
+			else if (vFlags & GENERATOR_MODE_LANG_CSHARP) return ps.GetFPNE_WithNameExt(ps.name + "_Bytes", "cs");
+		}
+		else if (vFlags & GENERATOR_MODE_FONT)
+		{
+			if (vMerged) // GenerateFontFile_Merged write the font file at vFilePathName
+				return vFilePathName;
+			std::string name = ps.name;
+			ct::replaceString(name, "-", "_");
+			return ps.GetFPNE_WithNameExt(name, "ttf");
+		}
+		else if (vFlags & GENERATOR_MODE_ATLAS)
+		{
+			std::string name = ps.name;
+			ct::replaceString(name, "-", "_");
+			return ps.GetFPNE_WithNameExt(name, PREBAKED_ATLAS_FILE_EXT);
+		}
+		else if (vFlags & GENERATOR_MODE_CARD)
+		{
+			std::string name = ps.name;
+			ct::replaceString(name, "-", "_");
+			return ps.GetFPNE_WithNameExt(name, "png");
+		}
+	}
+
+	return vFilePathName;
+}
+
+// generate only if the output is not up to date in the generation cache
+// the cache is always updated, the skip is only done if GENERATOR_MODE_SKIP_UNCHANGED_OUTPUTS is set
+bool Generator::GenerateIfChanged(
+	const std::string& vOutputFilePathName,
+	const std::string& vFontName,
+	const size_t& vCountGlyphs,
+	const std::function<uint64_t()>& vKeyFunc,
+	const std::function<bool()>& vGenerateFunc)
+{
+	if (IsCancelRequested())
+	{
+		m_GenerationCancelled = true; // abandoned before his start
+		return false;
+	}
+
+	GenerationFontScope fontScope(vFontName, vCountGlyphs);
+
+	const uint64_t key = vKeyFunc();
+
+	if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_SKIP_UNCHANGED_OUTPUTS) &&
+		m_GenerationCache.IsUpToDate(vOutputFilePathName, key))
+	{
+		fontScope.SetSkipped();
+		fontScope.SetSuccess(true);
+		return true;
+	}
+
+	m_OutputAbandoned = false;
+	bool res = vGenerateFunc();
+	if (m_OutputAbandoned) // some parts can be written, but not all
+	{
+		m_GenerationCancelled = true;
+		res = false;
+	}
+	fontScope.SetSuccess(res);
+	if (res)
+		m_GenerationCache.Store(vOutputFilePathName, key);
+	else
+		m_GenerationCache.Remove(vOutputFilePathName);
 
 	return res;
 }
@@ -178,54 +441,153 @@ bool Generator::Generate(
 //// CARD GENERATION //////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////
 
+// one char of the label font, rasterized once per card and blitted for each label
+struct CardLabelCharStruct
+{
+	std::vector<uint8_t> bitmap;
+	int32_t x0 = 0, y0 = 0, w = 0, h = 0;
+	int32_t advance = 0; // not scaled
+	float scale = 0.0f; // can be less than the label scale if the char not fit in the row
+};
+
+class CardLabelCache
+{
+private:
+	const stbtt_fontinfo* m_FontInfo = nullptr;
+	float m_Scale = 0.0f;
+	float m_ShiftY = 0.0f;
+	int32_t m_Baseline = 0;
+	std::unordered_map<int32_t, CardLabelCharStruct> m_Chars;
+	std::unordered_map<uint64_t, int32_t> m_Kerns;
+
+public:
+	CardLabelCache(const stbtt_fontinfo* vFontInfo, const uint32_t& vLabelHeight, const uint32_t& vGlyphHeight)
+		: m_FontInfo(vFontInfo)
+	{
+		int32_t ascent, descent;
+		m_Scale = stbtt_ScaleForPixelHeight(m_FontInfo, (float)(vLabelHeight));
+		stbtt_GetFontVMetrics(m_FontInfo, &ascent, &descent, 0);
+		m_Baseline = (int32_t)(ascent * m_Scale);
+		m_ShiftY = vGlyphHeight * 0.5f - vLabelHeight * 0.5f;
+	}
+
+	float GetScale() const { return m_Scale; }
+	int32_t GetBaseline() const { return m_Baseline; }
+
+	const CardLabelCharStruct& GetChar(const int32_t& vChar)
+	{
+		auto it = m_Chars.find(vChar);
+		if (it != m_Chars.end()) // found
+			return it->second;
+
+		auto& c = m_Chars[vChar];
+		int32_t lsb, x1, y1;
+		stbtt_GetCodepointHMetrics(m_FontInfo, vChar, &c.advance, &lsb);
+		c.scale = m_Scale;
+		stbtt_GetCodepointBitmapBoxSubpixel(m_FontInfo, vChar, c.scale, c.scale, 0, m_ShiftY, &c.x0, &c.y0, &x1, &y1);
+		while (m_Baseline + c.y0 < 0) // we decrease scale until char can be added in picture
+		{
+			c.scale *= 0.9f;
+			stbtt_GetCodepointBitmapBoxSubpixel(m_FontInfo, vChar, c.scale, c.scale, 0, m_ShiftY, &c.x0, &c.y0, &x1, &y1);
+		}
+		c.w = x1 - c.x0;
+		c.h = y1 - c.y0;
+		if (c.w > 0 && c.h > 0)
+		{
+			c.bitmap.resize((size_t)c.w * (size_t)c.h);
+			stbtt_MakeCodepointBitmapSubpixel(m_FontInfo, c.bitmap.data(), c.w, c.h, c.w, c.scale, c.scale, 0, 0, vChar);
+		}
+		return c;
+	}
+
+	int32_t GetKern(const int32_t& vChar, const int32_t& vNextChar)
+	{
+		const uint64_t key = ((uint64_t)(uint32_t)vChar << 32) | (uint64_t)(uint32_t)vNextChar;
+		auto it = m_Kerns.find(key);
+		if (it != m_Kerns.end()) // found
+			return it->second;
+		return m_Kerns[key] = stbtt_GetCodepointKernAdvance(m_FontInfo, vChar, vNextChar);
+	}
+};
+
+// position of one glyph and his label in the card, computed before any rasterization
+struct CardItemLayoutStruct
+{
+	const stbtt_fontinfo* glyphFontInfo = nullptr;
+	uint32_t codePoint = 0U;
+	float glyphScale = 0.0f;
+	int32_t glyphX = 0, glyphY = 0, glyphW = 0, glyphH = 0;
+	int32_t labelX = 0, labelY = 0;
+	int32_t minY = 0, maxY = 0; // vertical extent in the picture, for find the bands to render
+	std::string label;
+};
+
+// metrics of the glyph font, computed once per font
+struct CardFontStruct
+{
+	stbtt_fontinfo fontInfo;
+	float scale = 0.0f;
+	int32_t ascent = 0, descent = 0, baseline = 0;
+};
+
+// copy a bitmap in a band of the picture, clipped to the band
+// vX, vY are in picture space, vBandY is the first picture row of the band
+static void BlitCardBitmap(std::vector<uint8_t>& vBand, const int32_t& vBandWidth, const int32_t& vBandY, const int32_t& vBandHeight,
+	const uint8_t* vBitmap, const int32_t& vBitmapWidth, const int32_t& vBitmapHeight, const int32_t& vX, const int32_t& vY)
+{
+	if (vX < 0 || vY < 0) return;
+	const int32_t w = ct::mini(vBitmapWidth, vBandWidth - vX);
+	const int32_t startRow = ct::maxi(0, vBandY - vY);
+	const int32_t endRow = ct::mini(vBitmapHeight, vBandY + vBandHeight - vY);
+	if (w <= 0 || startRow >= endRow) return;
+	for (int32_t j = startRow; j < endRow; ++j)
+	{
+		memcpy(vBand.data() + (size_t)vBandWidth * (size_t)(vY + j - vBandY) + (size_t)vX,
+			vBitmap + (size_t)vBitmapWidth * (size_t)j, (size_t)w);
+	}
+}
+
 bool Generator::WriteGlyphCardToPicture(
 	const std::string & vFilePathName,
 	std::map<std::string, std::pair<uint32_t, size_t>> vLabels, // lable, codepoint, FontInfos ptr
 	const uint32_t & vGlyphHeight, const uint32_t & vMaxRows)
 {
+	GenerationStageScope stage("Generator::WriteGlyphCardToPicture");
+
 	bool res = false;
 
 	if (vGlyphHeight && vMaxRows)
 	{
 		stbtt_fontinfo labelFontInfo;
 
-		// FontInfos ptr (size_t), stbtt_fontinfo // size_t is alwasy the size of the address (uint32_t for x32, uint64_t for x64)
-		std::unordered_map<size_t, stbtt_fontinfo> fonts;
+		// FontInfos ptr (size_t), font metrics // size_t is alwasy the size of the address (uint32_t for x32, uint64_t for x64)
+		std::unordered_map<size_t, CardFontStruct> fonts;
 
-		auto io = &ImGui::GetIO();
-		if (!io->Fonts->ConfigData.empty())
+		// copied from imgui by PrepareGeneration
+		if (!m_LabelFontDatas.empty())
 		{
 			const int32_t font_offset = stbtt_GetFontOffsetForIndex(
-				(unsigned char*)io->Fonts->ConfigData[0].FontData,
-				io->Fonts->ConfigData[0].FontNo);
-			if (stbtt_InitFont(&labelFontInfo, (unsigned char*)io->Fonts->ConfigData[0].FontData, font_offset))
+				m_LabelFontDatas.data(), m_LabelFontNo);
+			if (stbtt_InitFont(&labelFontInfo, m_LabelFontDatas.data(), font_offset))
 			{
 				// will write one glyph labeled
 
 				uint32_t labelHeight = (uint32_t)(vGlyphHeight * 0.5f);
 				uint32_t glyphHeight = (uint32_t)(vGlyphHeight * 0.8f);
-				uint32_t padding_x = (uint32_t)(vGlyphHeight * 0.1f);
-				uint32_t padding_y = 2U;
-				uint32_t columnCount = (uint32_t)ceil((double)vLabels.size() / (double)vMaxRows);
+				int32_t padding_x = (int32_t)(vGlyphHeight * 0.1f);
+				int32_t padding_y = 2;
 
-				// max width of the labels
-				uint32_t maxLabelWidth = 0U;
-				for (const auto& it : vLabels)
-				{
-					maxLabelWidth = ct::maxi(maxLabelWidth, (uint32_t)it.first.size());
-				}
+				// the chars of the labels are rasterized only one time
+				CardLabelCache labelCache(&labelFontInfo, labelHeight, vGlyphHeight);
+				const float labelScale = labelCache.GetScale();
+				const int32_t labelBaseline = labelCache.GetBaseline();
 
-				maxLabelWidth *= labelHeight; // one mult instead of many in loops for same result
+				///////////////////////////////////////////////////
+				// LAYOUT PASS : no rasterization, only metrics ///
+				///////////////////////////////////////////////////
 
-				// extend max width of the buffer for column count
-				uint32_t maxWidthOfOneItem = glyphHeight + maxLabelWidth;
-
-				// array of bytes
-				std::vector<uint8_t> buffer;
-				uint32_t bufferWidth = maxWidthOfOneItem * columnCount;
-				uint32_t bufferHeight = vGlyphHeight * (vMaxRows + 2U);
-				buffer.resize((size_t)bufferWidth * (size_t)bufferHeight);
-				memset(buffer.data(), 0, buffer.size());
+				std::vector<CardItemLayoutStruct> items;
+				items.reserve(vLabels.size());
 
 				// iteration pof labels
 				int32_t xpos = padding_x;
@@ -244,91 +606,85 @@ bool Generator::WriteGlyphCardToPicture(
 					auto fontPtr = (FontInfos*)it.second.second;
 					if (fonts.find((size_t)fontPtr) == fonts.end())
 					{
-						stbtt_fontinfo fontInfos;
+						CardFontStruct cardFont;
 						// not exist so we will load the stbtt_fontinfo
 						if (!fontPtr->m_ImFontAtlas.ConfigData.empty())
 						{
 							const int32_t font_offset2 = stbtt_GetFontOffsetForIndex(
 								(unsigned char*)fontPtr->m_ImFontAtlas.ConfigData[0].FontData,
 								fontPtr->m_ImFontAtlas.ConfigData[0].FontNo);
-							if (stbtt_InitFont(&fontInfos, (unsigned char*)fontPtr->m_ImFontAtlas.ConfigData[0].FontData, font_offset2))
+							if (stbtt_InitFont(&cardFont.fontInfo, (unsigned char*)fontPtr->m_ImFontAtlas.ConfigData[0].FontData, font_offset2))
 							{
-								fonts[(size_t)fontPtr] = fontInfos;
+								cardFont.scale = stbtt_ScaleForPixelHeight(&cardFont.fontInfo, (float)(glyphHeight));
+								stbtt_GetFontVMetrics(&cardFont.fontInfo, &cardFont.ascent, &cardFont.descent, 0);
+								cardFont.baseline = (int32_t)(cardFont.ascent * cardFont.scale);
+								fonts[(size_t)fontPtr] = cardFont;
 							}
 						}
 					}
 
-					if (fonts.find((size_t)fontPtr) != fonts.end())
+					auto itFont = fonts.find((size_t)fontPtr);
+					if (itFont != fonts.end())
 					{
-						const auto& glyphFontInfos = fonts[(size_t)fontPtr];
+						const auto& cardFont = itFont->second;
 
-						std::string lblToRender = " " + it.first;
-						auto text = lblToRender.c_str();
+						CardItemLayoutStruct item;
+						item.glyphFontInfo = &cardFont.fontInfo;
+						item.codePoint = codePoint;
+						item.label = " " + it.first;
 
 						xpos = CurColumnOffset + padding_x;
 
 						// one char for the glyph
-						float glyphScale = stbtt_ScaleForPixelHeight(&glyphFontInfos, (float)(glyphHeight));
-						int32_t ascent, descent, baseline;
-						stbtt_GetFontVMetrics(&glyphFontInfos, &ascent, &descent, 0);
-						baseline = (int32_t)(ascent * glyphScale);
+						float glyphScale = cardFont.scale;
 						int32_t advance, lsb, x0, y0, x1, y1;
-						stbtt_GetCodepointHMetrics(&glyphFontInfos, codePoint, &advance, &lsb);
+						stbtt_GetCodepointHMetrics(&cardFont.fontInfo, codePoint, &advance, &lsb);
 						float x_shift = vGlyphHeight * 0.5f - (advance * glyphScale) * 0.5f;
-						float y_shift = vGlyphHeight * 0.5f - (ascent - descent) * glyphScale * 0.5f;
-						stbtt_GetCodepointBitmapBoxSubpixel(&glyphFontInfos, codePoint, glyphScale, glyphScale, x_shift, y_shift, &x0, &y0, &x1, &y1);
-						int32_t x = (uint32_t)xpos + x0;
-						int32_t y = baseline + y0;
+						float y_shift = vGlyphHeight * 0.5f - (cardFont.ascent - cardFont.descent) * glyphScale * 0.5f;
+						stbtt_GetCodepointBitmapBoxSubpixel(&cardFont.fontInfo, codePoint, glyphScale, glyphScale, x_shift, y_shift, &x0, &y0, &x1, &y1);
+						int32_t x = xpos + x0;
+						int32_t y = cardFont.baseline + y0;
 						while (x < 0 || y < 0) // we decrease scale until glyph can be added in picture
 						{
 							glyphScale *= 0.9f;
 							x_shift = vGlyphHeight * 0.5f - (advance * glyphScale) * 0.5f;
-							y_shift = vGlyphHeight * 0.5f - (ascent - descent) * glyphScale * 0.5f;
-							stbtt_GetCodepointBitmapBoxSubpixel(&glyphFontInfos, codePoint, glyphScale, glyphScale, x_shift, y_shift, &x0, &y0, &x1, &y1);
-							x = (uint32_t)xpos + x0;
-							y = baseline + y0;
-						}
-						if (x >= 0 && y >= 0)
-						{
-							uint8_t* ptr = buffer.data() + (size_t)(bufferWidth * ((size_t)ypos + (size_t)y) + (size_t)x);
-							stbtt_MakeCodepointBitmapSubpixel(&glyphFontInfos, ptr, x1 - x0, y1 - y0, bufferWidth, glyphScale, glyphScale, 0, 0, codePoint);
+							y_shift = vGlyphHeight * 0.5f - (cardFont.ascent - cardFont.descent) * glyphScale * 0.5f;
+							stbtt_GetCodepointBitmapBoxSubpixel(&cardFont.fontInfo, codePoint, glyphScale, glyphScale, x_shift, y_shift, &x0, &y0, &x1, &y1);
+							x = xpos + x0;
+							y = cardFont.baseline + y0;
 						}
+						item.glyphScale = glyphScale;
+						item.glyphX = x;
+						item.glyphY = ypos + y;
+						item.glyphW = x1 - x0;
+						item.glyphH = y1 - y0;
+						item.minY = item.glyphY;
+						item.maxY = item.glyphY + item.glyphH;
 						xpos += vGlyphHeight;
 
 						// the rest for the label
-						float labelScale = stbtt_ScaleForPixelHeight(&labelFontInfo, (float)(labelHeight));
-						stbtt_GetFontVMetrics(&labelFontInfo, &ascent, &descent, 0);
-						baseline = (int32_t)(ascent * labelScale);
+						item.labelX = xpos;
+						item.labelY = ypos + labelBaseline;
 
+						const auto text = item.label.c_str();
 						int32_t ch = 0;
 						while (text[ch])
 						{
-							stbtt_GetCodepointHMetrics(&labelFontInfo, text[ch], &advance, &lsb);
-							y_shift = vGlyphHeight * 0.5f - labelHeight * 0.5f;
-							stbtt_GetCodepointBitmapBoxSubpixel(&labelFontInfo, text[ch], labelScale, labelScale, 0, y_shift, &x0, &y0, &x1, &y1);
-
-							x = (uint32_t)xpos + x0;
-							y = baseline + y0;
-							float newLabelScale = labelScale;
-							while (x < 0 || y < 0) // we decrease scale until glyph can be added in picture
-							{
-								newLabelScale *= 0.9f;
-								stbtt_GetCodepointBitmapBoxSubpixel(&labelFontInfo, codePoint, newLabelScale, newLabelScale, 0, y_shift, &x0, &y0, &x1, &y1);
-								x = (uint32_t)xpos + x0;
-								y = baseline + y0;
-							}
-							if (x >= 0 && y >= 0)
+							const auto& labelChar = labelCache.GetChar((uint8_t)text[ch]);
+							if (!labelChar.bitmap.empty())
 							{
-								uint8_t* ptr = buffer.data() + (size_t)(bufferWidth * ((size_t)ypos + (size_t)y) + (size_t)x);
-								stbtt_MakeCodepointBitmapSubpixel(&labelFontInfo, ptr, x1 - x0, y1 - y0, bufferWidth, newLabelScale, newLabelScale, 0, 0, text[ch]);
+								item.minY = ct::mini(item.minY, item.labelY + labelChar.y0);
+								item.maxY = ct::maxi(item.maxY, item.labelY + labelChar.y0 + labelChar.h);
 							}
-
-							xpos += (int32_t)(advance * newLabelScale);
+							advance = labelChar.advance;
+							xpos += (int32_t)(advance * labelChar.scale);
 							if (text[ch + 1])
-								xpos += (int32_t)(labelScale * stbtt_GetCodepointKernAdvance(&labelFontInfo, text[ch], text[ch + 1]));
+								xpos += (int32_t)(labelScale * labelCache.GetKern((uint8_t)text[ch], (uint8_t)text[ch + 1]));
 							++ch;
 						}
 
+						items.push_back(item);
+
 						// inc of the row count
 						countRows++;
 
@@ -351,24 +707,178 @@ bool Generator::WriteGlyphCardToPicture(
 							columnMaxWidth = 0;
 						}
 					}
-
 				}
 
 				if (finalWidth && finalHeight)
 				{
-					int32_t success = stbi_write_png(
-						vFilePathName.c_str(),
-						finalWidth + padding_x,
-						finalHeight,
-						1,
-						buffer.data(),
-						bufferWidth);
+					///////////////////////////////////////////////////
+					// RENDER PASS ////////////////////////////////////
+					///////////////////////////////////////////////////
+
+					// the picture is rendered by horizontal bands on worker threads
+					// and the bands are streamed in order to the png writer
+					// so only a few bands are in memory at the same time
+
+					const int32_t pictureWidth = finalWidth + padding_x;
+					const int32_t pictureHeight = finalHeight;
+					const int32_t bandHeight = (int32_t)vGlyphHeight * 8;
+					const int32_t countBands = (pictureHeight + bandHeight - 1) / bandHeight;
+
+					// items per band (an item can overlap two bands)
+					std::vector<std::vector<size_t>> itemsPerBand((size_t)countBands);
+					for (size_t idx = 0; idx < items.size(); ++idx)
+					{
+						const auto& item = items[idx];
+						const int32_t firstBand = ct::maxi(0, item.minY / bandHeight);
+						const int32_t lastBand = ct::mini(countBands - 1, (item.maxY - 1) / bandHeight);
+						for (int32_t band = firstBand; band <= lastBand; ++band)
+							itemsPerBand[(size_t)band].push_back(idx);
+					}
+
+					auto renderBand = [&](const int32_t& vBandIdx, std::vector<uint8_t>& vBand)
+					{
+						const int32_t bandY = vBandIdx * bandHeight;
+						const int32_t height = ct::mini(bandHeight, pictureHeight - bandY);
+						vBand.assign((size_t)pictureWidth * (size_t)height, 0U);
+
+						std::vector<uint8_t> glyphBitmap;
+						for (const auto& idx : itemsPerBand[(size_t)vBandIdx])
+						{
+							const auto& item = items[idx];
+
+							// the glyph, each one is unique so not cached
+							if (item.glyphW > 0 && item.glyphH > 0)
+							{
+								glyphBitmap.assign((size_t)item.glyphW * (size_t)item.glyphH, 0U);
+								stbtt_MakeCodepointBitmapSubpixel(item.glyphFontInfo, glyphBitmap.data(), item.glyphW, item.glyphH, item.glyphW,
+									item.glyphScale, item.glyphScale, 0, 0, item.codePoint);
+								BlitCardBitmap(vBand, pictureWidth, bandY, height,
+									glyphBitmap.data(), item.glyphW, item.glyphH, item.glyphX, item.glyphY);
+							}
+
+							// the label, blitted from the cache (already filled by the layout pass, so read only here)
+							int32_t x = item.labelX;
+							const auto text = item.label.c_str();
+							int32_t ch = 0;
+							while (text[ch])
+							{
+								const auto& labelChar = labelCache.GetChar((uint8_t)text[ch]);
+								if (!labelChar.bitmap.empty())
+								{
+									BlitCardBitmap(vBand, pictureWidth, bandY, height,
+										labelChar.bitmap.data(), labelChar.w, labelChar.h,
+										x + labelChar.x0, item.labelY + labelChar.y0);
+								}
+								x += (int32_t)(labelChar.advance * labelChar.scale);
+								if (text[ch + 1])
+									x += (int32_t)(labelScale * labelCache.GetKern((uint8_t)text[ch], (uint8_t)text[ch + 1]));
+								++ch;
+							}
+						}
+					};
+
+					PngStreamWriter pngWriter;
+					bool success = pngWriter.Open(vFilePathName, (uint32_t)pictureWidth, (uint32_t)pictureHeight);
+					if (success)
+					{
+						const int32_t countThreads = ct::maxi(1, ct::mini((int32_t)std::thread::hardware_concurrency(), countBands));
+						const int32_t maxBandsInFlight = countThreads * 2;
+
+						std::mutex bandsMutex;
+						std::condition_variable bandsCondition;
+						std::map<int32_t, std::vector<uint8_t>> renderedBands; // band index, pixels
+						int32_t nextBandToRender = 0;
+						int32_t nextBandToWrite = 0;
+						bool abortRendering = false;
+
+						auto worker = [&]()
+						{
+							while (true)
+							{
+								int32_t bandIdx = 0;
+								{
+									std::unique_lock<std::mutex> lock(bandsMutex);
+									// wait until the writer have consumed enough bands, for limit the memory
+									bandsCondition.wait(lock, [&]() {
+										return abortRendering || nextBandToRender >= countBands ||
+											nextBandToRender < nextBandToWrite + maxBandsInFlight; });
+									if (abortRendering || nextBandToRender >= countBands)
+										break;
+									bandIdx = nextBandToRender++;
+								}
+
+								std::vector<uint8_t> band;
+								renderBand(bandIdx, band);
+
+								{
+									std::unique_lock<std::mutex> lock(bandsMutex);
+									renderedBands[bandIdx] = std::move(band);
+								}
+								bandsCondition.notify_all();
+							}
+						};
+
+						std::vector<std::thread> workers;
+						for (int32_t t = 0; t < countThreads; ++t)
+							workers.emplace_back(worker);
+
+						// stream the bands in order
+						bool cancelled = false;
+						while (nextBandToWrite < countBands)
+						{
+							if (CheckCancel()) // the workers stop after their current band
+							{
+								std::unique_lock<std::mutex> lock(bandsMutex);
+								abortRendering = true;
+								cancelled = true;
+								success = false;
+								break;
+							}
+
+							std::vector<uint8_t> band;
+							{
+								std::unique_lock<std::mutex> lock(bandsMutex);
+								bandsCondition.wait(lock, [&]() {
+									return renderedBands.find(nextBandToWrite) != renderedBands.end(); });
+								band = std::move(renderedBands[nextBandToWrite]);
+								renderedBands.erase(nextBandToWrite);
+							}
+
+							const uint32_t countRows = (uint32_t)(band.size() / (size_t)pictureWidth);
+							if (!pngWriter.WriteRows(band.data(), countRows, (size_t)pictureWidth))
+							{
+								std::unique_lock<std::mutex> lock(bandsMutex);
+								abortRendering = true;
+								success = false;
+							}
+
+							{
+								std::unique_lock<std::mutex> lock(bandsMutex);
+								nextBandToWrite++;
+								if (abortRendering)
+									nextBandToWrite = countBands;
+							}
+							bandsCondition.notify_all();
+
+							SetOutputProgress((float)nextBandToWrite / (float)countBands);
+						}
+						bandsCondition.notify_all(); // wake up the workers waiting a free slot, if cancelled
+
+						for (auto& thread : workers)
+							thread.join();
+
+						success &= pngWriter.Close();
+						if (cancelled)
+							FileHelper::Instance()->DestroyFile(vFilePathName); // not a partial picture
+						else
+							GenerationProfiler::Instance()->AddOutputFile(vFilePathName);
+					}
 
 					if (success)
 					{
 						res = true;
 					}
-					else
+					else if (!m_OutputAbandoned)
 					{
 						Messaging::Instance()->AddError(true, nullptr, nullptr,
 							"Png Writing Fail for path : %s", vFilePathName.c_str());
@@ -504,7 +1014,7 @@ bool Generator::GenerateCard_Merged(
 					{
 						if (glyph.second)
 						{
-							glyphs[GetNewHeaderName(prefix, glyph.second->newHeaderName)] = std::pair<uint32_t, size_t>(glyph.first, (size_t)&font.second);
+							glyphs[GetNewHeaderName(prefix, glyph.second->newHeaderName)] = std::pair<uint32_t, size_t>(glyph.first, (size_t)font.second.get());
 						}
 					}
 				}
@@ -569,8 +1079,7 @@ bool Generator::GenerateFontFile_One(
 
 		if (!newHeaderNames.empty() && !newCodePoints.empty())
 		{
-			std::string absPath = ProjectFile::Instance()->GetAbsolutePath(vFontInfos->m_FontFilePathName);
-			if (!fontGenerator.OpenFontFile(absPath, newHeaderNames, newCodePoints, newGlyphInfos, true))
+			if (!fontGenerator.OpenFontFile(vFontInfos, newHeaderNames, newCodePoints, newGlyphInfos, true))
 			{
 				Messaging::Instance()->AddError(true, nullptr, nullptr,
 					"Could not open font file %s.\n",
@@ -607,7 +1116,7 @@ bool Generator::GenerateFontFile_One(
 		{
 			if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_CURRENT))
 			{
-				vFontInfos->m_GeneratedFileName = ps.name;
+				m_GeneratedFileNames.emplace_back(vFontInfos, ps.name); // set by FinishGeneration
 			}
 
 			std::string name = ps.name;
@@ -633,7 +1142,8 @@ bool Generator::GenerateFontFile_One(
 			}
 			else
 			{
-				Messaging::Instance()->AddError(true, nullptr, nullptr, "Cannot create font file %s", filePathName.c_str());
+				if (!m_OutputAbandoned) // cancelled, not an error
+					Messaging::Instance()->AddError(true, nullptr, nullptr, "Cannot create font file %s", filePathName.c_str());
 				return false;
 			}
 		}
@@ -728,8 +1238,7 @@ bool Generator::GenerateFontFile_Merged(
 
 				if (!newHeaderNames.empty())
 				{
-					std::string absPath = ProjectFile::Instance()->GetAbsolutePath(it.second->m_FontFilePathName);
-					tasks &= fontGenerator.OpenFontFile(absPath, newHeaderNames, newCodePoints, newGlyphInfos, !scaleChanged);
+					tasks &= fontGenerator.OpenFontFile(it.second, newHeaderNames, newCodePoints, newGlyphInfos, !scaleChanged);
 				}
 				else
 				{
@@ -781,7 +1290,8 @@ bool Generator::GenerateFontFile_Merged(
 				}
 				else
 				{
-					Messaging::Instance()->AddError(true, nullptr, nullptr, "Cannot create font file %s", filePathName.c_str());
+					if (!m_OutputAbandoned) // cancelled, not an error
+						Messaging::Instance()->AddError(true, nullptr, nullptr, "Cannot create font file %s", filePathName.c_str());
 					return res;
 				}
 			}
@@ -845,13 +1355,15 @@ bool Generator::GenerateSource_One(
 
 				GenerateFontFile_One(filePathName, vFontInfos,
 					(GenModeFlags)(vFlags & ~GENERATOR_MODE_HEADER_CARD)); // no header or card to generate
+				if (m_OutputAbandoned) // cancelled, the temporary font file is not written
+					return false;
 			}
 
 			if (FileHelper::Instance()->IsFileExist(filePathName))
 			{
 				if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_CURRENT))
 				{
-					vFontInfos->m_GeneratedFileName = ps.name;
+					m_GeneratedFileNames.emplace_back(vFontInfos, ps.name); // set by FinishGeneration
 				}
 
 				std::string lang;
@@ -873,6 +1385,7 @@ bool Generator::GenerateSource_One(
 					{
 						// we have the result, if empty or not we need to destroy the temporary font file
 						FileHelper::Instance()->DestroyFile(filePathName);
+						GenerationProfiler::Instance()->RemoveOutputFile(filePathName);
 					}
 
 					// if ok, serialization
@@ -940,6 +1453,7 @@ bool Generator::GenerateSource_One(
 
 						filePathName = psSource.GetFPNE_WithExt(sourceExt);
 						FileHelper::Instance()->SaveStringToFile(sourceFile, filePathName);
+						GenerationProfiler::Instance()->AddOutputFile(filePathName);
 						if (vFlags & GENERATOR_MODE_OPEN_GENERATED_FILES_AUTO)
 							FileHelper::Instance()->OpenFile(filePathName);
 
@@ -993,6 +1507,8 @@ bool Generator::GenerateSource_Merged(
 			GenerateFontFile_Merged(
 				filePathName,
 				(GenModeFlags)(vFlags & ~GENERATOR_MODE_HEADER_CARD)); // no header to generate
+			if (m_OutputAbandoned) // cancelled, the temporary font file is not written
+				return false;
 
 			if (FileHelper::Instance()->IsFileExist(filePathName))
 			{
@@ -1013,6 +1529,7 @@ bool Generator::GenerateSource_Merged(
 
 					// we have the result, if empty or not we need to destroy the temporary font file
 					FileHelper::Instance()->DestroyFile(filePathName);
+					GenerationProfiler::Instance()->RemoveOutputFile(filePathName);
 
 					// if ok, serialization
 					if (!buffer.empty() && !bufferName.empty() && bufferSize > 0)
@@ -1079,6 +1596,7 @@ bool Generator::GenerateSource_Merged(
 
 						filePathName = psSource.GetFPNE_WithExt(sourceExt);
 						FileHelper::Instance()->SaveStringToFile(sourceFile, filePathName);
+						GenerationProfiler::Instance()->AddOutputFile(filePathName);
 						if (vFlags & GENERATOR_MODE_OPEN_GENERATED_FILES_AUTO)
 							FileHelper::Instance()->OpenFile(filePathName);
 						res = true;
@@ -1105,3 +1623,197 @@ bool Generator::GenerateSource_Merged(
 
 	return res;
 }
+
+///////////////////////////////////////////////////////////////////////////////////
+//// ATLAS GENERATION /////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// write name.ifsa, name_Atlas.h and the loader ImGuiPrebakedAtlas.h
+static bool WritePrebakedAtlas(const std::string& vFilePathName, const std::string& vPrefix, const PrebakedAtlasStruct& vAtlas)
+{
+	bool res = false;
+
+	auto ps = FileHelper::Instance()->ParsePathFileName(vFilePathName);
+	if (ps.isOk)
+	{
+		res = AtlasGenerator::WriteBinary(ps.GetFPNE_WithExt(PREBAKED_ATLAS_FILE_EXT), vAtlas);
+		res &= AtlasGenerator::WriteSource(ps.GetFPNE_WithNameExt(ps.name + "_Atlas", "h"), vPrefix, vAtlas);
+		res &= AtlasGenerator::WriteLoader(ps.path);
+	}
+
+	return res;
+}
+
+// write name_Sdf.ifsa or name_Msdf.ifsa (and _Atlas.h) next to the alpha atlas
+static bool WriteDistanceFieldAtlas(const std::string& vFilePathName, const std::string& vPrefix,
+	const std::vector<std::shared_ptr<FontInfos>>& vFonts, const GenModeFlags& vFlags)
+{
+	bool res = false;
+
+	auto ps = FileHelper::Instance()->ParsePathFileName(vFilePathName);
+	if (ps.isOk)
+	{
+		const bool msdf = (vFlags & GENERATOR_MODE_ATLAS_SETTINGS_MSDF);
+		const auto format = msdf ?
+			PrebakedAtlasFormatEnum::PREBAKED_ATLAS_FORMAT_MSDF :
+			PrebakedAtlasFormatEnum::PREBAKED_ATLAS_FORMAT_SDF;
+		const std::string suffix = msdf ? "_Msdf" : "_Sdf";
+		const std::string filePathName = ps.GetFPNE_WithNameExt(ps.name + suffix, PREBAKED_ATLAS_FILE_EXT);
+
+		PrebakedAtlasStruct atlas;
+		if (SdfGenerator::BakeAtlas(vFonts, format,
+			ProjectFile::Instance()->m_AtlasSdfGlyphSizeInPixel,
+			ProjectFile::Instance()->m_AtlasSdfPxRange, &atlas))
+		{
+			res = WritePrebakedAtlas(filePathName, vPrefix + suffix, atlas);
+		}
+
+		if (!res)
+		{
+			if (!Generator::Instance()->CheckCancel()) // cancelled, not an error
+				Messaging::Instance()->AddError(true, nullptr, nullptr, "Cannot create distance field atlas file %s", filePathName.c_str());
+		}
+	}
+
+	return res;
+}
+
+bool Generator::GenerateAtlas_One(
+	const std::string& vFilePathName,
+	std::shared_ptr<FontInfos> vFontInfos,
+	const GenModeFlags& vFlags)
+{
+	bool res = false;
+
+	if (!vFilePathName.empty() && vFontInfos.use_count())
+	{
+		if (vFontInfos->m_SelectedGlyphs.empty())
+		{
+			Messaging::Instance()->AddError(true, nullptr, nullptr,
+				"No glyphs are seleted for font file %s. aborting.\n",
+				vFontInfos->m_FontFilePathName.c_str());
+			return false;
+		}
+
+		auto ps = FileHelper::Instance()->ParsePathFileName(vFilePathName);
+		if (ps.isOk)
+		{
+			if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_CURRENT))
+			{
+				m_GeneratedFileNames.emplace_back(vFontInfos, ps.name); // set by FinishGeneration
+			}
+
+			std::string name = ps.name;
+			ct::replaceString(name, "-", "_");
+			const std::string filePathName = ps.GetFPNE_WithNameExt(name, PREBAKED_ATLAS_FILE_EXT);
+
+			PrebakedAtlasStruct atlas;
+			if (AtlasGenerator::BakeAtlas({ vFontInfos }, &atlas) &&
+				WritePrebakedAtlas(filePathName, vFontInfos->m_FontPrefix, atlas))
+			{
+				res = true;
+
+				if (vFlags & GENERATOR_MODE_RADIO_ATLAS_DISTANCE_FIELD)
+				{
+					res &= WriteDistanceFieldAtlas(filePathName, vFontInfos->m_FontPrefix, { vFontInfos }, vFlags);
+				}
+
+				if (vFlags & GENERATOR_MODE_HEADER)
+				{
+					m_HeaderGenerator.GenerateHeader_One(
+						filePathName,
+						vFontInfos);
+				}
+				if (vFlags & GENERATOR_MODE_CARD)
+				{
+					GenerateCard_One(
+						filePathName,
+						vFontInfos);
+				}
+			}
+			else
+			{
+				if (!m_OutputAbandoned) // cancelled, not an error
+					Messaging::Instance()->AddError(true, nullptr, nullptr, "Cannot create atlas file %s", filePathName.c_str());
+				return false;
+			}
+		}
+		else
+		{
+			Messaging::Instance()->AddError(true, nullptr, nullptr, "File Path Name is wrong : %s", vFilePathName.c_str());
+			return false;
+		}
+	}
+
+	return res;
+}
+
+bool Generator::GenerateAtlas_Merged(
+	const std::string& vFilePathName,
+	const GenModeFlags& vFlags)
+{
+	bool res = false;
+
+	if (ProjectFile::Instance()->IsLoaded() &&
+		!vFilePathName.empty() &&
+		!ProjectFile::Instance()->m_Fonts.empty() &&
+		!ProjectFile::Instance()->m_FontToMergeIn.empty())
+	{
+		// the font to merge in give the metrics, so is the first
+		std::vector<std::shared_ptr<FontInfos>> fonts;
+		for (auto it : ProjectFile::Instance()->m_Fonts)
+		{
+			if (it.second)
+			{
+				if (ProjectFile::Instance()->m_FontToMergeIn == it.second->m_FontFileName)
+					fonts.insert(fonts.begin(), it.second);
+				else
+					fonts.push_back(it.second);
+			}
+		}
+
+		auto ps = FileHelper::Instance()->ParsePathFileName(vFilePathName);
+		if (ps.isOk)
+		{
+			std::string name = ps.name;
+			ct::replaceString(name, "-", "_");
+			const std::string filePathName = ps.GetFPNE_WithNameExt(name, PREBAKED_ATLAS_FILE_EXT);
+
+			PrebakedAtlasStruct atlas;
+			if (AtlasGenerator::BakeAtlas(fonts, &atlas) &&
+				WritePrebakedAtlas(filePathName, ProjectFile::Instance()->m_MergedFontPrefix, atlas))
+			{
+				res = true;
+
+				if (vFlags & GENERATOR_MODE_RADIO_ATLAS_DISTANCE_FIELD)
+				{
+					res &= WriteDistanceFieldAtlas(filePathName, ProjectFile::Instance()->m_MergedFontPrefix, fonts, vFlags);
+				}
+
+				if (vFlags & GENERATOR_MODE_HEADER)
+				{
+					m_HeaderGenerator.GenerateHeader_Merged(
+						filePathName);
+				}
+				if (vFlags & GENERATOR_MODE_CARD)
+				{
+					GenerateCard_Merged(
+						filePathName);
+				}
+			}
+			else
+			{
+				if (!m_OutputAbandoned) // cancelled, not an error
+					Messaging::Instance()->AddError(true, nullptr, nullptr, "Cannot create atlas file %s", filePathName.c_str());
+				return false;
+			}
+		}
+		else
+		{
+			Messaging::Instance()->AddError(true, nullptr, nullptr, "File Path Name is wrong : %s", vFilePathName.c_str());
+			return false;
+		}
+	}
+
+	return res;
+}
@@ -22,28 +22,73 @@
 
 #include <stdint.h>
 #include <string>
+#include <functional>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <atomic>
 
 #include <Generator/GenMode.h>
+#include <Generator/GenerationCache.h>
 
 class FontInfos;
 class ProjectFile;
+class TaskContext;
 class Generator
 {
 public:
-	static bool WriteGlyphCardToPicture(
+	bool WriteGlyphCardToPicture(
 		const std::string& vFilePathName,
 		std::map<std::string, std::pair<uint32_t, size_t>> vLabels, // lable, codepoint, FontInfos ptr
 		const uint32_t& vGlyphHeight, const uint32_t& vMaxRows);
 
 private:
 	HeaderGenerator m_HeaderGenerator;
+	GenerationCache m_GenerationCache;
+	TaskContext* m_Task = nullptr; // task of the current generation, if done in a worker
+	std::atomic<bool> m_OutputAbandoned{ false }; // the current output was stopped by a cancel (see CheckCancel)
+	bool m_GenerationCancelled = false; // some outputs of the last generation was abandoned
+	float m_OutputProgressStart = 0.0f; // part of the task progress for the current output
+	float m_OutputProgressEnd = 1.0f;
+	std::vector<std::string> m_FontFilesToOpen; // debug, opened in the main thread at the end of the generation
+	std::vector<std::pair<std::shared_ptr<FontInfos>, std::string>> m_GeneratedFileNames; // set in the main thread at the end of the generation
+	std::vector<uint8_t> m_LabelFontDatas; // copy of the imgui font, for the card labels
+	int32_t m_LabelFontNo = 0;
 
 public:
+	// main thread, load the fonts deferred at project open (the textures need the gl context)
+	// and resolve what the generation need from the project and imgui (sfntly fonts, label font)
+	// so the generation in a worker only read the fonts, and write no project or imgui state
+	void PrepareGeneration();
+	// from the main thread, or from a worker with his task (see GeneratorPane) but after PrepareGeneration
+	// the task is checked for cancel between the outputs and in the long steps of an output, and get the progress
 	bool Generate(
 		const std::string& vFilePath = "",
-		const std::string& vFileName = "");
+		const std::string& vFileName = "",
+		TaskContext* vTask = nullptr);
+	// main thread, after a generation done in a worker. set the project state changed by the generation
+	void FinishGeneration();
+	// true if the last generation was cancelled before the end of some outputs
+	// false if all the outputs was written, even if the cancel was requested at the end
+	bool IsGenerationCancelled() const { return m_GenerationCancelled; }
+
+public: // for the long steps of an output (font assembly, card bands, atlas baking), from the generation thread
+	// true if the generation is cancelled, the current output is then abandoned
+	// so the step must stop and return false, without error message
+	bool CheckCancel();
+	// progress [0:1] of the current output
+	void SetOutputProgress(const float& vProgress);
 
 private:
+	static std::string GetMainOutputFilePathName(const std::string& vFilePathName,
+		const GenModeFlags& vFlags, const bool& vMerged);
+	bool GenerateIfChanged(const std::string& vOutputFilePathName,
+		const std::string& vFontName, const size_t& vCountGlyphs, // for the generation summary
+		const std::function<uint64_t()>& vKeyFunc, const std::function<bool()>& vGenerateFunc);
+	bool IsCancelRequested() const;
+	// the current output will be reported in [vStart:vEnd] of the task progress
+	void BeginOutputProgress(const float& vStart, const float& vEnd, const std::string& vMsg);
+
 	bool GenerateCard_One(const std::string& vFilePathName, std::shared_ptr<FontInfos> vFontInfos);
 	bool GenerateCard_Merged(const std::string& vFilePathName);
 	
@@ -62,6 +107,11 @@ private:
 	bool GenerateSource_Merged(const std::string& vFilePathName,
 		const GenModeFlags& vFlags);
 
+	bool GenerateAtlas_One(const std::string& vFilePathName,
+		std::shared_ptr<FontInfos> vFontInfos, const GenModeFlags& vFlags);
+	bool GenerateAtlas_Merged(const std::string& vFilePathName,
+		const GenModeFlags& vFlags);
+
 public: // singleton
 	static Generator *Instance()
 	{
@@ -0,0 +1,496 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GeneratorBenchmark.h"
+
+#include <cstdio>
+#include <cstring>
+#include <chrono>
+#include <fstream>
+#include <algorithm>
+#include <cctype>
+
+#include <dirent.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#ifdef MSVC
+#pragma comment(lib, "psapi.lib")
+#endif
+#else
+#include <sys/resource.h>
+#endif
+
+#include <ctools/cTools.h>
+#include <ctools/FileHelper.h>
+#include <Generator/Generator.h>
+#include <Project/FontInfos.h>
+#include <Project/GlyphInfos.h>
+#include <Project/ProjectFile.h>
+
+#define BENCHMARK_PROJECT_FILE_NAME "benchmark.ifs"
+#define BENCHMARK_CSV_FILE_NAME "benchmark.csv"
+
+///////////////////////////////////////////////////////////////////////////////////
+//// STATIC ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+bool GeneratorBenchmark::IsBenchmarkAsked(int argc, char** argv)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		if (argv[i] && strcmp(argv[i], "--benchmark") == 0)
+			return true;
+	}
+	return false;
+}
+
+bool GeneratorBenchmark::ParseArgs(int argc, char** argv, GeneratorBenchmarkParams* vParams)
+{
+	if (!vParams)
+		return false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		const bool haveValue = (i + 1 < argc);
+
+		if (arg == "--benchmark")
+		{
+			continue;
+		}
+		else if (arg == "--fonts" && haveValue)
+		{
+			vParams->fontsPath = argv[++i];
+		}
+		else if (arg == "--output" && haveValue)
+		{
+			vParams->outputPath = argv[++i];
+		}
+		else if (arg == "--selections" && haveValue)
+		{
+			vParams->selectionSizes.clear();
+			for (const auto& size : ct::splitStringToVector(std::string(argv[++i]), ","))
+			{
+				vParams->selectionSizes.push_back((size_t)ct::uvariant(size).GetU());
+			}
+		}
+		else if (arg == "--copies" && haveValue)
+		{
+			vParams->countSyntheticCopies = ct::uvariant(argv[++i]).GetU();
+		}
+		else if (arg == "--iterations" && haveValue)
+		{
+			vParams->countIterations = ct::maxi(1U, ct::uvariant(argv[++i]).GetU());
+		}
+		else
+		{
+			printf("Benchmark : unknown or incomplete arg %s\n", arg.c_str());
+			printf("usage : --benchmark [--fonts <dir>] [--output <dir>] [--selections 16,256,0] [--copies 8] [--iterations 3]\n");
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// reset the peak of the resident memory to the current resident memory
+// so the next peak is the one of a scenario. linux only (clear_refs), return false if not possible
+bool GeneratorBenchmark::ResetPeakMemory()
+{
+#if !defined(_WIN32) && !defined(APPLE)
+	FILE* f = fopen("/proc/self/clear_refs", "w");
+	if (f)
+	{
+		bool res = (fputs("5", f) >= 0);
+		res &= (fclose(f) == 0);
+		return res;
+	}
+#endif
+	return false;
+}
+
+// peak of the resident memory of the process, since his start or since the last ResetPeakMemory
+size_t GeneratorBenchmark::GetPeakMemoryInBytes()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+		return (size_t)pmc.PeakWorkingSetSize;
+#else
+#ifndef APPLE
+	// VmHWM is reset by ResetPeakMemory, not ru_maxrss
+	FILE* f = fopen("/proc/self/status", "r");
+	if (f)
+	{
+		size_t peakInKb = 0U;
+		char line[256];
+		while (fgets(line, sizeof(line), f))
+		{
+			unsigned long value = 0U;
+			if (sscanf(line, "VmHWM: %lu kB", &value) == 1)
+			{
+				peakInKb = (size_t)value;
+				break;
+			}
+		}
+		fclose(f);
+		if (peakInKb)
+			return peakInKb * 1024U;
+	}
+#endif
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0)
+	{
+#ifdef APPLE
+		return (size_t)usage.ru_maxrss; // in bytes on macos
+#else
+		return (size_t)usage.ru_maxrss * 1024U; // in kilobytes on linux
+#endif
+	}
+#endif
+	return 0U;
+}
+
+std::vector<std::string> GeneratorBenchmark::ListFontFiles(const std::string& vPath)
+{
+	std::vector<std::string> res;
+
+	DIR* dir = opendir(vPath.c_str());
+	if (dir)
+	{
+		struct dirent* ent = nullptr;
+		while ((ent = readdir(dir)) != nullptr)
+		{
+			const std::string fileName = ent->d_name;
+			const size_t dot = fileName.find_last_of('.');
+			if (dot != std::string::npos && dot > 0U)
+			{
+				std::string ext = fileName.substr(dot + 1U);
+				std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+				if (ext == "ttf" || ext == "otf")
+					res.push_back(fileName);
+			}
+		}
+		closedir(dir);
+	}
+
+	std::sort(res.begin(), res.end()); // same order on each run
+
+	return res;
+}
+
+bool GeneratorBenchmark::CopyFontFile(const std::string& vSrcFilePathName, const std::string& vDstFilePathName)
+{
+	std::ifstream src(vSrcFilePathName, std::ios::binary);
+	std::ofstream dst(vDstFilePathName, std::ios::binary);
+	if (src.is_open() && dst.is_open())
+	{
+		dst << src.rdbuf();
+		return dst.good();
+	}
+	return false;
+}
+
+std::shared_ptr<FontInfos> GeneratorBenchmark::LoadFont(const std::string& vFontFileName)
+{
+	auto font = FontInfos::Create();
+	if (font->LoadFont(vFontFileName)) // relative to the project path
+	{
+		ProjectFile::Instance()->m_Fonts[font->m_FontFileName] = font;
+		return font;
+	}
+
+	printf("Benchmark : fail to load font %s\n", vFontFileName.c_str());
+	return nullptr;
+}
+
+// select the vCountGlyphs first glyphs of the font (0 => all glyphs)
+// if vNextCodePoint is set, the glyphs are remapped from it, for merge many copies of a font without collisions
+size_t GeneratorBenchmark::SelectGlyphs(std::shared_ptr<FontInfos> vFontInfos,
+	const size_t& vCountGlyphs, uint32_t* vNextCodePoint, const std::string& vNameSuffix)
+{
+	if (!vFontInfos)
+		return 0U;
+
+	vFontInfos->m_SelectedGlyphs.clear();
+
+	ImFont* font = vFontInfos->GetImFont();
+	if (font)
+	{
+		for (const auto& glyph : font->Glyphs)
+		{
+			if (vCountGlyphs && vFontInfos->m_SelectedGlyphs.size() >= vCountGlyphs)
+				break;
+
+			if (vFontInfos->m_SelectedGlyphs.find(glyph.Codepoint) == vFontInfos->m_SelectedGlyphs.end()) // not found
+			{
+				uint32_t newCodePoint = glyph.Codepoint;
+				if (vNextCodePoint)
+				{
+					if (*vNextCodePoint >= 0xD800 && *vNextCodePoint <= 0xDFFF) // surrogates
+						*vNextCodePoint = 0xE000;
+					if (*vNextCodePoint > 0xFFFD) // the generated cmap is a format 4, so only the BMP
+						break;
+					newCodePoint = (*vNextCodePoint)++;
+				}
+
+				const std::string name = vFontInfos->GetGlyphName(glyph.Codepoint) + vNameSuffix;
+				vFontInfos->m_SelectedGlyphs[glyph.Codepoint] = GlyphInfos::Create(vFontInfos, glyph, name, name, newCodePoint);
+			}
+		}
+	}
+
+	return vFontInfos->m_SelectedGlyphs.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PUBLIC ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+GeneratorBenchmark::GeneratorBenchmark(const GeneratorBenchmarkParams& vParams)
+	: m_Params(vParams)
+{
+
+}
+
+int GeneratorBenchmark::Run()
+{
+#ifdef _DEBUG
+	printf("Benchmark : WARNING, debug build, the timings are not representative\n");
+#endif
+
+	std::vector<std::string> fontFileNames;
+	if (!PrepareWorkspace(&fontFileNames))
+		return 1;
+
+	GenerationProfiler::Instance()->SetEnabled(true);
+
+	const GenModeFlags fontFlags = GENERATOR_MODE_CURRENT_FONT | GENERATOR_MODE_HEADER_CARD |
+		GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES | GENERATOR_MODE_LANG_CPP;
+	const GenModeFlags srcFlags = GENERATOR_MODE_CURRENT_SRC_HEADER | GENERATOR_MODE_LANG_CPP;
+
+	// font by font
+	for (const auto& fontFileName : fontFileNames)
+	{
+		ProjectFile::Instance()->New(m_Params.outputPath + "/" + BENCHMARK_PROJECT_FILE_NAME);
+
+		auto font = LoadFont(fontFileName);
+		if (font)
+		{
+			ProjectFile::Instance()->m_SelectedFont = font;
+			ProjectFile::Instance()->m_FontToMergeIn = font->m_FontFileName;
+
+			auto ps = FileHelper::Instance()->ParsePathFileName(fontFileName);
+			for (const auto& selectionSize : m_Params.selectionSizes)
+			{
+				const size_t countGlyphs = SelectGlyphs(font, selectionSize, nullptr, "");
+				ProjectFile::Instance()->UpdateCountSelectedGlyphs();
+
+				const std::string name = ps.name + ct::toStr("_%u", (uint32_t)countGlyphs);
+				RunScenario(name + " font+header+card", countGlyphs, fontFlags, "gen_" + name + ".ttf");
+				RunScenario(name + " src+header", countGlyphs, srcFlags, "gen_" + name + ".cpp");
+			}
+		}
+	}
+
+	// synthetic large font, all the fonts copied and merged
+	if (m_Params.countSyntheticCopies && !fontFileNames.empty())
+	{
+		ProjectFile::Instance()->New(m_Params.outputPath + "/" + BENCHMARK_PROJECT_FILE_NAME);
+
+		size_t countGlyphs = 0U;
+		uint32_t nextCodePoint = 0x100;
+		for (uint32_t copy = 0U; copy < m_Params.countSyntheticCopies; ++copy)
+		{
+			for (const auto& fontFileName : fontFileNames)
+			{
+				const std::string copyFileName = ct::toStr("synthetic_%u_", copy) + fontFileName;
+				if (CopyFontFile(m_Params.outputPath + "/" + fontFileName, m_Params.outputPath + "/" + copyFileName))
+				{
+					auto font = LoadFont(copyFileName);
+					if (font)
+					{
+						if (ProjectFile::Instance()->m_FontToMergeIn.empty())
+						{
+							ProjectFile::Instance()->m_FontToMergeIn = font->m_FontFileName;
+							ProjectFile::Instance()->m_SelectedFont = font;
+						}
+						countGlyphs += SelectGlyphs(font, 0U, &nextCodePoint, ct::toStr("_%u", copy));
+					}
+				}
+			}
+		}
+		ProjectFile::Instance()->m_MergedFontPrefix = "SYN";
+		ProjectFile::Instance()->UpdateCountSelectedGlyphs();
+
+		const std::string name = ct::toStr("synthetic_%u", (uint32_t)countGlyphs);
+		RunScenario(name + " merged font+header+card", countGlyphs,
+			(GenModeFlags)((fontFlags & ~GENERATOR_MODE_CURRENT) | GENERATOR_MODE_MERGED), "gen_" + name + ".ttf");
+		RunScenario(name + " merged src+header", countGlyphs,
+			(GenModeFlags)((srcFlags & ~GENERATOR_MODE_CURRENT) | GENERATOR_MODE_MERGED), "gen_" + name + ".cpp");
+	}
+
+	GenerationProfiler::Instance()->SetEnabled(false);
+	ProjectFile::Instance()->Clear();
+
+	printf("%s", GetReport().c_str());
+
+	const std::string csvFilePathName = m_Params.outputPath + "/" + BENCHMARK_CSV_FILE_NAME;
+	FileHelper::Instance()->SaveStringToFile(GetCsvReport(), csvFilePathName);
+	printf("Benchmark : csv report written in %s\n", csvFilePathName.c_str());
+
+	for (const auto& scenario : m_Scenarios)
+	{
+		if (!scenario.success)
+			return 1;
+	}
+
+	return m_Scenarios.empty() ? 1 : 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PRIVATE //////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// the fonts are copied in the output dir, who is also the project path
+// so all the files are relative to the project, like in a normal project
+bool GeneratorBenchmark::PrepareWorkspace(std::vector<std::string>* vFontFileNames)
+{
+	if (!vFontFileNames)
+		return false;
+
+	FileHelper::Instance()->CreateDirectoryIfNotExist(m_Params.outputPath);
+
+	for (const auto& fontFileName : ListFontFiles(m_Params.fontsPath))
+	{
+		if (CopyFontFile(m_Params.fontsPath + "/" + fontFileName, m_Params.outputPath + "/" + fontFileName))
+			vFontFileNames->push_back(fontFileName);
+		else
+			printf("Benchmark : fail to copy font %s in %s\n", fontFileName.c_str(), m_Params.outputPath.c_str());
+	}
+
+	if (vFontFileNames->empty())
+	{
+		printf("Benchmark : no font file found in %s\n", m_Params.fontsPath.c_str());
+		return false;
+	}
+
+	printf("Benchmark : %u fonts, %u iterations per scenario\n",
+		(uint32_t)vFontFileNames->size(), m_Params.countIterations);
+
+	return true;
+}
+
+void GeneratorBenchmark::RunScenario(const std::string& vName, const size_t& vCountGlyphs,
+	const GenModeFlags& vFlags, const std::string& vFileName)
+{
+	GeneratorBenchmarkScenarioStruct scenario;
+	scenario.name = vName;
+	scenario.countGlyphs = vCountGlyphs;
+
+	// the output is always generated, even if unchanged since the last iteration
+	const GenModeFlags flags = (GenModeFlags)(vFlags & ~(GENERATOR_MODE_SKIP_UNCHANGED_OUTPUTS | GENERATOR_MODE_OPEN_GENERATED_FILES_AUTO));
+	ProjectFile::Instance()->m_GenModeFlags = flags;
+	for (auto& font : ProjectFile::Instance()->m_Fonts)
+	{
+		if (font.second)
+			font.second->m_GenModeFlags = flags;
+	}
+
+	GenerationProfiler::Instance()->Reset();
+
+	// else the peak of the process, so the one of the biggest scenario done before
+	scenario.peakMemoryOfScenario = ResetPeakMemory();
+
+	const auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0U; i < m_Params.countIterations; ++i)
+	{
+		scenario.success &= Generator::Instance()->Generate(m_Params.outputPath, vFileName);
+	}
+	const double elapsedInMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	scenario.totalTimeInMs = elapsedInMs / (double)m_Params.countIterations;
+	scenario.peakMemoryInBytes = GetPeakMemoryInBytes();
+	scenario.stages = GenerationProfiler::Instance()->GetStages();
+
+	printf("Benchmark : %-48s %8.2f ms %s\n", vName.c_str(), scenario.totalTimeInMs, scenario.success ? "" : "FAILED");
+
+	m_Scenarios.push_back(scenario);
+}
+
+std::string GeneratorBenchmark::GetReport() const
+{
+	std::string res;
+
+	for (const auto& scenario : m_Scenarios)
+	{
+		res += ct::toStr("\n%s (%u glyphs)%s\n", scenario.name.c_str(), (uint32_t)scenario.countGlyphs,
+			scenario.success ? "" : " FAILED");
+		res += ct::toStr("\t%-48s %8s %12s %12s %12s\n", "stage", "calls", "ms/iter", "avg ms", "max ms");
+		for (const auto& stage : scenario.stages)
+		{
+			res += ct::toStr("\t%-48s %8u %12.3f %12.3f %12.3f\n",
+				stage.name.c_str(),
+				(uint32_t)(stage.countCalls / m_Params.countIterations),
+				stage.totalTimeInMs / (double)m_Params.countIterations,
+				stage.GetAverageTimeInMs(),
+				stage.maxTimeInMs);
+		}
+		res += ct::toStr("\t%-48s %8s %12.3f\n", "total", "", scenario.totalTimeInMs);
+		res += ct::toStr("\t%-48s %8s %12.3f\n",
+			scenario.peakMemoryOfScenario ? "peak memory (MB)" : "process peak memory (MB)", "",
+			(double)scenario.peakMemoryInBytes / (1024.0 * 1024.0));
+	}
+
+	return res;
+}
+
+// one line per stage, for compare two runs in a spreadsheet
+std::string GeneratorBenchmark::GetCsvReport() const
+{
+	// the peak is per scenario if it can be reset, else this is the cumulative peak of the process
+	bool peakMemoryOfScenarios = !m_Scenarios.empty();
+	for (const auto& scenario : m_Scenarios)
+		peakMemoryOfScenarios &= scenario.peakMemoryOfScenario;
+
+	std::string res = "scenario;glyphs;success;stage;calls;ms_per_iteration;avg_ms;max_ms;scenario_ms;";
+	res += peakMemoryOfScenarios ? "peak_memory_mb\n" : "process_peak_memory_mb\n";
+
+	for (const auto& scenario : m_Scenarios)
+	{
+		for (const auto& stage : scenario.stages)
+		{
+			res += ct::toStr("%s;%u;%u;%s;%u;%.3f;%.3f;%.3f;%.3f;%.3f\n",
+				scenario.name.c_str(),
+				(uint32_t)scenario.countGlyphs,
+				scenario.success ? 1U : 0U,
+				stage.name.c_str(),
+				(uint32_t)(stage.countCalls / m_Params.countIterations),
+				stage.totalTimeInMs / (double)m_Params.countIterations,
+				stage.GetAverageTimeInMs(),
+				stage.maxTimeInMs,
+				scenario.totalTimeInMs,
+				(double)scenario.peakMemoryInBytes / (1024.0 * 1024.0));
+		}
+	}
+
+	return res;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <Generator/GenMode.h>
+#include <Generator/GenerationProfiler.h>
+
+// benchmark of the generation pipeline, run from the command line :
+// ImGuiFontStudio --benchmark [--fonts <dir>] [--output <dir>] [--selections 16,256,0] [--copies 8] [--iterations 3]
+// - each font of the fonts dir is generated (font + header + card, then source + header) per selection size (0 => all glyphs)
+// - a synthetic large font is generated by merging all the fonts, copied --copies times with remapped codepoints
+// the time of each stage (see GenerationProfiler) and the peak memory are written in stdout and in <output>/benchmark.csv
+// the peak memory is per scenario on linux, on the others os this is the peak of the process since his start
+// a OpenGL context is needed (the fonts atlas are built like in the app), so the app window is created but not shown
+
+struct GeneratorBenchmarkParams
+{
+	std::string fontsPath = "samples_Fonts";
+	std::string outputPath = "benchmark";
+	std::vector<size_t> selectionSizes = { 16U, 256U, 0U }; // 0 => all glyphs
+	uint32_t countSyntheticCopies = 8U; // 0 => no synthetic font
+	uint32_t countIterations = 3U;
+};
+
+struct GeneratorBenchmarkScenarioStruct
+{
+	std::string name;
+	size_t countGlyphs = 0U;
+	bool success = true;
+	double totalTimeInMs = 0.0; // per iteration
+	size_t peakMemoryInBytes = 0U; // resident memory, see peakMemoryOfScenario
+	bool peakMemoryOfScenario = false; // false => peak of the process since his start (not resettable on this os)
+	std::vector<GenerationStageStruct> stages;
+};
+
+class FontInfos;
+class GeneratorBenchmark
+{
+private:
+	GeneratorBenchmarkParams m_Params;
+	std::vector<GeneratorBenchmarkScenarioStruct> m_Scenarios;
+
+public:
+	static bool IsBenchmarkAsked(int argc, char** argv);
+	static bool ParseArgs(int argc, char** argv, GeneratorBenchmarkParams* vParams);
+	static bool ResetPeakMemory();
+	static size_t GetPeakMemoryInBytes();
+
+public:
+	explicit GeneratorBenchmark(const GeneratorBenchmarkParams& vParams);
+	int Run(); // return the exit code of the app
+
+private:
+	bool PrepareWorkspace(std::vector<std::string>* vFontFileNames);
+	static std::shared_ptr<FontInfos> LoadFont(const std::string& vFontFileName);
+	static size_t SelectGlyphs(std::shared_ptr<FontInfos> vFontInfos, const size_t& vCountGlyphs, uint32_t* vNextCodePoint, const std::string& vNameSuffix);
+	void RunScenario(const std::string& vName, const size_t& vCountGlyphs, const GenModeFlags& vFlags, const std::string& vFileName);
+	std::string GetReport() const;
+	std::string GetCsvReport() const;
+
+	static std::vector<std::string> ListFontFiles(const std::string& vPath);
+	static bool CopyFontFile(const std::string& vSrcFilePathName, const std::string& vDstFilePathName);
+};
@@ -24,11 +24,13 @@
 #include <string.h>
 #include <stdlib.h>
 #include <assert.h>
+#include <vector>
 
 #include <ctools/cTools.h>
 #include <ctools/FileHelper.h>
 #include <ctools/Logger.h>
 #include <Generator/FontGenerator.h>
+#include <Generator/GenerationProfiler.h>
 #include <Helper/Messaging.h>
 #include <Project/FontInfos.h>
 #include <Project/ProjectFile.h>
@@ -140,6 +142,73 @@ static std::string GetGlyphTableMinMax(std::string vLang, std::string vPrefix, c
 	return header;
 }
 
+// the sorted codepoints coalesced in [first, last] ranges
+// a gap of vGapTolerance codepoints or less between two ranges is merged
+// so less ranges but a few not selected glyphs rasterized
+static std::vector<ct::uvec2> GetCompactedRanges(const std::set<uint32_t>& vCodePoints, const uint32_t& vGapTolerance)
+{
+	std::vector<ct::uvec2> ranges;
+
+	for (const auto& cp : vCodePoints)
+	{
+		if (!cp)
+			continue; // 0 is the end of the imgui ranges
+
+		if (!ranges.empty() && cp - ranges.back().y <= vGapTolerance + 1U)
+			ranges.back().y = cp;
+		else
+			ranges.emplace_back(cp, cp);
+	}
+
+	return ranges;
+}
+
+// an ImWchar ranges table for ImFontAtlas::AddFontFromXXX
+// so only the selected glyphs are rasterized, not all the [min, max] range
+static std::string GetGlyphRanges(std::string vLang, std::string vPrefix, const std::vector<ct::uvec2>& vRanges)
+{
+	std::string header;
+
+	if (vRanges.empty())
+		return header;
+
+	const bool need32Bits = (vRanges.back().y > 0xFFFF);
+
+	std::string values;
+	for (size_t i = 0; i < vRanges.size(); ++i)
+	{
+		if (i % 4 == 0)
+			values += (vLang == "c#") ? "\t\t\t" : "\t";
+		values += ct::toStr("0x%s, 0x%s,", ct::toHexStr(vRanges[i].x).c_str(), ct::toHexStr(vRanges[i].y).c_str());
+		values += (i % 4 == 3 || i + 1 == vRanges.size()) ? "\n" : " ";
+	}
+
+	if (vLang == "cpp" ||
+		vLang == "c")
+	{
+		// ImWchar is defined by imgui, and is 16 bits without IMGUI_USE_WCHAR32
+		if (need32Bits)
+			header += "#if defined(IMGUI_VERSION) && defined(IMGUI_USE_WCHAR32)\n";
+		else
+			header += "#ifdef IMGUI_VERSION\n";
+		header += ct::toStr("#define ICON_RANGES_COUNT_%s %u\n", vPrefix.c_str(), (uint32_t)vRanges.size());
+		header += ct::toStr("static const ImWchar %s_ranges[] =\n{\n", vPrefix.c_str());
+		header += values;
+		header += "\t0\n};\n";
+		header += ct::toStr("#endif // %s\n", need32Bits ? "IMGUI_VERSION && IMGUI_USE_WCHAR32" : "IMGUI_VERSION");
+	}
+	else if (vLang == "c#")
+	{
+		header += ct::toStr("\t\tpublic static readonly %s[] ICON_RANGES =\n\t\t{\n", need32Bits ? "uint" : "ushort");
+		header += values;
+		header += "\t\t\t0\n\t\t};\n";
+	}
+
+	header += "\n";
+
+	return header;
+}
+
 static std::string GetGlyphItem(std::string vLang, std::string vType, std::string vPrefix, std::string vLabel, uint32_t vCodePoint)
 {
 	std::string header;
@@ -157,6 +226,131 @@ static std::string GetGlyphItem(std::string vLang, std::string vType, std::strin
 	return header;
 }
 
+// the utf8 bytes of a codepoint as a "\xNN" string
+// not a u8"" literal, because char8_t in c++20
+static std::string GetUtf8EscapedString(uint32_t vCodePoint)
+{
+	uint8_t bytes[4] = {};
+	size_t count = 0;
+	if (vCodePoint < 0x80)
+	{
+		bytes[count++] = (uint8_t)vCodePoint;
+	}
+	else if (vCodePoint < 0x800)
+	{
+		bytes[count++] = (uint8_t)(0xC0 | (vCodePoint >> 6));
+		bytes[count++] = (uint8_t)(0x80 | (vCodePoint & 0x3F));
+	}
+	else if (vCodePoint < 0x10000)
+	{
+		bytes[count++] = (uint8_t)(0xE0 | (vCodePoint >> 12));
+		bytes[count++] = (uint8_t)(0x80 | ((vCodePoint >> 6) & 0x3F));
+		bytes[count++] = (uint8_t)(0x80 | (vCodePoint & 0x3F));
+	}
+	else
+	{
+		bytes[count++] = (uint8_t)(0xF0 | (vCodePoint >> 18));
+		bytes[count++] = (uint8_t)(0x80 | ((vCodePoint >> 12) & 0x3F));
+		bytes[count++] = (uint8_t)(0x80 | ((vCodePoint >> 6) & 0x3F));
+		bytes[count++] = (uint8_t)(0x80 | (vCodePoint & 0x3F));
+	}
+
+	std::string res = "\"";
+	for (size_t i = 0; i < count; ++i)
+		res += ct::toStr("\\x%02X", bytes[i]);
+	res += "\"";
+	return res;
+}
+
+// name to codepoint table, sorted by name (the std::map order, same as strcmp)
+// so the lookup is a binary search, without allocation and without parsing at startup
+// c++ : constexpr table + constexpr FindByName (c++11)
+// c : static table + static inline FindByName
+// c# : NAMES and CODEPOINTS arrays + TryGetCodePoint
+static std::string GetGlyphNamesTable(std::string vLang, std::string vPrefix, const std::map<std::string, uint32_t>& vGlyphNames)
+{
+	std::string header;
+
+	if (vGlyphNames.empty())
+		return header;
+
+	const uint32_t count = (uint32_t)vGlyphNames.size();
+
+	if (vLang == "cpp")
+	{
+		header += "\n";
+		header += "namespace IconFonts\n{\n";
+		header += ct::toStr("namespace %s\n{\n", vPrefix.c_str());
+		header += "\tstruct NameEntry { const char* name; unsigned int codePoint; const char* utf8; };\n";
+		header += ct::toStr("\tconstexpr unsigned int NamesCount = %uU;\n", count);
+		header += "\tstatic constexpr NameEntry Names[NamesCount] =\n\t{\n";
+		for (const auto& it : vGlyphNames)
+		{
+			header += ct::toStr("\t\t{ \"%s\", 0x%s, %s },\n", it.first.c_str(),
+				ct::toHexStr(it.second).c_str(), GetUtf8EscapedString(it.second).c_str());
+		}
+		header += "\t};\n";
+		header += "\tconstexpr int CompareNames(const char* vA, const char* vB)\n\t{\n";
+		header += "\t\treturn (*vA != *vB || *vA == '\\0') ? ((int)(unsigned char)*vA - (int)(unsigned char)*vB) : CompareNames(vA + 1, vB + 1);\n";
+		header += "\t}\n";
+		header += "\t// return nullptr if not found\n";
+		header += "\tconstexpr const NameEntry* FindByName(const char* vName, unsigned int vLo = 0U, unsigned int vHi = NamesCount)\n\t{\n";
+		header += "\t\treturn (vLo >= vHi) ? nullptr :\n";
+		header += "\t\t\t(CompareNames(vName, Names[(vLo + vHi) / 2U].name) == 0) ? &Names[(vLo + vHi) / 2U] :\n";
+		header += "\t\t\t(CompareNames(vName, Names[(vLo + vHi) / 2U].name) < 0) ? FindByName(vName, vLo, (vLo + vHi) / 2U) :\n";
+		header += "\t\t\tFindByName(vName, (vLo + vHi) / 2U + 1U, vHi);\n";
+		header += "\t}\n";
+		header += ct::toStr("} // namespace %s\n", vPrefix.c_str());
+		header += "} // namespace IconFonts\n";
+	}
+	else if (vLang == "c")
+	{
+		header += "\n";
+		header += ct::toStr("typedef struct { const char* name; unsigned int codePoint; const char* utf8; } %s_NameEntry;\n", vPrefix.c_str());
+		header += ct::toStr("#define ICON_NAMES_COUNT_%s %u\n", vPrefix.c_str(), count);
+		header += ct::toStr("static const %s_NameEntry %s_names[ICON_NAMES_COUNT_%s] =\n{\n", vPrefix.c_str(), vPrefix.c_str(), vPrefix.c_str());
+		for (const auto& it : vGlyphNames)
+		{
+			header += ct::toStr("\t{ \"%s\", 0x%s, %s },\n", it.first.c_str(),
+				ct::toHexStr(it.second).c_str(), GetUtf8EscapedString(it.second).c_str());
+		}
+		header += "};\n";
+		header += "// return 0 if not found\n";
+		header += ct::toStr("static inline const %s_NameEntry* %s_FindByName(const char* vName)\n{\n", vPrefix.c_str(), vPrefix.c_str());
+		header += ct::toStr("\tint lo = 0, hi = ICON_NAMES_COUNT_%s;\n", vPrefix.c_str());
+		header += "\twhile (lo < hi)\n\t{\n";
+		header += "\t\tint mid = (lo + hi) / 2;\n";
+		header += ct::toStr("\t\tconst char* a = vName;\n\t\tconst char* b = %s_names[mid].name;\n", vPrefix.c_str());
+		header += "\t\twhile (*a && *a == *b) { ++a; ++b; }\n";
+		header += "\t\tint cmp = (int)(unsigned char)*a - (int)(unsigned char)*b;\n";
+		header += ct::toStr("\t\tif (cmp == 0) return &%s_names[mid];\n", vPrefix.c_str());
+		header += "\t\tif (cmp < 0) hi = mid;\n\t\telse lo = mid + 1;\n";
+		header += "\t}\n";
+		header += "\treturn 0;\n";
+		header += "}\n";
+	}
+	else if (vLang == "c#")
+	{
+		header += "\n";
+		header += "\t\t// sorted by ordinal order\n";
+		header += "\t\tpublic static readonly string[] NAMES =\n\t\t{\n";
+		for (const auto& it : vGlyphNames)
+			header += ct::toStr("\t\t\t\"%s\",\n", it.first.c_str());
+		header += "\t\t};\n";
+		header += "\t\tpublic static readonly uint[] CODEPOINTS =\n\t\t{\n";
+		for (const auto& it : vGlyphNames)
+			header += ct::toStr("\t\t\t0x%s,\n", ct::toHexStr(it.second).c_str());
+		header += "\t\t};\n";
+		header += "\t\tpublic static bool TryGetCodePoint(string vName, out uint vCodePoint)\n\t\t{\n";
+		header += "\t\t\tint idx = System.Array.BinarySearch(NAMES, vName, System.StringComparer.Ordinal);\n";
+		header += "\t\t\tvCodePoint = (idx >= 0) ? CODEPOINTS[idx] : 0;\n";
+		header += "\t\t\treturn (idx >= 0);\n";
+		header += "\t\t}\n";
+	}
+
+	return header;
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -170,10 +364,16 @@ std::string HeaderGenerator::GenerateHeaderFile(std::string vLang, std::string v
 	headerFile += GetHeader(vLang, vPrefix);
 	headerFile += GetFontInfos(vLang, vPrefix, vFontFileName, vFontBufferName, vFontBufferSize);
 	headerFile += GetGlyphTableMinMax(vLang, vPrefix, m_FinalCodePointRange);
+	headerFile += GetGlyphRanges(vLang, vPrefix,
+		GetCompactedRanges(m_FinalCodePoints, ProjectFile::Instance()->m_HeaderRangesGapTolerance));
 	for (const auto& it : m_FinalGlyphNames)
 	{
 		headerFile += GetGlyphItem(vLang, "ICON", vPrefix, it.first, it.second);
 	}
+	if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_HEADER_SETTINGS_NAMES_TABLE))
+	{
+		headerFile += GetGlyphNamesTable(vLang, vPrefix, m_FinalGlyphNames);
+	}
 	headerFile += GetFooter(vLang, vPrefix);
 	return headerFile;
 }
@@ -215,6 +415,8 @@ void HeaderGenerator::GenerateHeader_One(
 	std::string vFontBufferName, // for header generation wehn using a cpp bytes array instead of a file
 	size_t vFontBufferSize) // for header generation wehn using a cpp bytes array instead of a file
 {
+	GenerationStageScope stage("HeaderGenerator::GenerateHeader_One");
+
 	if (!vFilePathName.empty() && vFontInfos.use_count())
 	{
 		std::string filePathName = vFilePathName;
@@ -231,12 +433,14 @@ void HeaderGenerator::GenerateHeader_One(
 						glyphNames[it.second->newHeaderName] = it.second->newCodePoint;
 
 			m_FinalGlyphNames.clear();
+			m_FinalCodePoints.clear();
 			m_FinalCodePointRange = ct::uvec2(65535, 0);
 			for (const auto& it : glyphNames)
 			{
 				m_FinalCodePointRange.x = ct::mini(m_FinalCodePointRange.x, it.second);
 				m_FinalCodePointRange.y = ct::maxi(m_FinalCodePointRange.y, it.second);
 				m_FinalGlyphNames[GetNewHeaderName(it.first)] = it.second;
+				m_FinalCodePoints.emplace(it.second);
 			}
 
 			std::string lang, headerExt;
@@ -268,6 +472,7 @@ void HeaderGenerator::GenerateHeader_One(
 					vFontInfos->m_FontFileName,
 					vFontBufferName, vFontBufferSize);
 				FileHelper::Instance()->SaveStringToFile(headerFile, filePathName);
+				GenerationProfiler::Instance()->AddOutputFile(filePathName);
 				/////////////////////
 			}
 			else
@@ -290,6 +495,8 @@ void HeaderGenerator::GenerateHeader_Merged(
 	std::string vFontBufferName, // for header generation wehn using a cpp bytes array instead of a file
 	size_t vFontBufferSize) // for header generation wehn using a cpp bytes array instead of a file
 {
+	GenerationStageScope stage("HeaderGenerator::GenerateHeader_Merged");
+
 	if (!vFilePathName.empty() && !ProjectFile::Instance()->m_Fonts.empty())
 	{
 		std::string filePathName = vFilePathName;
@@ -308,12 +515,14 @@ void HeaderGenerator::GenerateHeader_Merged(
 						glyphNames[glyph.second->newHeaderName] = glyph.second->newCodePoint;
 					
 			m_FinalGlyphNames.clear();
+			m_FinalCodePoints.clear();
 			m_FinalCodePointRange = ct::uvec2(65535, 0);
 			for (const auto& it : glyphNames)
 			{
 				m_FinalCodePointRange.x = ct::mini(m_FinalCodePointRange.x, it.second);
 				m_FinalCodePointRange.y = ct::maxi(m_FinalCodePointRange.y, it.second);
 				m_FinalGlyphNames[GetNewHeaderName(it.first)] = it.second;
+				m_FinalCodePoints.emplace(it.second);
 			}
 
 			std::string lang, headerExt;
@@ -345,6 +554,7 @@ void HeaderGenerator::GenerateHeader_Merged(
 					ps.name + "." + ps.ext,
 					vFontBufferName, vFontBufferSize);
 				FileHelper::Instance()->SaveStringToFile(headerFile, filePathName);
+				GenerationProfiler::Instance()->AddOutputFile(filePathName);
 				/////////////////////
 			}
 			else
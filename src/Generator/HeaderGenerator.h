@@ -21,6 +21,7 @@
 #include <stdint.h>
 #include <string>
 #include <memory>
+#include <set>
 
 class FontInfos;
 class ProjectFile;
@@ -29,6 +30,7 @@ class HeaderGenerator
 private:
 	std::map<std::string, uint32_t> m_FinalGlyphNames;
 	ct::uvec2 m_FinalCodePointRange = ct::uvec2(65535, 0);
+	std::set<uint32_t> m_FinalCodePoints; // for the glyph ranges
 
 public:
 	void GenerateHeader_One(const std::string& vFilePathName,
@@ -21,6 +21,65 @@
 
 #include <cstring>
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MEMORY_STREAM_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+//// BYTE SWAP ////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// the font datas are big endian, vSrc and vDst can be unaligned, but must not overlap
+static void SwapBytes16(const uint8_t* vSrc, uint8_t* vDst, size_t vCount)
+{
+	size_t i = 0;
+#ifdef MEMORY_STREAM_USE_SSE2
+	for (; i + 8 <= vCount; i += 8) // 8 values per 128 bits
+	{
+		const __m128i v = _mm_loadu_si128((const __m128i*)(vSrc + i * 2));
+		_mm_storeu_si128((__m128i*)(vDst + i * 2), _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)));
+	}
+#endif
+	for (; i < vCount; ++i)
+	{
+		vDst[i * 2] = vSrc[i * 2 + 1];
+		vDst[i * 2 + 1] = vSrc[i * 2];
+	}
+}
+
+static void SwapBytes32(const uint8_t* vSrc, uint8_t* vDst, size_t vCount)
+{
+	size_t i = 0;
+#ifdef MEMORY_STREAM_USE_SSE2
+	for (; i + 4 <= vCount; i += 4) // 4 values per 128 bits
+	{
+		__m128i v = _mm_loadu_si128((const __m128i*)(vSrc + i * 4));
+		v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8)); // swap bytes of 16 bits words
+		v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1)); // then swap the words
+		v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+		_mm_storeu_si128((__m128i*)(vDst + i * 4), v);
+	}
+#endif
+	for (; i < vCount; ++i)
+	{
+		vDst[i * 4] = vSrc[i * 4 + 3];
+		vDst[i * 4 + 1] = vSrc[i * 4 + 2];
+		vDst[i * 4 + 2] = vSrc[i * 4 + 1];
+		vDst[i * 4 + 3] = vSrc[i * 4];
+	}
+}
+
+static bool IsLittleEndian()
+{
+	const uint16_t v = 1U;
+	return (*(const uint8_t*)&v == 1U);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 MemoryStream::MemoryStream() = default;
 
 MemoryStream::MemoryStream(uint8_t *vDatas, size_t vSize)
@@ -30,8 +89,22 @@ MemoryStream::MemoryStream(uint8_t *vDatas, size_t vSize)
 
 MemoryStream::~MemoryStream() = default;
 
+///////////////////////////////////////////////////////////////////////////////
+//// WRITE ////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// grow the owned datas by vSize, and return the ptr on the new space
+uint8_t* MemoryStream::AppendSpace(size_t vSize)
+{
+	MakeOwned();
+	const size_t pos = m_Datas.size();
+	m_Datas.resize(pos + vSize);
+	return m_Datas.data() + pos;
+}
+
 void MemoryStream::WriteByte(uint8_t b)
 {
+	MakeOwned();
 	m_Datas.push_back(b);
 }
 
@@ -39,22 +112,32 @@ void MemoryStream::WriteBytes(std::vector<uint8_t> *buffer)
 {
 	if (buffer)
 	{
-		m_Datas.insert(m_Datas.end(), buffer->begin(), buffer->end());
+		WriteBytes(buffer->data(), buffer->size());
+	}
+}
+
+void MemoryStream::WriteBytes(const uint8_t* vDatas, size_t vSize)
+{
+	if (vDatas && vSize)
+	{
+		memcpy(AppendSpace(vSize), vDatas, vSize);
 	}
 }
 
 void MemoryStream::WriteInt(int32_t i)
 {
-	WriteByte((uint8_t)((i >> 24) & 0xff));
-	WriteByte((uint8_t)((i >> 16) & 0xff));
-	WriteByte((uint8_t)((i >> 8) & 0xff));
-	WriteByte((uint8_t)(i & 0xff));
+	uint8_t* ptr = AppendSpace(4);
+	ptr[0] = (uint8_t)((i >> 24) & 0xff);
+	ptr[1] = (uint8_t)((i >> 16) & 0xff);
+	ptr[2] = (uint8_t)((i >> 8) & 0xff);
+	ptr[3] = (uint8_t)(i & 0xff);
 }
 
 void MemoryStream::WriteUShort(int32_t us)
 {
-	WriteByte((uint8_t)((us >> 8) & 0xff));
-	WriteByte((uint8_t)(us & 0xff));
+	uint8_t* ptr = AppendSpace(2);
+	ptr[0] = (uint8_t)((us >> 8) & 0xff);
+	ptr[1] = (uint8_t)(us & 0xff);
 }
 
 void MemoryStream::WriteFWord(int32_t us)
@@ -69,17 +152,19 @@ void MemoryStream::WriteShort(int32_t s)
 
 void MemoryStream::WriteUInt24(int32_t ui)
 {
-	WriteByte((uint8_t)(ui >> 16) & 0xff);
-	WriteByte((uint8_t)(ui >> 8) & 0xff);
-	WriteByte((uint8_t)ui & 0xff);
+	uint8_t* ptr = AppendSpace(3);
+	ptr[0] = (uint8_t)((ui >> 16) & 0xff);
+	ptr[1] = (uint8_t)((ui >> 8) & 0xff);
+	ptr[2] = (uint8_t)(ui & 0xff);
 }
 
 void MemoryStream::WriteULong(int64_t ul)
 {
-	WriteByte((uint8_t)((ul >> 24) & 0xff));
-	WriteByte((uint8_t)((ul >> 16) & 0xff));
-	WriteByte((uint8_t)((ul >> 8) & 0xff));
-	WriteByte((uint8_t)(ul & 0xff));
+	uint8_t* ptr = AppendSpace(4);
+	ptr[0] = (uint8_t)((ul >> 24) & 0xff);
+	ptr[1] = (uint8_t)((ul >> 16) & 0xff);
+	ptr[2] = (uint8_t)((ul >> 8) & 0xff);
+	ptr[3] = (uint8_t)(ul & 0xff);
 }
 
 void MemoryStream::WriteLong(int64_t l)
@@ -89,10 +174,11 @@ void MemoryStream::WriteLong(int64_t l)
 
 void MemoryStream::WriteFixed(MemoryStream::Fixed f)
 {
-	WriteByte((uint8_t)((f.high >> 24) & 0xff));
-	WriteByte((uint8_t)((f.high >> 16) & 0xff));
-	WriteByte((uint8_t)((f.low >> 8) & 0xff));
-	WriteByte((uint8_t)(f.low & 0xff));
+	uint8_t* ptr = AppendSpace(4);
+	ptr[0] = (uint8_t)((f.high >> 24) & 0xff);
+	ptr[1] = (uint8_t)((f.high >> 16) & 0xff);
+	ptr[2] = (uint8_t)((f.low >> 8) & 0xff);
+	ptr[3] = (uint8_t)(f.low & 0xff);
 }
 
 void MemoryStream::WriteF2DOT14(MemoryStream::F2DOT14 f)
@@ -106,13 +192,57 @@ void MemoryStream::WriteDateTime(longDateTime date)
 	WriteULong(date & 0xffffffff);
 }
 
+void MemoryStream::WriteShorts(const int16_t* vValues, size_t vCount)
+{
+	WriteUShorts((const uint16_t*)vValues, vCount);
+}
+
+void MemoryStream::WriteUShorts(const uint16_t* vValues, size_t vCount)
+{
+	if (vValues && vCount)
+	{
+		uint8_t* ptr = AppendSpace(vCount * 2);
+		if (IsLittleEndian())
+			SwapBytes16((const uint8_t*)vValues, ptr, vCount);
+		else
+			memcpy(ptr, vValues, vCount * 2);
+	}
+}
+
+void MemoryStream::WriteULongs(const uint32_t* vValues, size_t vCount)
+{
+	if (vValues && vCount)
+	{
+		uint8_t* ptr = AppendSpace(vCount * 4);
+		if (IsLittleEndian())
+			SwapBytes32((const uint8_t*)vValues, ptr, vCount);
+		else
+			memcpy(ptr, vValues, vCount * 4);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//// DATAS ////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// writable datas, so a view is copied first (the viewed datas can be read only, like a mapped file)
 uint8_t* MemoryStream::Get()
 {
+	MakeOwned();
+	return m_Datas.data();
+}
+
+const uint8_t* MemoryStream::GetDatas() const
+{
+	if (m_View)
+		return m_View;
 	return m_Datas.data();
 }
 
 size_t MemoryStream::Size()
 {
+	if (m_View)
+		return m_ViewSize;
 	return m_Datas.size();
 }
 
@@ -130,6 +260,9 @@ void MemoryStream::Set(uint8_t *vDatas, size_t vSize)
 {
 	if (vDatas && vSize)
 	{
+		m_View = nullptr;
+		m_ViewSize = 0;
+
 		m_Datas.clear();
 		m_Datas.resize(vSize);
 
@@ -137,21 +270,60 @@ void MemoryStream::Set(uint8_t *vDatas, size_t vSize)
 	}
 }
 
+void MemoryStream::SetView(const uint8_t* vDatas, size_t vSize)
+{
+	m_Datas.clear();
+	m_View = vDatas;
+	m_ViewSize = vDatas ? vSize : 0;
+	m_ReadPos = 0;
+}
+
+void MemoryStream::Reserve(size_t vSize)
+{
+	MakeOwned();
+	m_Datas.reserve(vSize);
+}
+
+void MemoryStream::Clear()
+{
+	m_Datas.clear();
+	m_View = nullptr;
+	m_ViewSize = 0;
+	m_ReadPos = 0;
+}
+
+// copy on write of a view
+void MemoryStream::MakeOwned()
+{
+	if (m_View)
+	{
+		m_Datas.assign(m_View, m_View + m_ViewSize);
+		m_View = nullptr;
+		m_ViewSize = 0;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//// READ /////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
 uint8_t MemoryStream::ReadByte()
 {
-	if (m_ReadPos < m_Datas.size())
-		return m_Datas[m_ReadPos++];
+	if (m_ReadPos < Size())
+		return GetDatas()[m_ReadPos++];
 	return 0;
 }
 
 int32_t MemoryStream::ReadUShort()
 {
-	return 0xffff & (ReadByte() << 8 | ReadByte());
+	const int32_t b0 = ReadByte();
+	const int32_t b1 = ReadByte();
+	return 0xffff & (b0 << 8 | b1);
 }
 
 int32_t MemoryStream::ReadShort()
 {
-	return ((ReadByte() << 8 | ReadByte()) << 16) >> 16;
+	return (int32_t)(int16_t)ReadUShort();
 }
 
 MemoryStream::FWord MemoryStream::ReadFWord()
@@ -161,7 +333,10 @@ MemoryStream::FWord MemoryStream::ReadFWord()
 
 uint32_t MemoryStream::ReadUInt24()
 {
-	return 0xffffff & (ReadByte() << 16 | ReadByte() << 8 | ReadByte());
+	const uint32_t b0 = ReadByte();
+	const uint32_t b1 = ReadByte();
+	const uint32_t b2 = ReadByte();
+	return 0xffffff & (b0 << 16 | b1 << 8 | b2);
 }
 
 uint64_t MemoryStream::ReadULong()
@@ -177,7 +352,11 @@ uint32_t MemoryStream::ReadULongAsInt()
 
 int32_t MemoryStream::ReadLong()
 {
-	return ReadByte() << 24 | ReadByte() << 16 | ReadByte() << 8 | ReadByte();
+	const uint32_t b0 = ReadByte();
+	const uint32_t b1 = ReadByte();
+	const uint32_t b2 = ReadByte();
+	const uint32_t b3 = ReadByte();
+	return (int32_t)(b0 << 24 | b1 << 16 | b2 << 8 | b3);
 }
 
 MemoryStream::Fixed MemoryStream::ReadFixed()
@@ -198,12 +377,66 @@ MemoryStream::F2DOT14 MemoryStream::ReadF2DOT14()
 
 MemoryStream::longDateTime MemoryStream::ReadDateTime()
 {
-	return (int64_t)ReadULong() << 32 | ReadULong();
+	const int64_t high = (int64_t)ReadULong();
+	const int64_t low = (int64_t)ReadULong();
+	return high << 32 | low;
 }
 
 std::string MemoryStream::ReadString(size_t vLen)
 {
-	std::string res = std::string((char*)(m_Datas.data() + m_ReadPos), vLen);
+	std::string res;
+	const size_t size = Size();
+	if (m_ReadPos < size)
+	{
+		vLen = (vLen < size - m_ReadPos) ? vLen : size - m_ReadPos;
+		res = std::string((const char*)(GetDatas() + m_ReadPos), vLen);
+	}
 	m_ReadPos += vLen;
 	return res;
-}
\ No newline at end of file
+}
+
+size_t MemoryStream::ReadBytes(uint8_t* vValues, size_t vCount)
+{
+	const size_t size = Size();
+	if (!vValues || m_ReadPos >= size)
+		return 0;
+	const size_t count = (vCount < size - m_ReadPos) ? vCount : size - m_ReadPos;
+	memcpy(vValues, GetDatas() + m_ReadPos, count);
+	m_ReadPos += count;
+	return count;
+}
+
+size_t MemoryStream::ReadShorts(int16_t* vValues, size_t vCount)
+{
+	return ReadUShorts((uint16_t*)vValues, vCount);
+}
+
+size_t MemoryStream::ReadUShorts(uint16_t* vValues, size_t vCount)
+{
+	const size_t size = Size();
+	if (!vValues || m_ReadPos >= size)
+		return 0;
+	const size_t available = (size - m_ReadPos) / 2;
+	const size_t count = (vCount < available) ? vCount : available;
+	if (IsLittleEndian())
+		SwapBytes16(GetDatas() + m_ReadPos, (uint8_t*)vValues, count);
+	else
+		memcpy(vValues, GetDatas() + m_ReadPos, count * 2);
+	m_ReadPos += count * 2;
+	return count;
+}
+
+size_t MemoryStream::ReadULongs(uint32_t* vValues, size_t vCount)
+{
+	const size_t size = Size();
+	if (!vValues || m_ReadPos >= size)
+		return 0;
+	const size_t available = (size - m_ReadPos) / 4;
+	const size_t count = (vCount < available) ? vCount : available;
+	if (IsLittleEndian())
+		SwapBytes32(GetDatas() + m_ReadPos, (uint8_t*)vValues, count);
+	else
+		memcpy(vValues, GetDatas() + m_ReadPos, count * 4);
+	m_ReadPos += count * 4;
+	return count;
+}
@@ -48,6 +48,7 @@ public:
 
 	void WriteByte(uint8_t b);
 	void WriteBytes(std::vector<uint8_t> *buffer);
+	void WriteBytes(const uint8_t* vDatas, size_t vSize);
 	void WriteShort(int32_t i);
 	void WriteUShort(int32_t us);
 	void WriteFWord(int32_t us);
@@ -59,8 +60,20 @@ public:
 	void WriteF2DOT14(F2DOT14 f);
 	void WriteDateTime(longDateTime date);
 
-	uint8_t* Get();
+	// bulk writers, big endian, the byte swap is done on the whole span
+	void WriteShorts(const int16_t* vValues, size_t vCount);
+	void WriteUShorts(const uint16_t* vValues, size_t vCount);
+	void WriteULongs(const uint32_t* vValues, size_t vCount);
+
+	uint8_t* Get(); // make an owned copy of a view, use GetDatas for read only
+	const uint8_t* GetDatas() const;
 	void Set(uint8_t *vDatas, size_t vSize);
+	// non owning view on vDatas, nothing is copied
+	// vDatas must outlive the stream. a write on a view make an owned copy first
+	void SetView(const uint8_t* vDatas, size_t vSize);
+	bool IsView() const { return (m_View != nullptr); }
+	void Reserve(size_t vSize);
+	void Clear();
 	
 	size_t Size();
 
@@ -80,8 +93,19 @@ public:
 	longDateTime ReadDateTime();
 	std::string ReadString(size_t vLen);
 
+	// bulk readers, big endian, return the count of values read (less than vCount at end of stream)
+	size_t ReadBytes(uint8_t* vValues, size_t vCount);
+	size_t ReadShorts(int16_t* vValues, size_t vCount);
+	size_t ReadUShorts(uint16_t* vValues, size_t vCount);
+	size_t ReadULongs(uint32_t* vValues, size_t vCount);
+
+private:
+	uint8_t* AppendSpace(size_t vSize);
+	void MakeOwned();
+
 private:
 	std::vector<uint8_t> m_Datas;
+	const uint8_t* m_View = nullptr; // not owned
+	size_t m_ViewSize = 0;
 	size_t m_ReadPos = 0;
 };
-
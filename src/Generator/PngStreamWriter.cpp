@@ -0,0 +1,386 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PngStreamWriter.h"
+
+#include <cstring>
+#include <cstdlib>
+
+// deflate limits
+#define PNG_STREAM_WINDOW_SIZE 32768
+#define PNG_STREAM_MIN_MATCH 3
+#define PNG_STREAM_MAX_MATCH 258
+#define PNG_STREAM_MAX_CHAIN 32
+#define PNG_STREAM_HASH_SIZE 16384
+
+// same tables as stb_image_write
+static const uint16_t s_LengthCodes[] = { 3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258,259 };
+static const uint8_t s_LengthExtraBits[] = { 0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0 };
+static const uint16_t s_DistCodes[] = { 1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,2049,3073,4097,6145,8193,12289,16385,24577,32768 };
+static const uint8_t s_DistExtraBits[] = { 0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13 };
+
+static uint32_t Crc32(const uint8_t* vDatas, const size_t& vSize, uint32_t vCrc = 0U)
+{
+	static const std::vector<uint32_t> s_CrcTable = []()
+	{
+		std::vector<uint32_t> table(256);
+		for (uint32_t i = 0; i < 256; ++i)
+		{
+			uint32_t c = i;
+			for (uint32_t k = 0; k < 8; ++k)
+				c = (c & 1) ? (0xEDB88320U ^ (c >> 1)) : (c >> 1);
+			table[i] = c;
+		}
+		return table;
+	}();
+
+	uint32_t crc = ~vCrc;
+	for (size_t i = 0; i < vSize; ++i)
+		crc = s_CrcTable[(crc ^ vDatas[i]) & 0xFF] ^ (crc >> 8);
+	return ~crc;
+}
+
+static void WriteBigEndian32(uint8_t* vPtr, const uint32_t& vValue)
+{
+	vPtr[0] = (uint8_t)(vValue >> 24);
+	vPtr[1] = (uint8_t)(vValue >> 16);
+	vPtr[2] = (uint8_t)(vValue >> 8);
+	vPtr[3] = (uint8_t)(vValue);
+}
+
+static uint32_t Hash3(const uint8_t* vPtr)
+{
+	uint32_t h = (uint32_t)vPtr[0] | ((uint32_t)vPtr[1] << 8) | ((uint32_t)vPtr[2] << 16);
+	h *= 2654435761U;
+	return h >> (32 - 14); // PNG_STREAM_HASH_SIZE = 2^14
+}
+
+PngStreamWriter::PngStreamWriter() = default;
+
+PngStreamWriter::~PngStreamWriter()
+{
+	if (m_File)
+		fclose(m_File);
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PUBLIC ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+bool PngStreamWriter::Open(const std::string& vFilePathName, const uint32_t& vWidth, const uint32_t& vHeight)
+{
+	if (m_File || !vWidth || !vHeight)
+		return false;
+
+#ifdef MSVC
+	errno_t err = fopen_s(&m_File, vFilePathName.c_str(), "wb");
+	if (err) m_File = nullptr;
+#else
+	m_File = fopen(vFilePathName.c_str(), "wb");
+#endif
+	if (!m_File)
+		return false;
+
+	m_Width = vWidth;
+	m_Height = vHeight;
+	m_WrittenRows = 0U;
+	m_Bits = 0U;
+	m_BitCount = 0U;
+	m_Adler_A = 1U;
+	m_Adler_B = 0U;
+	m_Window.clear();
+	m_PrevRow.clear();
+	m_PrevRow.resize(m_Width, 0U);
+	m_Out.clear();
+
+	static const uint8_t signature[8] = { 137, 80, 78, 71, 13, 10, 26, 10 };
+	bool res = (fwrite(signature, 1, 8, m_File) == 8);
+
+	// 8 bits grayscale, no interlace
+	uint8_t ihdr[13] = {};
+	WriteBigEndian32(ihdr, m_Width);
+	WriteBigEndian32(ihdr + 4, m_Height);
+	ihdr[8] = 8; // bit depth
+	ihdr[9] = 0; // color type : grayscale
+	res &= WriteChunk("IHDR", ihdr, 13);
+
+	// zlib header, then the start of the unique fixed huffman block
+	m_Out.push_back(0x78);
+	m_Out.push_back(0x01);
+	AddBits(1, 1); // final block
+	AddBits(1, 2); // fixed huffman
+
+	return res;
+}
+
+bool PngStreamWriter::WriteRows(const uint8_t* vRows, const uint32_t& vCountRows, const size_t& vStride)
+{
+	if (!m_File || !vRows)
+		return false;
+
+	if (m_WrittenRows + vCountRows > m_Height)
+		return false;
+
+	// the previous bytes are kept for find the matchs
+	std::vector<uint8_t> datas;
+	datas.reserve(m_Window.size() + (size_t)vCountRows * ((size_t)m_Width + 1U));
+	datas.insert(datas.end(), m_Window.begin(), m_Window.end());
+	const size_t start = datas.size();
+
+	for (uint32_t row = 0; row < vCountRows; ++row)
+	{
+		FilterRow(vRows + vStride * row, datas);
+	}
+	UpdateAdler(datas.data() + start, datas.size() - start);
+
+	Deflate(datas, start);
+
+	const size_t windowSize = datas.size() < PNG_STREAM_WINDOW_SIZE ? datas.size() : PNG_STREAM_WINDOW_SIZE;
+	m_Window.assign(datas.end() - windowSize, datas.end());
+
+	m_WrittenRows += vCountRows;
+
+	bool res = true;
+	if (!m_Out.empty())
+	{
+		res = WriteChunk("IDAT", m_Out.data(), m_Out.size());
+		m_Out.clear();
+	}
+
+	return res;
+}
+
+bool PngStreamWriter::Close()
+{
+	if (!m_File)
+		return false;
+
+	bool res = (m_WrittenRows == m_Height);
+
+	AddHuffmanCode(0, 7); // end of block (256)
+	if (m_BitCount)
+	{
+		m_Out.push_back((uint8_t)(m_Bits & 0xFF));
+		m_Bits = 0U;
+		m_BitCount = 0U;
+	}
+
+	uint8_t adler[4];
+	WriteBigEndian32(adler, (m_Adler_B << 16) | m_Adler_A);
+	m_Out.insert(m_Out.end(), adler, adler + 4);
+
+	res &= WriteChunk("IDAT", m_Out.data(), m_Out.size());
+	res &= WriteChunk("IEND", nullptr, 0);
+	m_Out.clear();
+	m_Window.clear();
+
+	res &= (fclose(m_File) == 0);
+	m_File = nullptr;
+
+	return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PRIVATE //////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// choose the filter (none, sub, up) with the lowest sum of abs, like stb_image_write do
+void PngStreamWriter::FilterRow(const uint8_t* vRow, std::vector<uint8_t>& vOut)
+{
+	int32_t bestFilter = 0;
+	int32_t bestSum = 0x7FFFFFFF;
+	for (int32_t filter = 0; filter < 3; ++filter)
+	{
+		int32_t sum = 0;
+		for (uint32_t i = 0; i < m_Width; ++i)
+		{
+			uint8_t v = vRow[i];
+			if (filter == 1) v = (uint8_t)(v - (i ? vRow[i - 1] : 0));
+			else if (filter == 2) v = (uint8_t)(v - m_PrevRow[i]);
+			sum += abs((int8_t)v);
+		}
+		if (sum < bestSum)
+		{
+			bestSum = sum;
+			bestFilter = filter;
+		}
+	}
+
+	vOut.push_back((uint8_t)bestFilter);
+	for (uint32_t i = 0; i < m_Width; ++i)
+	{
+		uint8_t v = vRow[i];
+		if (bestFilter == 1) v = (uint8_t)(v - (i ? vRow[i - 1] : 0));
+		else if (bestFilter == 2) v = (uint8_t)(v - m_PrevRow[i]);
+		vOut.push_back(v);
+	}
+
+	memcpy(m_PrevRow.data(), vRow, m_Width);
+}
+
+// lz77 with hash chains, the bytes before vStart are only used as dictionary
+void PngStreamWriter::Deflate(const std::vector<uint8_t>& vData, const size_t& vStart)
+{
+	const size_t size = vData.size();
+	std::vector<int32_t> head(PNG_STREAM_HASH_SIZE, -1);
+	std::vector<int32_t> prev(size, -1);
+
+	auto insert = [&](const size_t& vPos)
+	{
+		if (vPos + PNG_STREAM_MIN_MATCH <= size)
+		{
+			const uint32_t h = Hash3(vData.data() + vPos);
+			prev[vPos] = head[h];
+			head[h] = (int32_t)vPos;
+		}
+	};
+
+	for (size_t i = 0; i < vStart; ++i)
+		insert(i);
+
+	size_t pos = vStart;
+	while (pos < size)
+	{
+		size_t bestLen = 0U;
+		size_t bestDist = 0U;
+
+		if (pos + PNG_STREAM_MIN_MATCH <= size)
+		{
+			const size_t maxLen = (size - pos) < PNG_STREAM_MAX_MATCH ? (size - pos) : PNG_STREAM_MAX_MATCH;
+			int32_t candidate = head[Hash3(vData.data() + pos)];
+			int32_t chain = PNG_STREAM_MAX_CHAIN;
+			while (candidate >= 0 && chain-- > 0)
+			{
+				const size_t dist = pos - (size_t)candidate;
+				if (dist >= PNG_STREAM_WINDOW_SIZE)
+					break;
+
+				size_t len = 0U;
+				while (len < maxLen && vData[(size_t)candidate + len] == vData[pos + len])
+					++len;
+				if (len > bestLen)
+				{
+					bestLen = len;
+					bestDist = dist;
+					if (len == maxLen)
+						break;
+				}
+				candidate = prev[(size_t)candidate];
+			}
+		}
+
+		if (bestLen >= PNG_STREAM_MIN_MATCH)
+		{
+			AddMatch((uint32_t)bestLen, (uint32_t)bestDist);
+			for (size_t i = 0; i < bestLen; ++i)
+				insert(pos + i);
+			pos += bestLen;
+		}
+		else
+		{
+			AddLiteral(vData[pos]);
+			insert(pos);
+			++pos;
+		}
+	}
+}
+
+void PngStreamWriter::AddBits(const uint32_t& vCode, const uint32_t& vCountBits)
+{
+	m_Bits |= vCode << m_BitCount;
+	m_BitCount += vCountBits;
+	while (m_BitCount >= 8)
+	{
+		m_Out.push_back((uint8_t)(m_Bits & 0xFF));
+		m_Bits >>= 8;
+		m_BitCount -= 8;
+	}
+}
+
+// huffman codes are written from the most significant bit
+void PngStreamWriter::AddHuffmanCode(const uint32_t& vCode, const uint32_t& vCountBits)
+{
+	uint32_t rev = 0U;
+	for (uint32_t i = 0; i < vCountBits; ++i)
+		rev |= ((vCode >> i) & 1U) << (vCountBits - 1U - i);
+	AddBits(rev, vCountBits);
+}
+
+void PngStreamWriter::AddLiteral(const uint32_t& vLiteral)
+{
+	if (vLiteral <= 143)
+		AddHuffmanCode(0x30 + vLiteral, 8);
+	else
+		AddHuffmanCode(0x190 + vLiteral - 144, 9);
+}
+
+void PngStreamWriter::AddMatch(const uint32_t& vLength, const uint32_t& vDistance)
+{
+	uint32_t i = 0;
+	while (s_LengthCodes[i + 1] <= vLength) ++i;
+	const uint32_t symbol = 257 + i;
+	if (symbol <= 279)
+		AddHuffmanCode(symbol - 256, 7);
+	else
+		AddHuffmanCode(0xC0 + symbol - 280, 8);
+	if (s_LengthExtraBits[i])
+		AddBits(vLength - s_LengthCodes[i], s_LengthExtraBits[i]);
+
+	uint32_t j = 0;
+	while (s_DistCodes[j + 1] <= vDistance) ++j;
+	AddHuffmanCode(j, 5);
+	if (s_DistExtraBits[j])
+		AddBits(vDistance - s_DistCodes[j], s_DistExtraBits[j]);
+}
+
+void PngStreamWriter::UpdateAdler(const uint8_t* vDatas, const size_t& vSize)
+{
+	size_t i = 0;
+	while (i < vSize)
+	{
+		// 5552 is the max count of bytes before the sums overflow
+		size_t blockEnd = i + 5552U < vSize ? i + 5552U : vSize;
+		for (; i < blockEnd; ++i)
+		{
+			m_Adler_A += vDatas[i];
+			m_Adler_B += m_Adler_A;
+		}
+		m_Adler_A %= 65521U;
+		m_Adler_B %= 65521U;
+	}
+}
+
+bool PngStreamWriter::WriteChunk(const char* vType, const uint8_t* vDatas, const size_t& vSize)
+{
+	uint8_t header[8];
+	WriteBigEndian32(header, (uint32_t)vSize);
+	memcpy(header + 4, vType, 4);
+
+	uint32_t crc = Crc32(header + 4, 4);
+	if (vDatas && vSize)
+		crc = Crc32(vDatas, vSize, crc);
+	uint8_t footer[4];
+	WriteBigEndian32(footer, crc);
+
+	bool res = (fwrite(header, 1, 8, m_File) == 8);
+	if (vDatas && vSize)
+		res &= (fwrite(vDatas, 1, vSize, m_File) == vSize);
+	res &= (fwrite(footer, 1, 4, m_File) == 4);
+	return res;
+}
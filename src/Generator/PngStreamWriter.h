@@ -0,0 +1,62 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// write a 8 bits grayscale png, row by row
+// only the rows of the current call are in memory, so a picture can be written by bands
+// the deflate stream is one fixed huffman block (like stb_image_write) continued between calls
+class PngStreamWriter
+{
+private:
+	FILE* m_File = nullptr;
+	uint32_t m_Width = 0U;
+	uint32_t m_Height = 0U;
+	uint32_t m_WrittenRows = 0U;
+
+	// deflate
+	uint32_t m_Bits = 0U;
+	uint32_t m_BitCount = 0U;
+	uint32_t m_Adler_A = 1U;
+	uint32_t m_Adler_B = 0U;
+	std::vector<uint8_t> m_Window; // last filtered bytes, for the matchs between two calls
+	std::vector<uint8_t> m_PrevRow;
+	std::vector<uint8_t> m_Out; // compressed bytes of the current call
+
+public:
+	PngStreamWriter();
+	~PngStreamWriter();
+
+	bool Open(const std::string& vFilePathName, const uint32_t& vWidth, const uint32_t& vHeight);
+	bool WriteRows(const uint8_t* vRows, const uint32_t& vCountRows, const size_t& vStride);
+	bool Close();
+	bool IsOpened() const { return (m_File != nullptr); }
+
+private:
+	void FilterRow(const uint8_t* vRow, std::vector<uint8_t>& vOut);
+	void Deflate(const std::vector<uint8_t>& vData, const size_t& vStart);
+	void AddBits(const uint32_t& vCode, const uint32_t& vCountBits);
+	void AddHuffmanCode(const uint32_t& vCode, const uint32_t& vCountBits);
+	void AddLiteral(const uint32_t& vLiteral);
+	void AddMatch(const uint32_t& vLength, const uint32_t& vDistance);
+	void UpdateAdler(const uint8_t* vDatas, const size_t& vSize);
+	bool WriteChunk(const char* vType, const uint8_t* vDatas, const size_t& vSize);
+};
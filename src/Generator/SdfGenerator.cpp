@@ -0,0 +1,552 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SdfGenerator.h"
+
+#include <Generator/FontGenerator.h>
+#include <Generator/GenerationProfiler.h>
+#include <Generator/Generator.h>
+#include <Helper/Messaging.h>
+#include <Project/FontInfos.h>
+#include <Project/GlyphInfos.h>
+#include <ctools/cTools.h>
+
+#include <imgui/imgui.h>
+
+#include <cmath>
+#include <cfloat>
+#include <cstring>
+
+#define SDF_CORNER_CROSS_THRESHOLD 0.14112 // sin(3.0), angle under what two edges make a corner
+#define SDF_DISTANCE_EPSILON 1e-9
+
+// edge colors, one bit per channel
+#define SDF_COLOR_RED 1U
+#define SDF_COLOR_GREEN 2U
+#define SDF_COLOR_BLUE 4U
+#define SDF_COLOR_YELLOW (SDF_COLOR_RED | SDF_COLOR_GREEN)
+#define SDF_COLOR_MAGENTA (SDF_COLOR_RED | SDF_COLOR_BLUE)
+#define SDF_COLOR_CYAN (SDF_COLOR_GREEN | SDF_COLOR_BLUE)
+#define SDF_COLOR_WHITE (SDF_COLOR_RED | SDF_COLOR_GREEN | SDF_COLOR_BLUE)
+
+struct SdfVec2
+{
+	double x = 0.0, y = 0.0;
+	SdfVec2() = default;
+	SdfVec2(double vX, double vY) : x(vX), y(vY) {}
+	SdfVec2 operator + (const SdfVec2& v) const { return SdfVec2(x + v.x, y + v.y); }
+	SdfVec2 operator - (const SdfVec2& v) const { return SdfVec2(x - v.x, y - v.y); }
+	SdfVec2 operator * (const double& v) const { return SdfVec2(x * v, y * v); }
+	bool operator == (const SdfVec2& v) const { return x == v.x && y == v.y; }
+	bool operator != (const SdfVec2& v) const { return !(*this == v); }
+};
+
+static double Dot(const SdfVec2& a, const SdfVec2& b) { return a.x * b.x + a.y * b.y; }
+static double Cross(const SdfVec2& a, const SdfVec2& b) { return a.x * b.y - a.y * b.x; }
+static double Length(const SdfVec2& a) { return std::sqrt(Dot(a, a)); }
+static SdfVec2 Normalize(const SdfVec2& a)
+{
+	const double len = Length(a);
+	if (len > 0.0) return a * (1.0 / len);
+	return SdfVec2(0.0, 1.0);
+}
+
+// one edge of a contour, line or quadratic bezier, in pixels, y up
+struct SdfEdgeStruct
+{
+	SdfVec2 p0, c, p1;
+	bool quad = false;
+	uint32_t color = SDF_COLOR_WHITE;
+
+	SdfVec2 GetStartDir() const { return (quad && c != p0) ? c - p0 : p1 - p0; }
+	SdfVec2 GetEndDir() const { return (quad && c != p1) ? p1 - c : p1 - p0; }
+};
+
+// edges are flattened in segments for the distance queries
+struct SdfSegmentStruct
+{
+	SdfVec2 a, b;
+	uint32_t color = SDF_COLOR_WHITE;
+	bool edgeStart = false; // first segment of the edge, the distance is extended before a
+	bool edgeEnd = false; // last segment of the edge, the distance is extended after b
+};
+
+// closest segment found for a channel
+struct SdfCandidateStruct
+{
+	double distance = DBL_MAX;
+	double orthogonality = 0.0;
+	double t = 0.0; // not clamped
+	const SdfSegmentStruct* segment = nullptr;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+// truetype contour (quadratic, with implicit on curve points) to edges
+static void BuildContourEdges(SimpleGlyph_Solo& vGlyph, const int32_t& vContour, const double& vScale,
+	std::vector<SdfEdgeStruct>* vOutEdges)
+{
+	const int32_t count = (int32_t)vGlyph.coords[vContour].size();
+	if (count < 2) return;
+
+	auto getPoint = [&vGlyph, &vContour, &vScale](int32_t vIdx)
+	{
+		auto p = vGlyph.GetCoords(vContour, vIdx);
+		return SdfVec2(p.x * vScale, p.y * vScale);
+	};
+
+	int32_t startIdx = -1;
+	for (int32_t i = 0; i < count; ++i)
+	{
+		if (vGlyph.IsOnCurve(vContour, i))
+		{
+			startIdx = i;
+			break;
+		}
+	}
+
+	SdfVec2 start;
+	int32_t firstIdx = 0;
+	if (startIdx >= 0)
+	{
+		start = getPoint(startIdx);
+		firstIdx = startIdx + 1;
+	}
+	else // only off curve points, start at the implicit point between the last and the first
+	{
+		start = (getPoint(count - 1) + getPoint(0)) * 0.5;
+		firstIdx = 0;
+	}
+
+	auto addEdge = [vOutEdges](const SdfVec2& p0, const SdfVec2& c, const SdfVec2& p1, bool quad)
+	{
+		if (p0 == p1 && (!quad || c == p0)) return; // degenerated
+		SdfEdgeStruct edge;
+		edge.p0 = p0;
+		edge.c = c;
+		edge.p1 = p1;
+		edge.quad = quad;
+		vOutEdges->push_back(edge);
+	};
+
+	SdfVec2 cur = start, ctrl;
+	bool pendingCtrl = false;
+	for (int32_t k = 0; k < count; ++k)
+	{
+		const int32_t idx = (firstIdx + k) % count;
+		const SdfVec2 p = getPoint(idx);
+		if (vGlyph.IsOnCurve(vContour, idx))
+		{
+			addEdge(cur, pendingCtrl ? ctrl : cur, p, pendingCtrl);
+			cur = p;
+			pendingCtrl = false;
+		}
+		else
+		{
+			if (pendingCtrl) // two off curve points, implicit on curve point between
+			{
+				const SdfVec2 mid = (ctrl + p) * 0.5;
+				addEdge(cur, ctrl, mid, true);
+				cur = mid;
+			}
+			ctrl = p;
+			pendingCtrl = true;
+		}
+	}
+
+	// close
+	addEdge(cur, pendingCtrl ? ctrl : cur, start, pendingCtrl);
+}
+
+static bool IsCorner(const SdfVec2& vEndDir, const SdfVec2& vStartDir)
+{
+	const SdfVec2 a = Normalize(vEndDir);
+	const SdfVec2 b = Normalize(vStartDir);
+	return Dot(a, b) <= 0.0 || std::fabs(Cross(a, b)) > SDF_CORNER_CROSS_THRESHOLD;
+}
+
+// colors of the edges, two edges meeting at a corner must not share two channels
+static void ColorContourEdges(SdfEdgeStruct* vEdges, const size_t& vCount)
+{
+	if (!vEdges || !vCount) return;
+
+	std::vector<size_t> corners; // edge starting at a corner
+	for (size_t i = 0; i < vCount; ++i)
+	{
+		const auto& prev = vEdges[(i + vCount - 1) % vCount];
+		if (IsCorner(prev.GetEndDir(), vEdges[i].GetStartDir()))
+			corners.push_back(i);
+	}
+
+	if (corners.empty()) // smooth contour
+	{
+		for (size_t i = 0; i < vCount; ++i)
+			vEdges[i].color = SDF_COLOR_WHITE;
+	}
+	else if (corners.size() == 1U) // teardrop, the contour is cut in three
+	{
+		static const uint32_t colors[3] = { SDF_COLOR_MAGENTA, SDF_COLOR_WHITE, SDF_COLOR_YELLOW };
+		for (size_t k = 0; k < vCount; ++k)
+		{
+			size_t part = (vCount >= 3U) ? (k * 3U / vCount) : (k ? 2U : 0U);
+			vEdges[(corners[0] + k) % vCount].color = colors[part];
+		}
+	}
+	else
+	{
+		static const uint32_t colors[3] = { SDF_COLOR_CYAN, SDF_COLOR_MAGENTA, SDF_COLOR_YELLOW };
+		const size_t countSplines = corners.size();
+		for (size_t s = 0; s < countSplines; ++s)
+		{
+			uint32_t color = colors[s % 3U];
+			if (s == countSplines - 1U && s % 3U == 0U) // the last spline touch the first, need the third color
+				color = colors[1];
+			const size_t begin = corners[s];
+			const size_t end = corners[(s + 1U) % countSplines];
+			size_t i = begin;
+			do
+			{
+				vEdges[i].color = color;
+				i = (i + 1U) % vCount;
+			} while (i != end);
+		}
+	}
+}
+
+static void FlattenEdge(const SdfEdgeStruct& vEdge, std::vector<SdfSegmentStruct>* vOutSegments)
+{
+	size_t countSegments = 1U;
+	if (vEdge.quad) // ~ one segment per 2 texels, the glyphs are small
+	{
+		const double len = Length(vEdge.c - vEdge.p0) + Length(vEdge.p1 - vEdge.c);
+		countSegments = (size_t)ct::mini(ct::maxi((int32_t)std::ceil(len * 0.5), 1), 8);
+	}
+
+	SdfVec2 last = vEdge.p0;
+	for (size_t i = 1U; i <= countSegments; ++i)
+	{
+		const double t = (double)i / (double)countSegments;
+		SdfVec2 p = vEdge.p1;
+		if (vEdge.quad && i < countSegments)
+		{
+			const double it = 1.0 - t;
+			p = vEdge.p0 * (it * it) + vEdge.c * (2.0 * it * t) + vEdge.p1 * (t * t);
+		}
+		SdfSegmentStruct seg;
+		seg.a = last;
+		seg.b = p;
+		seg.color = vEdge.color;
+		seg.edgeStart = (i == 1U);
+		seg.edgeEnd = (i == countSegments);
+		vOutSegments->push_back(seg);
+		last = p;
+	}
+}
+
+// nonzero rule
+static bool IsInside(const std::vector<SdfSegmentStruct>& vSegments, const SdfVec2& vP)
+{
+	int32_t winding = 0;
+	for (const auto& seg : vSegments)
+	{
+		const double side = Cross(seg.b - seg.a, vP - seg.a);
+		if (seg.a.y <= vP.y)
+		{
+			if (seg.b.y > vP.y && side > 0.0) ++winding;
+		}
+		else
+		{
+			if (seg.b.y <= vP.y && side < 0.0) --winding;
+		}
+	}
+	return winding != 0;
+}
+
+static void UpdateCandidate(SdfCandidateStruct* vCandidate, const SdfSegmentStruct& vSeg, const SdfVec2& vP)
+{
+	const SdfVec2 ab = vSeg.b - vSeg.a;
+	const double len2 = Dot(ab, ab);
+	const double t = len2 > 0.0 ? Dot(vP - vSeg.a, ab) / len2 : 0.0;
+	const double tc = ct::mini(ct::maxi(t, 0.0), 1.0);
+	const SdfVec2 q = vSeg.a + ab * tc;
+	const double distance = Length(vP - q);
+	// at a shared point, the more orthogonal segment is the right one
+	const double orthogonality = distance > 0.0 ? std::fabs(Cross(Normalize(ab), Normalize(vP - q))) : 1.0;
+
+	if (distance < vCandidate->distance - SDF_DISTANCE_EPSILON ||
+		(std::fabs(distance - vCandidate->distance) <= SDF_DISTANCE_EPSILON && orthogonality > vCandidate->orthogonality))
+	{
+		vCandidate->distance = distance;
+		vCandidate->orthogonality = orthogonality;
+		vCandidate->t = t;
+		vCandidate->segment = &vSeg;
+	}
+}
+
+// signed pseudo distance, > 0 inside, the segments at the ends of an edge are extended
+static double GetSignedPseudoDistance(const SdfCandidateStruct& vCandidate, const SdfVec2& vP, const double& vInsideSign)
+{
+	const auto seg = vCandidate.segment;
+	const SdfVec2 dir = Normalize(seg->b - seg->a);
+	const double side = Cross(dir, vP - seg->a) * vInsideSign;
+	if ((seg->edgeStart && vCandidate.t < 0.0) || (seg->edgeEnd && vCandidate.t > 1.0))
+		return side; // distance to the line of the segment
+	return side >= 0.0 ? vCandidate.distance : -vCandidate.distance;
+}
+
+static uint8_t DistanceToByte(const double& vSignedDistance, const double& vPxRange)
+{
+	const double v = 0.5 + vSignedDistance / vPxRange;
+	return (uint8_t)ct::mini(ct::maxi((int32_t)std::lround(v * 255.0), 0), 255);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool SdfGenerator::LoadGlyphOutline(std::shared_ptr<FontInfos> vFontInfos, const uint32_t& vCodePoint, SimpleGlyph_Solo* vOutGlyph)
+{
+	if (!vFontInfos || !vOutGlyph)
+		return false;
+
+	vOutGlyph->Clear();
+
+	auto sfntlyFontPtr = vFontInfos->GetSfntlyFont();
+	if (sfntlyFontPtr && sfntlyFontPtr->IsValid())
+	{
+		const int32_t glyphId = sfntlyFontPtr->m_CMapTable->GlyphId((int32_t)vCodePoint);
+		const int32_t length = sfntlyFontPtr->m_LocaTable->GlyphLength(glyphId);
+		const int32_t offset = sfntlyFontPtr->m_LocaTable->GlyphOffset(glyphId);
+		if (length > 0) // no outline for a space
+		{
+			sfntly::GlyphPtr glyph;
+			glyph.Attach(sfntlyFontPtr->m_GlyfTable->GetGlyph(offset, length));
+			if (glyph && glyph->GlyphType() == sfntly::GlyphType::kSimple)
+			{
+				auto sglyph = down_cast<sfntly::GlyphTable::SimpleGlyph*>(glyph.p_);
+				vOutGlyph->LoadSimpleGlyph(sglyph);
+			}
+		}
+	}
+
+	return vOutGlyph->isValid;
+}
+
+bool SdfGenerator::BakeAtlas(
+	const std::vector<std::shared_ptr<FontInfos>>& vFonts,
+	const PrebakedAtlasFormatEnum& vFormat,
+	const uint32_t& vGlyphSizeInPixel,
+	const float& vPxRange,
+	PrebakedAtlasStruct* vOutAtlas)
+{
+	GenerationStageScope stage("SdfGenerator::BakeAtlas");
+
+	if (vFonts.empty() || !vOutAtlas || !vGlyphSizeInPixel || vPxRange <= 0.0f ||
+		vFormat == PrebakedAtlasFormatEnum::PREBAKED_ATLAS_FORMAT_ALPHA8)
+		return false;
+
+	const bool msdf = (vFormat == PrebakedAtlasFormatEnum::PREBAKED_ATLAS_FORMAT_MSDF);
+
+	*vOutAtlas = PrebakedAtlasStruct();
+	vOutAtlas->format = vFormat;
+	vOutAtlas->channels = msdf ? 4U : 1U;
+	vOutAtlas->pxRange = vPxRange;
+	vOutAtlas->fontSize = (float)vGlyphSizeInPixel;
+
+	const int32_t padding = (int32_t)std::ceil(vPxRange * 0.5f) + 1;
+	const double pxRange = (double)vPxRange;
+
+	std::vector<std::vector<uint8_t>> bitmaps; // keep the glyph bitmaps until the packing
+	std::vector<PrebakedRectStruct> rects;
+	size_t countCompositeGlyphs = 0U;
+	bool firstFont = true;
+	double baseAscent = 0.0;
+
+	// for the progress of the generation, the distance fields are the long part
+	size_t countGlyphs = 0U, glyphIdx = 0U;
+	for (auto fontInfos : vFonts)
+	{
+		if (fontInfos)
+			countGlyphs += fontInfos->m_SelectedGlyphs.size();
+	}
+
+	for (auto fontInfos : vFonts)
+	{
+		if (!fontInfos) continue;
+
+		auto font = fontInfos->GetImFont();
+		const int32_t fontHeight = fontInfos->m_Ascent - fontInfos->m_Descent;
+		if (!font || font->FontSize <= 0.0f || fontHeight <= 0)
+		{
+			Messaging::Instance()->AddError(true, nullptr, nullptr,
+				"The font %s is not loaded. aborting.", fontInfos->m_FontFileName.c_str());
+			return false;
+		}
+
+		// font units to atlas texels, same pixel height convention as imgui
+		const double scale = (double)vGlyphSizeInPixel / (double)fontHeight;
+		if (firstFont)
+		{
+			baseAscent = fontInfos->m_Ascent * scale;
+			vOutAtlas->ascent = (float)baseAscent;
+			vOutAtlas->descent = (float)(fontInfos->m_Descent * scale);
+			firstFont = false;
+		}
+
+		const float advanceScale = (float)vGlyphSizeInPixel / font->FontSize;
+
+		for (const auto& it : fontInfos->m_SelectedGlyphs)
+		{
+			// the preview bake is not in a generation, so never cancelled
+			if (Generator::Instance()->CheckCancel())
+				return false;
+			Generator::Instance()->SetOutputProgress((float)(glyphIdx++) / (float)countGlyphs);
+
+			auto glyphInfos = it.second;
+			if (!glyphInfos) continue;
+
+			auto glyph = font->FindGlyphNoFallback((ImWchar)it.first);
+			if (!glyph) continue;
+
+			PrebakedGlyphStruct pg;
+			pg.codePoint = glyphInfos->newCodePoint ? glyphInfos->newCodePoint : it.first;
+			pg.advanceX = glyph->AdvanceX * advanceScale * glyphInfos->m_Scale.x;
+
+			SimpleGlyph_Solo outline;
+			if (!LoadGlyphOutline(fontInfos, it.first, &outline))
+			{
+				if (glyph->Visible)
+					++countCompositeGlyphs;
+				vOutAtlas->glyphs.push_back(pg);
+				continue;
+			}
+
+			// same transform as the font generation
+			outline.m_Translation = glyphInfos->m_Translation;
+			outline.m_Scale = glyphInfos->m_Scale;
+
+			std::vector<SdfEdgeStruct> edges;
+			std::vector<SdfSegmentStruct> segments;
+			double signedArea = 0.0;
+			for (int32_t c = 0; c < outline.GetCountContours(); ++c)
+			{
+				const size_t firstEdge = edges.size();
+				BuildContourEdges(outline, c, scale, &edges);
+				if (edges.size() > firstEdge)
+					ColorContourEdges(edges.data() + firstEdge, edges.size() - firstEdge);
+			}
+			for (const auto& edge : edges)
+			{
+				FlattenEdge(edge, &segments);
+			}
+			if (segments.empty())
+			{
+				vOutAtlas->glyphs.push_back(pg);
+				continue;
+			}
+
+			SdfVec2 minP(DBL_MAX, DBL_MAX), maxP(-DBL_MAX, -DBL_MAX);
+			for (const auto& seg : segments)
+			{
+				signedArea += Cross(seg.a, seg.b);
+				minP = SdfVec2(ct::mini(minP.x, seg.a.x), ct::mini(minP.y, seg.a.y));
+				maxP = SdfVec2(ct::maxi(maxP.x, seg.a.x), ct::maxi(maxP.y, seg.a.y));
+			}
+
+			// truetype outer contours are clockwise, so inside is on the right
+			// if the glyph is mirrored by the transform, the inside is on the left
+			const double insideSign = signedArea <= 0.0 ? -1.0 : 1.0;
+
+			const int32_t left = (int32_t)std::floor(minP.x) - padding;
+			const int32_t top = (int32_t)std::ceil(maxP.y) + padding; // y up
+			const uint32_t w = (uint32_t)((int32_t)std::ceil(maxP.x) - (int32_t)std::floor(minP.x) + padding * 2);
+			const uint32_t h = (uint32_t)((int32_t)std::ceil(maxP.y) - (int32_t)std::floor(minP.y) + padding * 2);
+
+			bitmaps.emplace_back((size_t)w * (size_t)h * vOutAtlas->channels, (uint8_t)0U);
+			auto& bitmap = bitmaps.back();
+
+			for (uint32_t y = 0U; y < h; ++y)
+			{
+				for (uint32_t x = 0U; x < w; ++x)
+				{
+					const SdfVec2 p(left + x + 0.5, top - (y + 0.5));
+
+					SdfCandidateStruct channels[3];
+					SdfCandidateStruct all;
+					for (const auto& seg : segments)
+					{
+						UpdateCandidate(&all, seg, p);
+						if (msdf)
+						{
+							if (seg.color & SDF_COLOR_RED) UpdateCandidate(&channels[0], seg, p);
+							if (seg.color & SDF_COLOR_GREEN) UpdateCandidate(&channels[1], seg, p);
+							if (seg.color & SDF_COLOR_BLUE) UpdateCandidate(&channels[2], seg, p);
+						}
+					}
+
+					const double trueDistance = IsInside(segments, p) ? all.distance : -all.distance;
+					uint8_t* texel = bitmap.data() + ((size_t)y * w + x) * vOutAtlas->channels;
+					if (msdf)
+					{
+						for (size_t ch = 0U; ch < 3U; ++ch)
+						{
+							const double d = channels[ch].segment ?
+								GetSignedPseudoDistance(channels[ch], p, insideSign) : trueDistance;
+							texel[ch] = DistanceToByte(d, pxRange);
+						}
+						texel[3] = DistanceToByte(trueDistance, pxRange);
+					}
+					else
+					{
+						texel[0] = DistanceToByte(trueDistance, pxRange);
+					}
+				}
+			}
+
+			// quad, y down from the top of the line
+			pg.x0 = (float)left;
+			pg.x1 = (float)(left + (int32_t)w);
+			pg.y0 = (float)(baseAscent - top);
+			pg.y1 = pg.y0 + (float)h;
+
+			PrebakedRectStruct rect;
+			rect.srcPixels = bitmap.data();
+			rect.srcPitch = w;
+			rect.srcBpp = vOutAtlas->channels;
+			rect.w = w;
+			rect.h = h;
+			rect.glyphIdx = vOutAtlas->glyphs.size();
+			rects.push_back(rect);
+
+			vOutAtlas->glyphs.push_back(pg);
+		}
+	}
+
+	if (countCompositeGlyphs)
+	{
+		Messaging::Instance()->AddWarning(true, nullptr, nullptr,
+			"%u composite glyph(s) are not supported in distance field atlas, only the advance is exported",
+			(uint32_t)countCompositeGlyphs);
+	}
+
+	// the rects point on the datas of the bitmaps
+	return AtlasGenerator::PackAtlas(rects, vOutAtlas);
+}
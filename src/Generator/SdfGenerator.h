@@ -0,0 +1,48 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+#include <Generator/AtlasGenerator.h>
+
+// distance field atlas, computed from the glyph outlines (glyf table via sfntly, see SimpleGlyph_Solo)
+// so not depend of the rasterizer, and one atlas can be drawn at any size with a shader
+// - sdf : true signed distance in one channel
+// - msdf : signed pseudo distance per channel, with the edges colored at the corners (like msdfgen, without the error correction)
+//   the true signed distance is in alpha
+// the distance is 0.5 on the outline, > 0.5 inside, and saturate at pxRange / 2 texels
+// composite glyphs are not supported (only the advance is exported)
+
+#define SDF_ATLAS_DEFAULT_GLYPH_SIZE 32U // glyph height in texels in the atlas
+#define SDF_ATLAS_DEFAULT_PX_RANGE 4.0f
+
+class FontInfos;
+class SimpleGlyph_Solo;
+class SdfGenerator
+{
+public:
+	// the first font give the metrics, the glyphs of the others are scaled to his size
+	static bool BakeAtlas(const std::vector<std::shared_ptr<FontInfos>>& vFonts,
+		const PrebakedAtlasFormatEnum& vFormat, const uint32_t& vGlyphSizeInPixel, const float& vPxRange,
+		PrebakedAtlasStruct* vOutAtlas);
+	// return false for the composite or empty glyphs
+	static bool LoadGlyphOutline(std::shared_ptr<FontInfos> vFontInfos, const uint32_t& vCodePoint,
+		SimpleGlyph_Solo* vOutGlyph);
+};
@@ -0,0 +1,120 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "EventLoopHelper.h"
+
+#include <ctools/cTools.h>
+#include <imgui/imgui.h>
+#include <GLFW/glfw3.h>
+
+// after an event, imgui need some frames to settle (hover, popups, window moves)
+#define EVENT_LOOP_ACTIVE_FRAMES_AFTER_EVENT 10
+// the shortest wait when idle, one frame at 60 fps, doubled each idle frame until m_MaxIdleWaitInSeconds
+#define EVENT_LOOP_MIN_IDLE_WAIT (1.0 / 60.0)
+
+void EventLoopHelper::WaitOrPollEvents()
+{
+	m_LastFrameWasIdle = false;
+
+	if (m_EventDriven && m_CountActiveFramesLeft <= 0)
+	{
+		m_CurrentWaitInSeconds = ct::clamp(m_CurrentWaitInSeconds * 2.0, EVENT_LOOP_MIN_IDLE_WAIT, (double)m_MaxIdleWaitInSeconds);
+
+		const double waitStart = glfwGetTime();
+		glfwWaitEventsTimeout(m_CurrentWaitInSeconds);
+		const double waitDuration = glfwGetTime() - waitStart;
+
+		if (waitDuration < m_CurrentWaitInSeconds)
+		{
+			// woken by an event, back to the full rate
+			RequestFrames(EVENT_LOOP_ACTIVE_FRAMES_AFTER_EVENT);
+		}
+		else
+		{
+			m_LastFrameWasIdle = true;
+		}
+	}
+	else
+	{
+		glfwPollEvents();
+
+		if (m_CountActiveFramesLeft > 0)
+		{
+			--m_CountActiveFramesLeft;
+		}
+	}
+
+	m_FrameStartTime = glfwGetTime();
+	m_LastFrameIntervalInMs = (m_FrameStartTime - m_LastFrameStartTime) * 1000.0;
+	m_LastFrameStartTime = m_FrameStartTime;
+}
+
+void EventLoopHelper::EndFrame()
+{
+	m_LastCpuFrameTimeInMs = (glfwGetTime() - m_FrameStartTime) * 1000.0;
+
+	if (IsImGuiActive())
+	{
+		RequestFrames(EVENT_LOOP_ACTIVE_FRAMES_AFTER_EVENT);
+	}
+}
+
+void EventLoopHelper::RequestFrames(int vCountFrames)
+{
+	m_CountActiveFramesLeft = ct::maxi(m_CountActiveFramesLeft, vCountFrames);
+	m_CurrentWaitInSeconds = 0.0; // the ramp restart from the shortest wait
+}
+
+void EventLoopHelper::WakeUp()
+{
+	glfwPostEmptyEvent();
+}
+
+std::string EventLoopHelper::GetFrameTimeInfos()
+{
+	if (m_EventDriven)
+	{
+		return ct::toStr("%.2f ms/frame (%s, %.0f ms between frames)",
+			m_LastCpuFrameTimeInMs, (m_CountActiveFramesLeft > 0 ? "active" : "idle"), m_LastFrameIntervalInMs);
+	}
+
+	const auto& io = ImGui::GetIO();
+	return ct::toStr("%.2f ms/frame (%.1f fps)", m_LastCpuFrameTimeInMs, io.Framerate);
+}
+
+// anything who can change without a new event
+bool EventLoopHelper::IsImGuiActive()
+{
+	const auto& io = ImGui::GetIO();
+
+	if (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f)
+		return true;
+	if (io.MouseWheel != 0.0f || io.MouseWheelH != 0.0f)
+		return true;
+	if (ImGui::IsAnyMouseDown())
+		return true;
+	if (ImGui::IsAnyItemActive())
+		return true;
+	if (io.InputQueueCharacters.Size > 0)
+		return true;
+	if (io.KeyCtrl || io.KeyShift || io.KeyAlt || io.KeySuper)
+		return true;
+
+	return false;
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+
+// main loop events and frame rate
+// in event driven mode, the loop wait for events when idle (glfwWaitEventsTimeout)
+// and come back to the vsync rate during an interaction, an action or an animation
+class EventLoopHelper
+{
+public:
+	bool m_EventDriven = true; // wait for events when idle, else poll events each frame (vsync rate)
+	float m_MaxIdleWaitInSeconds = 1.0f; // max wait when idle, the app is redrawn at least at this rate
+
+private:
+	int m_CountActiveFramesLeft = 0; // frames to draw at full rate before wait for events
+	double m_CurrentWaitInSeconds = 0.0; // ramp from one vsync frame to m_MaxIdleWaitInSeconds
+	double m_FrameStartTime = 0.0;
+	double m_LastFrameStartTime = 0.0;
+	double m_LastCpuFrameTimeInMs = 0.0; // time of the last frame, from events to swap, without the wait
+	double m_LastFrameIntervalInMs = 0.0; // time between two frames, with the wait
+	bool m_LastFrameWasIdle = false;
+
+public:
+	// replace glfwPollEvents, to call before the frame
+	void WaitOrPollEvents();
+	// to call after the swap buffers, check the imgui activity for the next frames
+	void EndFrame();
+	// a task, an action or an animation need some frames at full rate
+	void RequestFrames(int vCountFrames = 1);
+	// wake the main loop from another thread (glfwPostEmptyEvent)
+	void WakeUp();
+
+	std::string GetFrameTimeInfos();
+	bool IsIdle() const { return m_LastFrameWasIdle; }
+
+private:
+	bool IsImGuiActive();
+
+public: // singleton
+	static EventLoopHelper* Instance()
+	{
+		static EventLoopHelper _instance;
+		return &_instance;
+	}
+
+protected:
+	EventLoopHelper() = default; // Prevent construction
+	EventLoopHelper(const EventLoopHelper&) {}; // Prevent construction by copying
+	EventLoopHelper& operator =(const EventLoopHelper&) { return *this; }; // Prevent assignment
+	~EventLoopHelper() = default; // Prevent unwanted destruction
+};
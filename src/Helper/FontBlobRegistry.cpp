@@ -0,0 +1,250 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FontBlobRegistry.h"
+
+#include <cstdio>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+//// FONT BLOB ////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+FontBlob::FontBlob() = default;
+
+FontBlob::~FontBlob()
+{
+	UnMap();
+}
+
+bool FontBlob::Map(const std::string& vFilePathName, const size_t& vSize)
+{
+	UnMap();
+
+	if (vSize == 0U)
+		return false;
+
+#ifdef _WIN32
+	HANDLE file = CreateFileA(vFilePathName.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file != INVALID_HANDLE_VALUE)
+	{
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping)
+		{
+			void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if (view)
+			{
+				m_FileHandle = file;
+				m_MappingHandle = mapping;
+				m_Datas = (const uint8_t*)view;
+				m_Size = vSize;
+				return true;
+			}
+			CloseHandle(mapping);
+		}
+		CloseHandle(file);
+	}
+#else
+	int fd = open(vFilePathName.c_str(), O_RDONLY);
+	if (fd >= 0)
+	{
+		void* view = mmap(nullptr, vSize, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd); // the mapping keep a ref on the file
+		if (view != MAP_FAILED)
+		{
+			m_Datas = (const uint8_t*)view;
+			m_Size = vSize;
+			return true;
+		}
+	}
+#endif
+
+	// mapping not possible, we read the file
+	return Read(vFilePathName, vSize);
+}
+
+bool FontBlob::Read(const std::string& vFilePathName, const size_t& vSize)
+{
+	UnMap();
+
+	if (vSize == 0U)
+		return false;
+
+	FILE* fp = nullptr;
+#ifdef _MSC_VER
+	if (fopen_s(&fp, vFilePathName.c_str(), "rb") != 0)
+		fp = nullptr;
+#else
+	fp = fopen(vFilePathName.c_str(), "rb");
+#endif
+	if (fp)
+	{
+		m_OwnedDatas.resize(vSize);
+		const size_t readSize = fread(m_OwnedDatas.data(), 1, vSize, fp);
+		fclose(fp);
+		if (readSize == vSize)
+		{
+			m_Datas = m_OwnedDatas.data();
+			m_Size = vSize;
+			return true;
+		}
+		m_OwnedDatas.clear();
+	}
+
+	return false;
+}
+
+void FontBlob::UnMap()
+{
+	if (IsMapped())
+	{
+#ifdef _WIN32
+		UnmapViewOfFile(m_Datas);
+		if (m_MappingHandle)
+			CloseHandle((HANDLE)m_MappingHandle);
+		if (m_FileHandle)
+			CloseHandle((HANDLE)m_FileHandle);
+		m_MappingHandle = nullptr;
+		m_FileHandle = nullptr;
+#else
+		munmap((void*)m_Datas, m_Size);
+#endif
+	}
+
+	m_OwnedDatas.clear();
+	m_Datas = nullptr;
+	m_Size = 0U;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//// REGISTRY /////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<const FontBlob> FontBlobRegistry::GetBlob(const std::string& vFilePathName)
+{
+	return GetOrCreateBlob(vFilePathName, false);
+}
+
+std::shared_ptr<const FontBlob> FontBlobRegistry::GetOwnedBlob(const std::string& vFilePathName)
+{
+	return GetOrCreateBlob(vFilePathName, true);
+}
+
+void FontBlobRegistry::Invalidate(const std::string& vFilePathName)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_Blobs.erase(vFilePathName);
+	m_OwnedBlobs.erase(vFilePathName);
+}
+
+size_t FontBlobRegistry::GetCountMappedBlobs()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	size_t count = 0U;
+	for (auto it = m_Blobs.begin(); it != m_Blobs.end();)
+	{
+		if (it->second.expired())
+		{
+			it = m_Blobs.erase(it);
+		}
+		else
+		{
+			++count;
+			++it;
+		}
+	}
+	return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//// PRIVATE //////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+std::shared_ptr<const FontBlob> FontBlobRegistry::GetOrCreateBlob(const std::string& vFilePathName, const bool& vOwned)
+{
+	int64_t modificationTime = 0;
+	size_t size = 0U;
+	if (!GetFileStat(vFilePathName, &modificationTime, &size))
+		return nullptr;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+
+	auto& blobs = vOwned ? m_OwnedBlobs : m_Blobs;
+	auto it = blobs.find(vFilePathName);
+	if (it != blobs.end())
+	{
+		auto blobPtr = it->second.lock();
+		if (blobPtr &&
+			blobPtr->m_ModificationTime == modificationTime &&
+			blobPtr->m_Size == size)
+		{
+			return blobPtr;
+		}
+	}
+
+	// not loaded, released or modified on disk
+	auto blobPtr = std::make_shared<FontBlob>();
+	if (vOwned ? blobPtr->Read(vFilePathName, size) : blobPtr->Map(vFilePathName, size))
+	{
+		blobPtr->m_FilePathName = vFilePathName;
+		blobPtr->m_ModificationTime = modificationTime;
+		blobs[vFilePathName] = blobPtr;
+		return blobPtr;
+	}
+
+	blobs.erase(vFilePathName);
+	return nullptr;
+}
+
+bool FontBlobRegistry::GetFileStat(const std::string& vFilePathName, int64_t* vModificationTime, size_t* vSize)
+{
+	if (vFilePathName.empty() || !vModificationTime || !vSize)
+		return false;
+
+#ifdef _WIN32
+	struct _stat64 st;
+	if (_stat64(vFilePathName.c_str(), &st) != 0)
+		return false;
+#else
+	struct stat st;
+	if (stat(vFilePathName.c_str(), &st) != 0)
+		return false;
+#endif
+
+	*vModificationTime = (int64_t)st.st_mtime;
+	*vSize = (size_t)st.st_size;
+	return true;
+}
@@ -0,0 +1,99 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+
+// read only view on a font file, mapped in memory or copied (owned)
+// the mapping live as long as one view is alive
+// a mapping is only for short read only accesses : a file truncated or rewritten on disk
+// make the access of the mapped pages fail (SIGBUS), and on windows the file can't be rewritten while mapped
+class FontBlob
+{
+	friend class FontBlobRegistry;
+
+private:
+	const uint8_t* m_Datas = nullptr;
+	size_t m_Size = 0U;
+	std::string m_FilePathName;
+	int64_t m_ModificationTime = 0;
+	std::vector<uint8_t> m_OwnedDatas; // owned copy, or if the mapping fail
+#ifdef _WIN32
+	void* m_FileHandle = nullptr;
+	void* m_MappingHandle = nullptr;
+#endif
+
+public:
+	FontBlob();
+	~FontBlob();
+
+	FontBlob(const FontBlob&) = delete;
+	FontBlob& operator =(const FontBlob&) = delete;
+
+	const uint8_t* GetDatas() const { return m_Datas; }
+	size_t GetSize() const { return m_Size; }
+	const std::string& GetFilePathName() const { return m_FilePathName; }
+	int64_t GetModificationTime() const { return m_ModificationTime; }
+	bool IsValid() const { return (m_Datas != nullptr && m_Size > 0U); }
+	bool IsMapped() const { return (m_Datas != nullptr && m_OwnedDatas.empty()); }
+
+private:
+	bool Map(const std::string& vFilePathName, const size_t& vSize);
+	bool Read(const std::string& vFilePathName, const size_t& vSize);
+	void UnMap();
+};
+
+// each font file is mapped or copied one time and shared
+// - GetBlob : mapped, for the short read only accesses (hash of the file)
+// - GetOwnedBlob : copied in memory, for the views kept alive (atlas, sfntly, FontParser, FontGenerator)
+//   the file can be rewritten by an editor or by the generator without touching them
+// a file modified on disk (mtime or size change) is mapped / copied again at the next request
+// the views already given keep the old datas until released
+class FontBlobRegistry
+{
+private:
+	std::mutex m_Mutex;
+	std::map<std::string, std::weak_ptr<const FontBlob>> m_Blobs;
+	std::map<std::string, std::weak_ptr<const FontBlob>> m_OwnedBlobs;
+
+public:
+	std::shared_ptr<const FontBlob> GetBlob(const std::string& vFilePathName);
+	std::shared_ptr<const FontBlob> GetOwnedBlob(const std::string& vFilePathName);
+	void Invalidate(const std::string& vFilePathName);
+	size_t GetCountMappedBlobs();
+
+private:
+	std::shared_ptr<const FontBlob> GetOrCreateBlob(const std::string& vFilePathName, const bool& vOwned);
+	static bool GetFileStat(const std::string& vFilePathName, int64_t* vModificationTime, size_t* vSize);
+
+public: // singleton
+	static FontBlobRegistry* Instance()
+	{
+		static FontBlobRegistry _instance;
+		return &_instance;
+	}
+
+protected:
+	FontBlobRegistry() = default; // Prevent construction
+	FontBlobRegistry(const FontBlobRegistry&) {}; // Prevent construction by copying
+	FontBlobRegistry& operator =(const FontBlobRegistry&) { return *this; }; // Prevent assignment
+	~FontBlobRegistry() = default; // Prevent unwanted destruction
+};
@@ -19,6 +19,8 @@
 
  
 #include "FontParser.h"
+#include <Helper/FontBlobRegistry.h>
+#include <Gui/ImWidgets.h>
 #include <ctools/FileHelper.h>
 #include <imgui/imgui.h>
 #include <ctools/cTools.h>
@@ -37,6 +39,12 @@ void TableDisplay::AddItem(std::string vItem, std::string vSize, std::string vIn
 	arr.push_back(vInfos);
 	array.push_back(arr);
 }
+
+void TableDisplay::GetVirtualRow(size_t /*vIdx*/, std::string& /*vItem*/, std::string& /*vSize*/, std::string& /*vInfos*/)
+{
+
+}
+
 void TableDisplay::DisplayTable(const char* vTableLabel, size_t vMaxCount)
 {
 	ImGuiTableFlags flags = ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders;
@@ -55,6 +63,30 @@ void TableDisplay::DisplayTable(const char* vTableLabel, size_t vMaxCount)
 		ImGui::TableSetupColumn("Infos", ImGuiTableColumnFlags_WidthStretch, -1, 1);
 		ImGui::TableHeadersRow(); // draw headers
 
+		if (m_CountVirtualRows)
+		{
+			std::string item, size, infos;
+			m_Clipper.Begin((int)m_CountVirtualRows, ImGui::GetTextLineHeightWithSpacing());
+			while (m_Clipper.Step())
+			{
+				for (int i = m_Clipper.DisplayStart; i < m_Clipper.DisplayEnd; i++)
+				{
+					if (i < 0) continue;
+
+					GetVirtualRow((size_t)i, item, size, infos);
+
+					ImGui::TableNextRow();
+					if (ImGui::TableSetColumnIndex(0)) ImGui::Text("%s", item.c_str());
+					if (ImGui::TableSetColumnIndex(1)) ImGui::Text("%s", size.c_str());
+					if (ImGui::TableSetColumnIndex(2)) ImGui::Text("%s", infos.c_str());
+				}
+			}
+
+			ImGui::EndTable();
+
+			return;
+		}
+
 		m_Clipper.Begin((int)array.size(), ImGui::GetTextLineHeightWithSpacing());
 		while (m_Clipper.Step())
 		{
@@ -62,11 +94,11 @@ void TableDisplay::DisplayTable(const char* vTableLabel, size_t vMaxCount)
 			{
 				if (i < 0) continue;
 
-				auto line = array[i];
+				const auto& line = array[i];
 
 				ImGui::TableNextRow();
 				int idx = 0;
-				for (auto column : line)
+				for (const auto& column : line)
 				{
 					if (idx > 2) break; //3 columns max
 					if (ImGui::TableSetColumnIndex(idx++))
@@ -129,7 +161,13 @@ int FontAnalyser::TableStruct::draw(int vWidgetId)
 {
 	ImGui::PushID(++vWidgetId);
 
-	if (ImGui::TreeNode(&tag, "Table : %s", tag))
+	const bool opened = ImGui::TreeNode(&tag, "Table : %s", tag);
+	if (!checkSumValid)
+	{
+		ImGui::SameLine();
+		ImGui::TextColored(ImGui::CustomStyle::BadColor, "(checksum mismatch)");
+	}
+	if (opened)
 	{
 		DisplayTable("Table s");
 
@@ -163,6 +201,17 @@ void FontAnalyser::TableStruct::parse(MemoryStream *vMem)
 	}
 }
 
+void FontAnalyser::TableStruct::validate(const FontTableChecksumStruct& vChecksum)
+{
+	computedCheckSum = vChecksum.computedCheckSum;
+	checkSumValid = vChecksum.IsValid();
+
+	if (vChecksum.inBounds)
+		AddItem("computed checkSum", "", ct::toStr("%u%s", computedCheckSum, (checkSumValid ? "" : " (mismatch)")));
+	else
+		AddItem("computed checkSum", "", "table out of file");
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
@@ -469,32 +518,39 @@ void FontAnalyser::locaTableStruct::parse(MemoryStream* vMem, size_t vOffset, si
 
 		if (head->indexToLocFormat == 0) // short format
 		{
-			for (int i = 0; i < maxp->numGlyphs; i++)
+			std::vector<uint16_t> shortOffsets(maxp->numGlyphs);
+			shortOffsets.resize(vMem->ReadUShorts(shortOffsets.data(), shortOffsets.size()));
+			offsets.resize(shortOffsets.size());
+			for (size_t i = 0; i < shortOffsets.size(); i++)
 			{
-				offsets.push_back(((uint32_t)vMem->ReadUShort()) * 2);
+				offsets[i] = ((uint32_t)shortOffsets[i]) * 2;
 			}
 		}
 		else if (head->indexToLocFormat == 1) // long format
 		{
-			for (int i = 0; i < maxp->numGlyphs; i++)
-			{
-				offsets.push_back((uint32_t)vMem->ReadULong());
-			}
+			offsets.resize(maxp->numGlyphs);
+			offsets.resize(vMem->ReadULongs(offsets.data(), offsets.size()));
 		}
 
+		// the rows are formated by GetVirtualRow, only when visible
+		m_CountVirtualRows = offsets.size();
+	}
+}
+
+void FontAnalyser::locaTableStruct::GetVirtualRow(size_t vIdx, std::string& vItem, std::string& vSize, std::string& vInfos)
+{
+	if (vIdx < offsets.size() && head)
+	{
+		vItem = "offsets";
 		if (head->indexToLocFormat == 0) // short format
 		{
-			for (auto& it : offsets)
-			{
-				AddItem("offsets", "(2 bytes)", ct::toStr("%hu", it));
-			}
+			vSize = "(2 bytes)";
+			vInfos = ct::toStr("%hu", offsets[vIdx]);
 		}
-		else if (head->indexToLocFormat == 1) // long format
+		else // long format
 		{
-			for (auto& it : offsets)
-			{
-				AddItem("offsets", "(4 bytes)", ct::toStr("%u", it));
-			}
+			vSize = "(4 bytes)";
+			vInfos = ct::toStr("%u", offsets[vIdx]);
 		}
 	}
 }
@@ -1077,17 +1133,13 @@ void FontAnalyser::simpleGlyphTableStruct::parse(MemoryStream *vMem, size_t /*vO
 		{
 			filled = true;
 			
-			for (int i = 0; i < vCountContours; i++)
-			{
-				endPtsOfContours.push_back((uint16_t)vMem->ReadShort());
-			}
+			endPtsOfContours.resize(vCountContours);
+			endPtsOfContours.resize(vMem->ReadUShorts(endPtsOfContours.data(), endPtsOfContours.size()));
 
 			instructionLength = (uint16_t)vMem->ReadUShort();
 			
-			for (int i = 0; i < instructionLength; i++)
-			{
-				instructions.push_back(vMem->ReadByte());
-			}
+			instructions.resize(instructionLength);
+			instructions.resize(vMem->ReadBytes(instructions.data(), instructions.size()));
 			
 			if (!endPtsOfContours.empty())
 			{
@@ -1140,6 +1192,9 @@ int FontAnalyser::glyfStruct::draw(int vWidgetId)
 
 	if (ImGui::TreeNode("glyf :"))
 	{
+		if (!dataParsed)
+			parseDatas();
+
 		DisplayTable("glyf");
 
 		vWidgetId = simpleGlyph.draw(vWidgetId);
@@ -1152,6 +1207,7 @@ int FontAnalyser::glyfStruct::draw(int vWidgetId)
 	return vWidgetId;
 }
 
+// only the glyph header, the datas will be parsed by parseDatas at need
 void FontAnalyser::glyfStruct::parse(MemoryStream *vMem, size_t vOffset, size_t vLength)
 {
 	if (vMem)
@@ -1164,20 +1220,34 @@ void FontAnalyser::glyfStruct::parse(MemoryStream *vMem, size_t vOffset, size_t
 		xMax = vMem->ReadFWord();
 		yMax = vMem->ReadFWord();
 
+		mem = vMem;
+		dataOffset = vMem->GetPos();
+		dataLength = (vLength > 10U) ? vLength - 10U : 0U; // 10 bytes of header
+
+		AddItem("numberOfContours", "(2 bytes)", ct::toStr("%hi", numberOfContours));
+		AddItem("xMin", "(2 bytes)", ct::toStr("%hi", xMin));
+		AddItem("yMin", "(2 bytes)", ct::toStr("%hi", yMin));
+		AddItem("xMax", "(2 bytes)", ct::toStr("%hi", xMax));
+		AddItem("yMax", "(2 bytes)", ct::toStr("%hi", yMax));
+	}
+}
+
+void FontAnalyser::glyfStruct::parseDatas()
+{
+	dataParsed = true;
+
+	if (mem)
+	{
+		mem->SetPos(dataOffset);
+
 		if (numberOfContours >= 0)
 		{
-			simpleGlyph.parse(vMem, vMem->GetPos(), vLength - vMem->GetPos(), numberOfContours);
+			simpleGlyph.parse(mem, dataOffset, dataLength, numberOfContours);
 		}
 		else // compound
 		{
-			compositeGlyph.parse(vMem, vMem->GetPos(), vLength - vMem->GetPos(), numberOfContours);
+			compositeGlyph.parse(mem, dataOffset, dataLength, numberOfContours);
 		}
-
-		AddItem("numberOfContours", "(2 bytes)", ct::toStr("%hu", numberOfContours));
-		AddItem("xMin", "(2 bytes)", ct::toStr("%hi", xMin));
-		AddItem("yMin", "(2 bytes)", ct::toStr("%hi", yMin));
-		AddItem("xMax", "(2 bytes)", ct::toStr("%hi", xMax));
-		AddItem("yMax", "(2 bytes)", ct::toStr("%hi", yMax));
 	}
 }
 
@@ -1189,17 +1259,21 @@ int FontAnalyser::glyfTableStruct::draw(int vWidgetId)
 
 	if (ImGui::TreeNode("glyf Table :"))
 	{
-		if (!glyfs.empty())
+		if (loca && !loca->offsets.empty())
 		{
 			ImGuiListClipper clipper;
-			clipper.Begin((int)glyfs.size(), ImGui::GetTextLineHeightWithSpacing());
+			clipper.Begin((int)loca->offsets.size(), ImGui::GetTextLineHeightWithSpacing());
 			while (clipper.Step())
 			{
 				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
 				{
 					if (i < 0) continue;
 
-					vWidgetId = glyfs[i].draw(vWidgetId);
+					auto glyfPtr = getGlyf((size_t)i);
+					if (glyfPtr)
+					{
+						vWidgetId = glyfPtr->draw(vWidgetId);
+					}
 				}
 			}
 		}
@@ -1214,23 +1288,36 @@ int FontAnalyser::glyfTableStruct::draw(int vWidgetId)
 	return vWidgetId;
 }
 
-void FontAnalyser::glyfTableStruct::parse(MemoryStream *vMem, size_t vOffset, size_t /*vLength*/)
+// the glyphs are not parsed here, but by getGlyf when visible
+void FontAnalyser::glyfTableStruct::parse(MemoryStream *vMem, size_t vOffset, size_t vLength)
 {
-	if (vMem && loca)
-	{
-		int offset = 0;
-		int length = 0;
-		for (auto & it : loca->offsets)
-		{
-			offset = it;
-			
-			glyfStruct glyf;
-			glyf.parse(vMem, vOffset + offset, length);
-			glyfs.push_back(glyf);
+	mem = vMem;
+	tableOffset = vOffset;
+	tableLength = vLength;
+	glyfs.clear();
+}
 
-			length = offset;
-		}
+FontAnalyser::glyfStruct* FontAnalyser::glyfTableStruct::getGlyf(size_t vGlyphId)
+{
+	if (!mem || !loca || vGlyphId >= loca->offsets.size())
+		return nullptr;
+
+	auto it = glyfs.find(vGlyphId);
+	if (it != glyfs.end())
+		return &it->second;
+
+	const size_t offset = loca->offsets[vGlyphId];
+	size_t nextOffset = tableLength;
+	if (vGlyphId + 1U < loca->offsets.size())
+		nextOffset = loca->offsets[vGlyphId + 1U];
+	const size_t length = (nextOffset > offset) ? nextOffset - offset : 0U;
+
+	auto& glyf = glyfs[vGlyphId];
+	if (length && offset < tableLength)
+	{
+		glyf.parse(mem, tableOffset + offset, length);
 	}
+	return &glyf;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1327,25 +1414,17 @@ void FontAnalyser::cmapSubTableF4Struct::parse(MemoryStream *vMem, size_t /*vOff
 		AddItem("entrySelector", "(2 bytes)", ct::toStr("%hu", entrySelector));
 		AddItem("rangeShift", "(2 bytes)", ct::toStr("%hu", rangeShift));
 		
-		int segCount = segCountX2 / 2;
-		for (int i = 0; i < segCount; i++)
-		{
-			endCode.push_back((uint16_t)vMem->ReadUShort());
-		}
+		const size_t segCount = segCountX2 / 2;
+		endCode.resize(segCount);
+		endCode.resize(vMem->ReadUShorts(endCode.data(), segCount));
 		reservedPad = (uint16_t)vMem->ReadUShort();
 		AddItem("reservedPad", "(2 bytes)", ct::toStr("%hu", reservedPad));
-		for (int i = 0; i < segCount; i++)
-		{
-			startCode.push_back((uint16_t)vMem->ReadUShort());
-		}
-		for (int i = 0; i < segCount; i++)
-		{
-			idDelta.push_back((uint16_t)vMem->ReadShort());
-		}
-		for (int i = 0; i < segCount; i++)
-		{
-			idRangeOffset.push_back((uint16_t)vMem->ReadUShort());
-		}
+		startCode.resize(segCount);
+		startCode.resize(vMem->ReadUShorts(startCode.data(), segCount));
+		idDelta.resize(segCount);
+		idDelta.resize(vMem->ReadShorts(idDelta.data(), segCount));
+		idRangeOffset.resize(segCount);
+		idRangeOffset.resize(vMem->ReadUShorts(idRangeOffset.data(), segCount));
 
 		
 	}
@@ -1642,10 +1721,8 @@ void FontAnalyser::postTableF2Struct::parse(MemoryStream *vMem, size_t vOffset,
 
 		if (numberOfGlyphs)
 		{
-			for (int i = 0; i < numberOfGlyphs; i++)
-			{
-				glyphNameIndex.push_back((uint16_t)vMem->ReadUShort());
-			}
+			glyphNameIndex.resize(numberOfGlyphs);
+			glyphNameIndex.resize(vMem->ReadUShorts(glyphNameIndex.data(), numberOfGlyphs));
 
 			size_t endPos = vOffset + vLength;
 
@@ -1742,80 +1819,181 @@ int FontAnalyser::FontAnalyzedStruct::draw(int vWidgetId)
 	if (parsed)
 	{
 		vWidgetId = header.draw(vWidgetId);
+		drawChecksumReport();
 		ImGui::Separator();
 		for (auto & it : tables)
 		{
 			vWidgetId = it.second.draw(vWidgetId);
 		}
 		ImGui::Separator();
-#define DRAW_TABLE(_tag_, _class_) if (it.first == _tag_) vWidgetId = _class_.draw(vWidgetId)
-#define ELSE_DRAW_TABLE(_tag_, _class_) else DRAW_TABLE(_tag_, _class_)
 
 		for (auto & it : tables)
 		{
-			DRAW_TABLE("head", head);
-			ELSE_DRAW_TABLE("name", name);
-			ELSE_DRAW_TABLE("maxp", maxp);
-			ELSE_DRAW_TABLE("cmap", cmap);
-			ELSE_DRAW_TABLE("loca", loca);
-			ELSE_DRAW_TABLE("post", post);
-			ELSE_DRAW_TABLE("glyf", glyf);
-			ELSE_DRAW_TABLE("COLR", colr);
-			ELSE_DRAW_TABLE("CPAL", cpal);
+			drawTable(it.first);
+		}
+	}
+
+	return vWidgetId;
+}
+
+void FontAnalyser::FontAnalyzedStruct::drawChecksumReport()
+{
+	if (checksumReport.countBadTables)
+		ImGui::TextColored(ImGui::CustomStyle::BadColor, "Checksums : %u bad tables on %u",
+			(uint32_t)checksumReport.countBadTables, (uint32_t)checksumReport.tables.size());
+	else
+		ImGui::TextColored(ImGui::CustomStyle::GoodColor, "Checksums : %u tables ok",
+			(uint32_t)checksumReport.tables.size());
+
+	if (checksumReport.headFound)
+	{
+		if (checksumReport.IsAdjustmentValid())
+			ImGui::TextColored(ImGui::CustomStyle::GoodColor, "head checkSumAdjustment : ok");
+		else
+			ImGui::TextColored(ImGui::CustomStyle::BadColor, "head checkSumAdjustment : 0x%08X, expected 0x%08X",
+				checksumReport.storedAdjustment, checksumReport.computedAdjustment);
+	}
+
+	ImGui::Text("Validated %.1f KB in %.3f ms (%.1f MB/s)",
+		(double)checksumReport.fileSize / 1024.0, checksumReport.computeTimeInMs, checksumReport.GetThroughputInMBs());
+}
+
+// each table have his own id scope, so the node of a table keep his state
+// between the lazy node (not parsed) and the table node (parsed)
+int FontAnalyser::FontAnalyzedStruct::drawTable(const std::string& vTag)
+{
+	static const std::set<std::string> _supportedTables =
+	{
+		"head", "name", "maxp", "cmap", "loca", "post", "glyf", "COLR", "CPAL"
+	};
+
+	if (_supportedTables.find(vTag) == _supportedTables.end())
+		return 0;
+
+	int tableWidgetId = 0;
+
+	ImGui::PushID(vTag.c_str());
+
+	if (parsedTables.find(vTag) == parsedTables.end())
+	{
+		// same id as the first widget of the table draw
+		ImGui::PushID(tableWidgetId + 1);
+		if (ImGui::TreeNode((vTag + " Table :").c_str()))
+		{
+			parseTable(vTag);
+			ImGui::TreePop();
 		}
+		ImGui::PopID();
+	}
+	else
+	{
+#define DRAW_TABLE(_tag_, _class_) if (vTag == _tag_) tableWidgetId = _class_.draw(tableWidgetId)
+#define ELSE_DRAW_TABLE(_tag_, _class_) else DRAW_TABLE(_tag_, _class_)
+
+		DRAW_TABLE("head", head);
+		ELSE_DRAW_TABLE("name", name);
+		ELSE_DRAW_TABLE("maxp", maxp);
+		ELSE_DRAW_TABLE("cmap", cmap);
+		ELSE_DRAW_TABLE("loca", loca);
+		ELSE_DRAW_TABLE("post", post);
+		ELSE_DRAW_TABLE("glyf", glyf);
+		ELSE_DRAW_TABLE("COLR", colr);
+		ELSE_DRAW_TABLE("CPAL", cpal);
 
 #undef DRAW_TABLE
 #undef ELSE_DRAW_TABLE
 	}
 
-	return vWidgetId;
-}
+	ImGui::PopID();
 
+	return tableWidgetId;
+}
 
-void FontAnalyser::FontAnalyzedStruct::parse(MemoryStream *vMem)
+// only the header and the table directory, the tables are parsed by parseTable at need
+bool FontAnalyser::FontAnalyzedStruct::parse(const uint8_t* vDatas, size_t vSize)
 {
-	if (vMem)
+	if (vDatas && vSize >= 12U) // offset subtable
 	{
-#define IF_TABLE(_tag_) if (tables.find(_tag_) != tables.end())
-#define PARSE_TABLE(_tag_, _class_) _class_.parse(vMem, tables[_tag_].offset, tables[_tag_].length)
+		mem.SetView(vDatas, vSize); // no copy, the datas are kept alive by the FontParser
+
+		header.parse(&mem);
 
-		header.parse(vMem);
+		// 16 bytes per table record, after the offset subtable
+		if (header.numTables == 0 || 12U + 16U * (size_t)header.numTables > vSize)
+			return false; // not a font or truncated
 
 		for (int i = 0; i < header.numTables; i++)
 		{
 			TableStruct tbl;
-			tbl.parse(vMem);
+			tbl.parse(&mem);
 			tables[std::string((char*)tbl.tag)] = tbl;
 		}
 
-		IF_TABLE("head") PARSE_TABLE("head", head);
-		IF_TABLE("name") PARSE_TABLE("name", name);
-		IF_TABLE("maxp") PARSE_TABLE("maxp", maxp);
-		IF_TABLE("cmap") PARSE_TABLE("cmap", cmap);
-		IF_TABLE("post") PARSE_TABLE("post", post);
-		IF_TABLE("loca")
+		// the checksums need all the datas, but no table parsing
+		FontChecksum::ValidateFont(vDatas, vSize, &checksumReport);
+		for (const auto& checksum : checksumReport.tables)
 		{
-			IF_TABLE("head") IF_TABLE("maxp")
+			auto it = tables.find(checksum.tag);
+			if (it != tables.end())
 			{
-				loca.head = &head;
-				loca.maxp = &maxp;
-				PARSE_TABLE("loca", loca);
-			}
-			IF_TABLE("head")
-			{
-				glyf.loca = &loca;
-				PARSE_TABLE("glyf", glyf);
+				it->second.validate(checksum);
 			}
 		}
-		IF_TABLE("COLR") PARSE_TABLE("COLR", colr);
-		IF_TABLE("CPAL") PARSE_TABLE("CPAL", cpal);
 
-#undef PARSE_TABLE
-#undef IF_TABLE
+		/////////////////////////////
+		parsed = true;
+	}
+
+	return parsed;
+}
+
+void FontAnalyser::FontAnalyzedStruct::parseTable(const std::string& vTag)
+{
+	if (!parsed || parsedTables.find(vTag) != parsedTables.end())
+		return;
+
+	auto it = tables.find(vTag);
+	if (it == tables.end())
+		return;
+
+	parsedTables.emplace(vTag);
+
+	const size_t offset = it->second.offset;
+	const size_t length = it->second.length;
+	if (offset + length > mem.Size())
+		return; // bad table directory
+
+#define PARSE_TABLE(_tag_, _class_) if (vTag == _tag_) _class_.parse(&mem, offset, length)
+
+	PARSE_TABLE("head", head);
+	else PARSE_TABLE("name", name);
+	else PARSE_TABLE("maxp", maxp);
+	else PARSE_TABLE("cmap", cmap);
+	else PARSE_TABLE("post", post);
+	else if (vTag == "loca")
+	{
+		// need head (indexToLocFormat) and maxp (numGlyphs)
+		if (tables.find("head") != tables.end() &&
+			tables.find("maxp") != tables.end())
+		{
+			parseTable("head");
+			parseTable("maxp");
+			loca.head = &head;
+			loca.maxp = &maxp;
+			PARSE_TABLE("loca", loca);
+		}
+	}
+	else if (vTag == "glyf")
+	{
+		// need loca for the glyphs offsets
+		parseTable("loca");
+		glyf.loca = &loca;
+		PARSE_TABLE("glyf", glyf);
 	}
+	else PARSE_TABLE("COLR", colr);
+	else PARSE_TABLE("CPAL", cpal);
 
-	/////////////////////////////
-	parsed = true;
+#undef PARSE_TABLE
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -1832,17 +2010,18 @@ FontParser::~FontParser()
 
 }
 
-void FontParser::ParseFont(const std::string& vFilePathName)
+// return false if the file can't be read or is not a font
+bool FontParser::ParseFont(const std::string& vFilePathName)
 {
-	auto arrBytes = FileHelper::Instance()->LoadFileToBytes(vFilePathName);
-	if (!arrBytes.empty())
+	auto blobPtr = FontBlobRegistry::Instance()->GetOwnedBlob(vFilePathName); // the tables are parsed lazily, so kept alive
+	if (blobPtr)
 	{
-		MemoryStream mem;
-		mem.Set(arrBytes.data(), arrBytes.size());
-		
 		m_FontAnalyzed = {}; // re init
-		m_FontAnalyzed.parse(&mem);
+		m_FontBlob = blobPtr; // the analyzed struct is a view on it
+		return m_FontAnalyzed.parse(m_FontBlob->GetDatas(), m_FontBlob->GetSize());
 	}
+
+	return false;
 }
 
 int FontParser::draw(int vWidgetId)
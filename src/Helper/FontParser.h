@@ -16,6 +16,7 @@
 #pragma once
 
 #include <Generator/MemoryStream.h>
+#include <Generator/FontChecksum.h>
 #include <imgui/imgui.h>
 #include <cstdint>
 #include <string>
@@ -23,6 +24,7 @@
 #include <map>
 #include <set>
 #include <utility> // std::pair
+#include <memory>
 
  //////////////////////////////////////////////////////////////////////////////////
  //////////////////////////////////////////////////////////////////////////////////
@@ -35,7 +37,13 @@ namespace FontAnalyser
 		std::vector<std::vector<std::string>> array;
 		ImGuiListClipper m_Clipper;
 
+	protected:
+		// for big tables, the rows are not stored, but formated by GetVirtualRow only for the visible range
+		size_t m_CountVirtualRows = 0U;
+		virtual void GetVirtualRow(size_t vIdx, std::string& vItem, std::string& vSize, std::string& vInfos);
+
 	public:
+		virtual ~TableDisplay() = default;
 		void AddItem(std::string vItem, std::string vSize, std::string vInfos);
 		void DisplayTable(const char* vTableLabel, size_t vMaxCount = 0);
 	};
@@ -65,10 +73,13 @@ namespace FontAnalyser
 		uint32_t checkSum = 0;
 		uint32_t offset = 0;
 		uint32_t length = 0;
+		uint32_t computedCheckSum = 0;
+		bool checkSumValid = true;
 
 	public:
 		int draw(int vWidgetId);
 		void parse(MemoryStream *vMem);
+		void validate(const FontTableChecksumStruct& vChecksum);
 	};
 	
 	//////////////////////////////////////
@@ -315,6 +326,9 @@ namespace FontAnalyser
 
 	public:
 		std::vector<uint32_t> offsets;
+
+	protected:
+		void GetVirtualRow(size_t vIdx, std::string& vItem, std::string& vSize, std::string& vInfos) override;
 		
 	public:
 		int draw(int vWidgetId);
@@ -535,9 +549,18 @@ namespace FontAnalyser
 		simpleGlyphTableStruct simpleGlyph;
 		compositeGlyphTableStruct compositeGlyph;
 
+	private: // the glyph datas are decoded only when the node is opened
+		MemoryStream* mem = 0;
+		size_t dataOffset = 0U;
+		size_t dataLength = 0U;
+		bool dataParsed = false;
+
 	public:
 		int draw(int vWidgetId);
 		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength);
+
+	private:
+		void parseDatas();
 	};
 
 	class glyfTableStruct : public TableDisplay
@@ -545,22 +568,33 @@ namespace FontAnalyser
 	public:
 		locaTableStruct *loca = 0;
 
-	public:
-		std::vector<glyfStruct> glyfs;
+	private: // virtualized : a glyph is parsed only when visible in the clipper
+		MemoryStream* mem = 0;
+		size_t tableOffset = 0U;
+		size_t tableLength = 0U;
+		std::map<size_t, glyfStruct> glyfs; // glyph id, glyph parsed
 
 	public:
 		int draw(int vWidgetId);
 		void parse(MemoryStream *vMem, size_t vOffset, size_t vLength);
+		glyfStruct* getGlyf(size_t vGlyphId);
 	};
 
 	//////////////////////////////////////
 
 	class FontAnalyzedStruct
 	{
+	private:
+		// only the header and the table directory are parsed by parse()
+		// a table is parsed the first time his node is opened
+		MemoryStream mem;
+		std::set<std::string> parsedTables;
+
 	public:
 		bool parsed = false;
 		HeaderStruct header;
 		std::map<std::string, TableStruct> tables;
+		FontChecksumReportStruct checksumReport;
 		maxpTableStruct maxp;
 		nameTableStruct name;
 		postTableStruct post;
@@ -573,23 +607,30 @@ namespace FontAnalyser
 
 	public:
 		int draw(int vWidgetId);
-		void parse(MemoryStream *vMem);
+		bool parse(const uint8_t* vDatas, size_t vSize);
+
+	private:
+		void parseTable(const std::string& vTag);
+		int drawTable(const std::string& vTag);
+		void drawChecksumReport();
 	};
 }
 
 //////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////////
 
+class FontBlob;
 class FontParser
 {
 private:
+	std::shared_ptr<const FontBlob> m_FontBlob = nullptr; // datas viewed by m_FontAnalyzed
 	FontAnalyser::FontAnalyzedStruct m_FontAnalyzed;
 
 public:
 	FontParser();
 	~FontParser();
 
-	void ParseFont(const std::string& vFilePathName);
+	bool ParseFont(const std::string& vFilePathName);
 	int draw(int vWidgetId);
 };
 
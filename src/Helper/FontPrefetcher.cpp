@@ -0,0 +1,142 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FontPrefetcher.h"
+
+#include <Helper/FontBlobRegistry.h>
+
+#include <vector>
+
+FontPrefetcher::FontPrefetcher()
+{
+	// the registry is created before, so destroyed after this one
+	FontBlobRegistry::Instance();
+}
+
+FontPrefetcher::~FontPrefetcher()
+{
+	std::vector<TaskHandle> tasks;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		for (auto& it : m_PendingTasks)
+		{
+			it.second->Cancel();
+			tasks.push_back(it.second);
+		}
+	}
+
+	// a running job use this instance, normally all ended by TaskSystem::Unit in MainFrame::Unit
+	for (auto& task : tasks)
+		task->GetFuture().wait();
+}
+
+void FontPrefetcher::Add(const std::string& vFontFilePathName)
+{
+	if (vFontFilePathName.empty())
+		return;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	if (m_PendingTasks.find(vFontFilePathName) != m_PendingTasks.end() ||
+		m_PrefetchedBlobs.find(vFontFilePathName) != m_PrefetchedBlobs.end())
+		return; // already pending or prefetched
+
+	// the task can't end before to be in the map, his job lock m_Mutex
+	m_PendingTasks[vFontFilePathName] = TaskSystem::Instance()->Submit("Font Prefetch",
+		[this, vFontFilePathName](TaskContext& vContext)
+		{
+			return PrefetchJob(vFontFilePathName, vContext);
+		});
+}
+
+void FontPrefetcher::Release(const std::string& vFontFilePathName)
+{
+	std::shared_ptr<const FontBlob> blob;
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	auto itTask = m_PendingTasks.find(vFontFilePathName);
+	if (itTask != m_PendingTasks.end())
+	{
+		itTask->second->Cancel(); // the font is loaded without it
+		m_PendingTasks.erase(itTask);
+	}
+	auto itBlob = m_PrefetchedBlobs.find(vFontFilePathName);
+	if (itBlob != m_PrefetchedBlobs.end())
+	{
+		blob = itBlob->second; // released after the lock
+		m_PrefetchedBlobs.erase(itBlob);
+	}
+}
+
+void FontPrefetcher::Clear()
+{
+	std::map<std::string, std::shared_ptr<const FontBlob>> blobs;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		for (auto& it : m_PendingTasks)
+			it.second->Cancel();
+		m_PendingTasks.clear();
+		blobs.swap(m_PrefetchedBlobs);
+	}
+
+	// the blobs are freed here, out of the lock
+	blobs.clear();
+}
+
+size_t FontPrefetcher::GetCountPendings()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_PendingTasks.size();
+}
+
+size_t FontPrefetcher::GetCountPrefetched()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_PrefetchedBlobs.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PRIVATE //////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// in a worker of the TaskSystem
+bool FontPrefetcher::PrefetchJob(const std::string& vFontFilePathName, TaskContext& vContext)
+{
+	// the same blob as the one of the font load
+	auto blob = FontBlobRegistry::Instance()->GetOwnedBlob(vFontFilePathName);
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	// the font can be loaded or the project closed during the prefetch
+	// so the task is not in the map anymore, or replaced by a new one
+	auto it = m_PendingTasks.find(vFontFilePathName);
+	if (it == m_PendingTasks.end() || it->second.get() != &vContext)
+		return false;
+
+	m_PendingTasks.erase(it);
+
+	if (vContext.IsCancelRequested())
+		return false;
+
+	// not readable, the error will be reported by the font load
+	if (blob)
+		m_PrefetchedBlobs[vFontFilePathName] = blob;
+
+	return true;
+}
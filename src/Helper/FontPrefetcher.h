@@ -0,0 +1,59 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Helper/TaskSystem.h>
+
+#include <string>
+#include <map>
+#include <memory>
+#include <mutex>
+
+// background prefetch of the font files of a project whose loading is deferred
+// the file is read in a task of the TaskSystem (owned blob of FontBlobRegistry), so the font load at first need
+// (atlas, texture..) get it without reading the disk, the atlas / texture work stay in the main thread
+// the prefetched blob is kept alive until the font is loaded (see Release) or the project is closed (see Clear)
+class FontBlob;
+class FontPrefetcher
+{
+private:
+	std::mutex m_Mutex;
+	std::map<std::string, TaskHandle> m_PendingTasks; // removed by the task at his end
+	std::map<std::string, std::shared_ptr<const FontBlob>> m_PrefetchedBlobs;
+
+public:
+	void Add(const std::string& vFontFilePathName);
+	void Release(const std::string& vFontFilePathName);
+	void Clear();
+	size_t GetCountPendings();
+	size_t GetCountPrefetched();
+
+private:
+	bool PrefetchJob(const std::string& vFontFilePathName, TaskContext& vContext);
+
+public: // singleton
+	static FontPrefetcher* Instance()
+	{
+		static FontPrefetcher _instance;
+		return &_instance;
+	}
+
+protected:
+	FontPrefetcher(); // Prevent construction
+	FontPrefetcher(const FontPrefetcher&) {}; // Prevent construction by copying
+	FontPrefetcher& operator =(const FontPrefetcher&) { return *this; }; // Prevent assignment
+	~FontPrefetcher(); // Prevent unwanted destruction
+};
@@ -21,7 +21,7 @@ void FrameActionSystem::Clear()
 	m_Actions.clear();
 }
 
-void FrameActionSystem::RunActions()
+bool FrameActionSystem::RunActions()
 {
 	if (!m_Actions.empty())
 	{
@@ -32,6 +32,10 @@ void FrameActionSystem::RunActions()
 			{
 				m_Actions.pop_front();
 			}
+
+			return !m_Actions.empty(); // the next action need a new frame
 		}
 	}
+
+	return false;
 }
\ No newline at end of file
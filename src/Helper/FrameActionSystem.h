@@ -32,5 +32,6 @@ public:
 	// if return true, erase action
 	// let the next frame call the next action
 	// if false, action executed until true
-	void RunActions();
+	// return true if an action was done and others are waiting (so a new frame is needed)
+	bool RunActions();
 };
\ No newline at end of file
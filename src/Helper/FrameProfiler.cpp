@@ -0,0 +1,113 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "FrameProfiler.h"
+
+#include <imgui/imgui.h>
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include <imgui/imgui_internal.h>
+
+void FrameProfiler::NewFrame()
+{
+	if (m_FrameStarted)
+	{
+		for (auto& entry : m_Entries)
+		{
+			entry.lastTimeInMs = (float)entry.frameTimeInMs;
+			entry.samples[entry.sampleOffset] = entry.lastTimeInMs;
+			entry.sampleOffset = (entry.sampleOffset + 1) % FRAME_PROFILER_COUNT_SAMPLES;
+			if (entry.countSamples < FRAME_PROFILER_COUNT_SAMPLES)
+				entry.countSamples++;
+			entry.frameTimeInMs = 0.0;
+
+			float sum = 0.0f;
+			entry.maxTimeInMs = 0.0f;
+			for (const auto& sample : entry.samples)
+			{
+				sum += sample;
+				if (sample > entry.maxTimeInMs)
+					entry.maxTimeInMs = sample;
+			}
+			entry.averageTimeInMs = sum / (float)entry.countSamples; // not the zeros of the unrecorded samples
+
+			CountDrawDatas(entry);
+		}
+	}
+
+	m_FrameStarted = m_Enabled;
+}
+
+void FrameProfiler::AddTime(const char* vName, const char* vWindowName, const double& vTimeInMs)
+{
+	if (!vName)
+		return;
+
+	size_t idx = 0U;
+	auto it = m_EntryIndexs.find(vName);
+	if (it == m_EntryIndexs.end()) // not found
+	{
+		idx = m_Entries.size();
+		m_EntryIndexs[vName] = idx;
+		m_Entries.emplace_back();
+		m_Entries.back().name = vName;
+		if (vWindowName)
+			m_Entries.back().windowName = vWindowName;
+	}
+	else
+	{
+		idx = it->second;
+	}
+
+	m_Entries[idx].frameTimeInMs += vTimeInMs;
+}
+
+void FrameProfiler::Clear()
+{
+	m_Entries.clear();
+	m_EntryIndexs.clear();
+	m_FrameStarted = false;
+}
+
+// the window and his childs, only if drawn in the last frame
+// called after ImGui::NewFrame, so Active is now in WasActive
+void FrameProfiler::CountDrawDatas(FrameProfilerEntryStruct& vEntry)
+{
+	vEntry.countDrawCmds = 0;
+	vEntry.countVertices = 0;
+	vEntry.countIndices = 0;
+
+	if (vEntry.windowName.empty())
+		return;
+
+	auto rootWindow = ImGui::FindWindowByName(vEntry.windowName.c_str());
+	if (!rootWindow || !rootWindow->WasActive)
+		return;
+
+	ImGuiContext& g = *GImGui;
+	for (auto window : g.Windows)
+	{
+		if (window && window->WasActive && window->DrawList &&
+			(window == rootWindow || window->RootWindow == rootWindow))
+		{
+			vEntry.countDrawCmds += window->DrawList->CmdBuffer.Size;
+			vEntry.countVertices += window->DrawList->VtxBuffer.Size;
+			vEntry.countIndices += window->DrawList->IdxBuffer.Size;
+		}
+	}
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+
+// cpu time of the panes per frame, measured by FrameProfilerScope (see LayoutManager)
+// each entry keep the last frames for a rolling histogram (see DebugPane)
+// and the count of draw commands / vertices of his window, read in the draw lists of the last frame
+// main thread only. nothing is measured while disabled (setting in the config file)
+
+#define FRAME_PROFILER_COUNT_SAMPLES 120
+
+struct FrameProfilerEntryStruct
+{
+	std::string name;
+	std::string windowName; // for count the draw datas, empty if none
+	float samples[FRAME_PROFILER_COUNT_SAMPLES] = {}; // ms, ring buffer
+	int sampleOffset = 0; // the oldest sample
+	int countSamples = 0; // recorded samples, max FRAME_PROFILER_COUNT_SAMPLES, the others are zero
+	double frameTimeInMs = 0.0; // accumulated during the current frame
+	float lastTimeInMs = 0.0f;
+	float averageTimeInMs = 0.0f;
+	float maxTimeInMs = 0.0f;
+	int countDrawCmds = 0;
+	int countVertices = 0;
+	int countIndices = 0;
+};
+
+class FrameProfiler
+{
+public:
+	bool m_Enabled = false; // setting
+
+private:
+	std::vector<FrameProfilerEntryStruct> m_Entries; // in order of the first measure
+	std::map<std::string, size_t> m_EntryIndexs; // key is entry name, value is index in m_Entries
+	bool m_FrameStarted = false;
+
+public:
+	// to call at the start of the frame, before the panes, close the last frame
+	// the draw lists of the windows are still the ones of the last frame
+	void NewFrame();
+	void AddTime(const char* vName, const char* vWindowName, const double& vTimeInMs);
+	const std::vector<FrameProfilerEntryStruct>& GetEntries() const { return m_Entries; }
+	void Clear();
+
+private:
+	static void CountDrawDatas(FrameProfilerEntryStruct& vEntry);
+
+public: // singleton
+	static FrameProfiler* Instance()
+	{
+		static FrameProfiler _instance;
+		return &_instance;
+	}
+
+protected:
+	FrameProfiler() = default; // Prevent construction
+	FrameProfiler(const FrameProfiler&) {}; // Prevent construction by copying
+	FrameProfiler& operator =(const FrameProfiler&) { return *this; }; // Prevent assignment
+	~FrameProfiler() = default; // Prevent unwanted destruction
+};
+
+// measure the scope as a part of the current frame
+// vWindowName is the name of the imgui window drawn in the scope, for count his draw datas
+class FrameProfilerScope
+{
+private:
+	const char* m_Name = nullptr; // must be alive until the end of the scope
+	const char* m_WindowName = nullptr;
+	bool m_Active = false;
+	std::chrono::steady_clock::time_point m_Start;
+
+public:
+	explicit FrameProfilerScope(const char* vName, const char* vWindowName = nullptr)
+		: m_Name(vName), m_WindowName(vWindowName), m_Active(FrameProfiler::Instance()->m_Enabled)
+	{
+		if (m_Active)
+			m_Start = std::chrono::steady_clock::now();
+	}
+
+	~FrameProfilerScope()
+	{
+		if (m_Active)
+		{
+			FrameProfiler::Instance()->AddTime(m_Name, m_WindowName,
+				std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_Start).count());
+		}
+	}
+
+	FrameProfilerScope(const FrameProfilerScope&) = delete;
+	FrameProfilerScope& operator =(const FrameProfilerScope&) = delete;
+};
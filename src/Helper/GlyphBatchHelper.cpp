@@ -0,0 +1,180 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "GlyphBatchHelper.h"
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include <imgui/imgui_internal.h>
+
+// max quads per PrimReserve, for stay under 65536 vertexs with 16 bits indexs
+#define GLYPH_BATCH_MAX_QUADS_PER_RESERVE 4096U
+
+///////////////////////////////////////////////////////////////////////////////////
+//// STATIC ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// clip an axis aligned quad and his uvs, return false if fully clipped
+static bool ClipQuad(const ImVec2& vClipMin, const ImVec2& vClipMax,
+	ImVec2* vMin, ImVec2* vMax, ImVec2* vUV0, ImVec2* vUV1)
+{
+	if (vMax->x <= vClipMin.x || vMin->x >= vClipMax.x ||
+		vMax->y <= vClipMin.y || vMin->y >= vClipMax.y ||
+		vMax->x <= vMin->x || vMax->y <= vMin->y)
+		return false;
+
+	if (vMin->x < vClipMin.x)
+	{
+		vUV0->x += (vUV1->x - vUV0->x) * (vClipMin.x - vMin->x) / (vMax->x - vMin->x);
+		vMin->x = vClipMin.x;
+	}
+	if (vMax->x > vClipMax.x)
+	{
+		vUV1->x -= (vUV1->x - vUV0->x) * (vMax->x - vClipMax.x) / (vMax->x - vMin->x);
+		vMax->x = vClipMax.x;
+	}
+	if (vMin->y < vClipMin.y)
+	{
+		vUV0->y += (vUV1->y - vUV0->y) * (vClipMin.y - vMin->y) / (vMax->y - vMin->y);
+		vMin->y = vClipMin.y;
+	}
+	if (vMax->y > vClipMax.y)
+	{
+		vUV1->y -= (vUV1->y - vUV0->y) * (vMax->y - vClipMax.y) / (vMax->y - vMin->y);
+		vMax->y = vClipMax.y;
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PUBLIC ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+void GlyphBatchHelper::Begin(ImDrawList* vDrawList)
+{
+	IM_ASSERT(m_DrawList == nullptr); // no nested batch
+
+	m_DrawList = vDrawList;
+	m_CountUsedTextures = 0U;
+}
+
+void GlyphBatchHelper::End()
+{
+	Flush();
+
+	m_DrawList = nullptr;
+	m_CountUsedTextures = 0U;
+}
+
+void GlyphBatchHelper::Flush()
+{
+	if (m_DrawList)
+	{
+		// the quads are already clipped, so the current clip rect (the window) is ok for all
+		for (size_t texIdx = 0U; texIdx < m_CountUsedTextures; ++texIdx)
+		{
+			auto& quads = m_Quads[texIdx];
+			if (quads.empty())
+				continue;
+
+			m_DrawList->PushTextureID(m_Textures[texIdx]);
+			for (size_t start = 0U; start < quads.size(); start += GLYPH_BATCH_MAX_QUADS_PER_RESERVE)
+			{
+				const size_t count = ImMin(quads.size() - start, (size_t)GLYPH_BATCH_MAX_QUADS_PER_RESERVE);
+				m_DrawList->PrimReserve((int)count * 6, (int)count * 4);
+				for (size_t i = start; i < start + count; ++i)
+				{
+					const auto& quad = quads[i];
+					m_DrawList->PrimRectUV(quad.pMin, quad.pMax, quad.uv0, quad.uv1, quad.col);
+				}
+			}
+			m_DrawList->PopTextureID();
+
+			quads.clear();
+		}
+	}
+
+	m_CountUsedTextures = 0U;
+}
+
+bool GlyphBatchHelper::IsRecording(ImDrawList* vDrawList) const
+{
+	return (m_DrawList && m_DrawList == vDrawList);
+}
+
+void GlyphBatchHelper::AddGlyphQuad(ImDrawList* vDrawList, ImTextureID vTexId,
+	ImVec2 vMin, ImVec2 vMax, ImVec2 vUV0, ImVec2 vUV1, ImU32 vCol)
+{
+	if (!vDrawList)
+		return;
+
+	if (!IsRecording(vDrawList))
+	{
+		vDrawList->PushTextureID(vTexId);
+		vDrawList->PrimReserve(6, 4);
+		vDrawList->PrimRectUV(vMin, vMax, vUV0, vUV1, vCol);
+		vDrawList->PopTextureID();
+		return;
+	}
+
+	if (!ClipQuad(vDrawList->GetClipRectMin(), vDrawList->GetClipRectMax(), &vMin, &vMax, &vUV0, &vUV1))
+		return;
+
+	// few textures, so a linear search is enough
+	size_t texIdx = 0U;
+	while (texIdx < m_CountUsedTextures && m_Textures[texIdx] != vTexId)
+		++texIdx;
+	if (texIdx == m_CountUsedTextures)
+	{
+		if (m_Textures.size() <= texIdx)
+		{
+			m_Textures.push_back(vTexId);
+			m_Quads.emplace_back();
+		}
+		m_Textures[texIdx] = vTexId;
+		++m_CountUsedTextures;
+	}
+
+	GlyphBatchQuadStruct quad;
+	quad.pMin = vMin;
+	quad.pMax = vMax;
+	quad.uv0 = vUV0;
+	quad.uv1 = vUV1;
+	quad.col = vCol;
+	m_Quads[texIdx].push_back(quad);
+}
+
+void GlyphBatchHelper::AddChar(ImDrawList* vDrawList, ImFont* vFont, float vSize, ImVec2 vPos, ImU32 vCol, ImWchar vCodePoint)
+{
+	if (!vFont || !vFont->ContainerAtlas)
+		return;
+
+	const ImFontGlyph* glyph = vFont->FindGlyph(vCodePoint);
+	if (!glyph || !glyph->Visible)
+		return;
+
+	const float scale = (vSize >= 0.0f) ? (vSize / vFont->FontSize) : 1.0f;
+	vPos.x = IM_FLOOR(vPos.x);
+	vPos.y = IM_FLOOR(vPos.y);
+
+	AddGlyphQuad(vDrawList, vFont->ContainerAtlas->TexID,
+		ImVec2(vPos.x + glyph->X0 * scale, vPos.y + glyph->Y0 * scale),
+		ImVec2(vPos.x + glyph->X1 * scale, vPos.y + glyph->Y1 * scale),
+		ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), vCol);
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <imgui/imgui.h>
+
+#include <vector>
+
+// batch of glyph quads, grouped by atlas texture
+// without it, each glyph do PushTextureID / PopTextureID and PushClipRect / PopClipRect (glyph button)
+// so one draw command per glyph, and thousands of draw calls in the merged views
+// between Begin and End, the glyphs of the draw list are recorded, clipped on cpu with the current clip rect,
+// and drawn at End with one draw command per texture
+// so a shape drawn after the glyphs and before End is under them, Flush must be called before it
+// outside of Begin / End, or for another draw list (tooltip, popup..), the glyphs are drawn immediately
+
+struct GlyphBatchQuadStruct
+{
+	ImVec2 pMin, pMax;
+	ImVec2 uv0, uv1;
+	ImU32 col = 0;
+};
+
+class GlyphBatchHelper
+{
+private:
+	ImDrawList* m_DrawList = nullptr; // recorded draw list, nullptr if not recording
+	std::vector<ImTextureID> m_Textures; // in order of first use
+	std::vector<std::vector<GlyphBatchQuadStruct>> m_Quads; // per texture, the capacity is kept between frames
+	size_t m_CountUsedTextures = 0U;
+
+public:
+	void Begin(ImDrawList* vDrawList);
+	void End();
+	void Flush(); // draw the recorded glyphs now, the recording continue
+	bool IsRecording(ImDrawList* vDrawList) const;
+
+	// a glyph quad, in the batch if recording, drawn immediately if not
+	void AddGlyphQuad(ImDrawList* vDrawList, ImTextureID vTexId,
+		ImVec2 vMin, ImVec2 vMax, ImVec2 vUV0, ImVec2 vUV1, ImU32 vCol);
+	// like ImFont::RenderChar
+	void AddChar(ImDrawList* vDrawList, ImFont* vFont, float vSize, ImVec2 vPos, ImU32 vCol, ImWchar vCodePoint);
+
+public: // singleton
+	static GlyphBatchHelper* Instance()
+	{
+		static GlyphBatchHelper _instance;
+		return &_instance;
+	}
+
+protected:
+	GlyphBatchHelper() = default; // Prevent construction
+	GlyphBatchHelper(const GlyphBatchHelper&) {}; // Prevent construction by copying
+	GlyphBatchHelper& operator =(const GlyphBatchHelper&) { return *this; }; // Prevent assignment
+	~GlyphBatchHelper() = default; // Prevent unwanted destruction
+};
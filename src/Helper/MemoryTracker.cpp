@@ -0,0 +1,150 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryTracker.h"
+
+#include <imgui/imgui.h>
+#include <common/freetype/imgui_freetype.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+
+// the size of the allocation is stored before the returned pointer
+// 16 bytes for keep the alignment of malloc
+#define MEMORY_HEADER_SIZE 16U
+
+// not in the singleton, the allocators can be called after his destruction (static objects with imgui vectors)
+struct MemoryCategoryCountersStruct
+{
+	std::atomic<size_t> currentBytes{ 0U };
+	std::atomic<size_t> peakBytes{ 0U };
+	std::atomic<size_t> countAllocs{ 0U };
+	std::atomic<size_t> totalAllocs{ 0U };
+};
+static MemoryCategoryCountersStruct s_MemoryCounters[(size_t)MemoryCategoryEnum::MEMORY_CATEGORY_Count];
+
+static void* TrackedAlloc(size_t vSize, const MemoryCategoryEnum& vCategory)
+{
+	auto base = (uint8_t*)malloc(vSize + MEMORY_HEADER_SIZE);
+	if (!base)
+		return nullptr;
+
+	*(size_t*)base = vSize;
+
+	auto& counters = s_MemoryCounters[(size_t)vCategory];
+	const size_t current = counters.currentBytes.fetch_add(vSize) + vSize;
+	size_t peak = counters.peakBytes.load();
+	while (current > peak && !counters.peakBytes.compare_exchange_weak(peak, current)) {}
+	++counters.countAllocs;
+	++counters.totalAllocs;
+
+	return base + MEMORY_HEADER_SIZE;
+}
+
+static void TrackedFree(void* vPtr, const MemoryCategoryEnum& vCategory)
+{
+	if (!vPtr)
+		return;
+
+	auto base = (uint8_t*)vPtr - MEMORY_HEADER_SIZE;
+	const size_t size = *(size_t*)base;
+
+	auto& counters = s_MemoryCounters[(size_t)vCategory];
+	counters.currentBytes -= size;
+	--counters.countAllocs;
+
+	free(base);
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PUBLIC ///////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+void MemoryTracker::InstallAllocators()
+{
+	if (m_Installed)
+		return;
+
+	ImGui::SetAllocatorFunctions(ImGuiAlloc, ImGuiFree, nullptr);
+	ImGuiFreeType::SetAllocatorFunctions(FreeTypeAlloc, FreeTypeFree, nullptr);
+
+	m_Installed = true;
+}
+
+MemoryCategoryStatsStruct MemoryTracker::GetStats(const MemoryCategoryEnum& vCategory) const
+{
+	MemoryCategoryStatsStruct res;
+
+	if (vCategory < MemoryCategoryEnum::MEMORY_CATEGORY_Count)
+	{
+		const auto& counters = s_MemoryCounters[(size_t)vCategory];
+		res.currentBytes = counters.currentBytes;
+		res.peakBytes = counters.peakBytes;
+		res.countAllocs = counters.countAllocs;
+		res.totalAllocs = counters.totalAllocs;
+	}
+
+	return res;
+}
+
+const char* MemoryTracker::GetCategoryName(const MemoryCategoryEnum& vCategory)
+{
+	switch (vCategory)
+	{
+	case MemoryCategoryEnum::MEMORY_CATEGORY_IMGUI: return "ImGui";
+	case MemoryCategoryEnum::MEMORY_CATEGORY_FREETYPE: return "FreeType";
+	default: break;
+	}
+	return "";
+}
+
+// only the heap part, the string of the small string optimization is in the object
+size_t MemoryTracker::GetStringSize(const std::string& vStr)
+{
+	const char* datas = vStr.data();
+	const char* obj = (const char*)&vStr;
+	if (datas >= obj && datas < obj + sizeof(std::string))
+		return 0U;
+	return vStr.capacity() + 1U;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PRIVATE //////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+void* MemoryTracker::ImGuiAlloc(size_t vSize, void* /*vUserDatas*/)
+{
+	return TrackedAlloc(vSize, MemoryCategoryEnum::MEMORY_CATEGORY_IMGUI);
+}
+
+void MemoryTracker::ImGuiFree(void* vPtr, void* /*vUserDatas*/)
+{
+	TrackedFree(vPtr, MemoryCategoryEnum::MEMORY_CATEGORY_IMGUI);
+}
+
+void* MemoryTracker::FreeTypeAlloc(size_t vSize, void* /*vUserDatas*/)
+{
+	return TrackedAlloc(vSize, MemoryCategoryEnum::MEMORY_CATEGORY_FREETYPE);
+}
+
+void MemoryTracker::FreeTypeFree(void* vPtr, void* /*vUserDatas*/)
+{
+	TrackedFree(vPtr, MemoryCategoryEnum::MEMORY_CATEGORY_FREETYPE);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// memory accounting, shown in the MemoryPane
+// - the allocations of imgui (atlas pixels, glyphs, draw lists..) and freetype (during the atlas builds)
+//   are counted by category with custom allocators
+//   InstallAllocators must be called before ImGui::CreateContext, the memory allocated before can't be freed by them
+// - the memory of the fonts structures (maps, vectors, strings) is estimated (see FontInfos::GetMemoryUsage)
+
+enum class MemoryCategoryEnum
+{
+	MEMORY_CATEGORY_IMGUI = 0,
+	MEMORY_CATEGORY_FREETYPE,
+	MEMORY_CATEGORY_Count
+};
+
+struct MemoryCategoryStatsStruct
+{
+	size_t currentBytes = 0U;
+	size_t peakBytes = 0U;
+	size_t countAllocs = 0U; // alive
+	size_t totalAllocs = 0U; // since the start
+};
+
+// node of std::map / std::set : 3 pointers and a color, padded
+#define MEMORY_MAP_NODE_OVERHEAD (sizeof(void*) * 4U)
+
+class MemoryTracker
+{
+public:
+	// the allocations of imgui and freetype are counted from now
+	void InstallAllocators();
+	bool IsInstalled() const { return m_Installed; }
+	MemoryCategoryStatsStruct GetStats(const MemoryCategoryEnum& vCategory) const;
+	static const char* GetCategoryName(const MemoryCategoryEnum& vCategory);
+
+public: // estimations of the std containers memory (heap only)
+	static size_t GetStringSize(const std::string& vStr);
+	template<typename T>
+	static size_t GetVectorSize(const std::vector<T>& vVec)
+	{
+		return vVec.capacity() * sizeof(T);
+	}
+	static size_t GetVectorSize(const std::vector<bool>& vVec)
+	{
+		return vVec.capacity() / 8U; // packed bits
+	}
+	template<typename TMap>
+	static size_t GetMapNodesSize(const TMap& vMap)
+	{
+		return vMap.size() * (sizeof(typename TMap::value_type) + MEMORY_MAP_NODE_OVERHEAD);
+	}
+
+private:
+	bool m_Installed = false;
+
+private:
+	static void* ImGuiAlloc(size_t vSize, void* vUserDatas);
+	static void ImGuiFree(void* vPtr, void* vUserDatas);
+	static void* FreeTypeAlloc(size_t vSize, void* vUserDatas);
+	static void FreeTypeFree(void* vPtr, void* vUserDatas);
+
+public: // singleton
+	static MemoryTracker* Instance()
+	{
+		static MemoryTracker _instance;
+		return &_instance;
+	}
+
+protected:
+	MemoryTracker() = default; // Prevent construction
+	MemoryTracker(const MemoryTracker&) {}; // Prevent construction by copying
+	MemoryTracker& operator =(const MemoryTracker&) { return *this; }; // Prevent assignment
+	~MemoryTracker() = default; // Prevent unwanted destruction
+};
@@ -30,23 +30,52 @@ Messaging::~Messaging() = default;
 ///// PRIVATE /////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////
 
-static char Messaging_Message_Buffer[2048] = "\0";
-
 void Messaging::AddMessage(MessageTypeEnum vType, bool vSelect, MessageData vDatas, const MessageFunc& vFunction, const char* fmt, va_list args)
 {
-	int size = vsnprintf(Messaging_Message_Buffer, 2047, fmt, args);
+	char buffer[2048] = "\0"; // not static, can be called by many threads
+	int size = vsnprintf(buffer, 2047, fmt, args);
 	if (size > 0)
-		AddMessage(std::string(Messaging_Message_Buffer, size), vType, vSelect, vDatas, vFunction);
+		AddMessage(std::string(buffer, ct::mini(size, 2047)), vType, vSelect, vDatas, vFunction);
 }
 
 void Messaging::AddMessage(const std::string& vMsg, MessageTypeEnum vType, bool vSelect, MessageData vDatas, const MessageFunc& vFunction)
 {
-	if (vSelect)
+	std::lock_guard<std::mutex> lock(m_PendingMutex);
+	PendingMessageStruct pending;
+	pending.msg = vMsg;
+	pending.type = vType;
+	pending.select = vSelect;
+	pending.datas = vDatas;
+	pending.func = vFunction;
+	m_PendingMessages.push_back(pending);
+}
+
+// main thread only
+void Messaging::AddPendingMessages()
+{
+	std::vector<PendingMessageStruct> pendings;
+
 	{
-		currentMsgIdx = (int32_t)m_Messages.size();
+		std::lock_guard<std::mutex> lock(m_PendingMutex);
+		pendings.swap(m_PendingMessages);
 	}
 
-	m_Messages.emplace_back(vMsg, vType, vDatas, vFunction);
+	for (auto& pending : pendings)
+	{
+		if (pending.select)
+		{
+			currentMsgIdx = (int32_t)m_Messages.size();
+		}
+
+		m_Messages.emplace_back(pending.msg, pending.type, pending.datas, pending.func);
+
+		if (pending.type == MessageTypeEnum::MESSAGE_TYPE_INFOS)
+			m_MessageExistFlags = (MessageExistFlags)(m_MessageExistFlags | MESSAGE_EXIST_INFOS);
+		else if (pending.type == MessageTypeEnum::MESSAGE_TYPE_WARNING)
+			m_MessageExistFlags = (MessageExistFlags)(m_MessageExistFlags | MESSAGE_EXIST_WARNING);
+		else if (pending.type == MessageTypeEnum::MESSAGE_TYPE_ERROR)
+			m_MessageExistFlags = (MessageExistFlags)(m_MessageExistFlags | MESSAGE_EXIST_ERROR);
+	}
 }
 
 bool Messaging::DrawMessage(const size_t& vMsgIdx)
@@ -100,6 +129,8 @@ bool Messaging::DrawMessage(const Messagekey& vMsg)
 
 void Messaging::Draw()
 {
+	AddPendingMessages();
+
 	ImGui::Text("Messages :");
 
 	if (ImGui::MenuItem(ICON_IGFS_REFRESH "##Refresh"))
@@ -170,7 +201,6 @@ void Messaging::AddInfos(bool vSelect, MessageData vDatas, const MessageFunc& vF
 	va_start(args, fmt);
 	AddMessage(MessageTypeEnum::MESSAGE_TYPE_INFOS, vSelect, vDatas, vFunction, fmt, args);
 	va_end(args);
-	m_MessageExistFlags = (MessageExistFlags)(m_MessageExistFlags | MESSAGE_EXIST_INFOS);
 }
 
 void Messaging::AddWarning(bool vSelect, MessageData vDatas, const MessageFunc& vFunction, const char* fmt, ...)
@@ -179,7 +209,6 @@ void Messaging::AddWarning(bool vSelect, MessageData vDatas, const MessageFunc&
 	va_start(args, fmt);
 	AddMessage(MessageTypeEnum::MESSAGE_TYPE_WARNING, vSelect, vDatas, vFunction, fmt, args);
 	va_end(args);
-	m_MessageExistFlags = (MessageExistFlags)(m_MessageExistFlags | MESSAGE_EXIST_WARNING);
 }
 
 void Messaging::AddError(bool vSelect, MessageData vDatas, const MessageFunc& vFunction, const char* fmt, ...)
@@ -188,7 +217,6 @@ void Messaging::AddError(bool vSelect, MessageData vDatas, const MessageFunc& vF
 	va_start(args, fmt);
 	AddMessage(MessageTypeEnum::MESSAGE_TYPE_ERROR, vSelect, vDatas, vFunction, fmt, args);
 	va_end(args);
-	m_MessageExistFlags = (MessageExistFlags)(m_MessageExistFlags | MESSAGE_EXIST_ERROR);
 }
 
 void Messaging::ClearErrors()
@@ -24,6 +24,7 @@
 #include <list>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 class MessageData
 {
@@ -80,11 +81,25 @@ private:
 	typedef std::tuple<std::string, MessageTypeEnum, MessageData, MessageFunc> Messagekey;
 	std::vector<Messagekey> m_Messages;
 
+	// the messages can be added from the workers (see TaskSystem)
+	// so there are added in m_Messages only in the main thread, at the draw
+	struct PendingMessageStruct
+	{
+		std::string msg;
+		MessageTypeEnum type = MESSAGE_TYPE_INFOS;
+		bool select = false;
+		MessageData datas;
+		MessageFunc func;
+	};
+	std::mutex m_PendingMutex;
+	std::vector<PendingMessageStruct> m_PendingMessages;
+
 private:
 	void AddMessage(const std::string& vMsg, MessageTypeEnum vType, bool vSelect, MessageData vDatas, const MessageFunc& vFunction);
 	void AddMessage(MessageTypeEnum vType, bool vSelect, MessageData vDatas, const MessageFunc& vFunction, const char* fmt, va_list args);
 	bool DrawMessage(const size_t& vMsgIdx);
 	bool DrawMessage(const Messagekey& vMsg);
+	void AddPendingMessages();
 
 public:
 	void Draw();
@@ -0,0 +1,244 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SdfPreviewHelper.h"
+
+#include <Helper/Messaging.h>
+
+#include <string>
+
+#if !VULKAN
+
+// same glsl version as the imgui backend (see main_opengl.cpp)
+#if APPLE
+#define SDF_PREVIEW_GLSL_VERSION "#version 150\n"
+#else
+#define SDF_PREVIEW_GLSL_VERSION "#version 130\n"
+#endif
+
+// same attributes as imgui, the locations are fixed for setup them in the callback
+#define SDF_PREVIEW_ATTRIB_POSITION 0
+#define SDF_PREVIEW_ATTRIB_UV 1
+#define SDF_PREVIEW_ATTRIB_COLOR 2
+
+static const char* s_SdfPreviewVertexShader =
+	SDF_PREVIEW_GLSL_VERSION
+	"uniform mat4 ProjMtx;\n"
+	"in vec2 Position;\n"
+	"in vec2 UV;\n"
+	"in vec4 Color;\n"
+	"out vec2 Frag_UV;\n"
+	"out vec4 Frag_Color;\n"
+	"void main()\n"
+	"{\n"
+	"	Frag_UV = UV;\n"
+	"	Frag_Color = Color;\n"
+	"	gl_Position = ProjMtx * vec4(Position.xy, 0, 1);\n"
+	"}\n";
+
+// the distance is 0.5 on the outline, the range is converted in screen pixels for a constant antialiasing at any zoom
+static const char* s_SdfPreviewFragmentShader =
+	SDF_PREVIEW_GLSL_VERSION
+	"uniform sampler2D Texture;\n"
+	"uniform float PxRange;\n"
+	"uniform vec2 TexSize;\n"
+	"uniform int Msdf;\n"
+	"in vec2 Frag_UV;\n"
+	"in vec4 Frag_Color;\n"
+	"out vec4 Out_Color;\n"
+	"float median(float r, float g, float b) { return max(min(r, g), min(max(r, g), b)); }\n"
+	"void main()\n"
+	"{\n"
+	"	vec4 s = texture(Texture, Frag_UV.st);\n"
+	"	float d = (Msdf != 0) ? median(s.r, s.g, s.b) : s.a;\n"
+	"	vec2 unitRange = vec2(PxRange) / TexSize;\n"
+	"	vec2 screenTexSize = vec2(1.0) / fwidth(Frag_UV);\n"
+	"	float screenPxRange = max(0.5 * dot(unitRange, screenTexSize), 1.0);\n"
+	"	float alpha = clamp(screenPxRange * (d - 0.5) + 0.5, 0.0, 1.0);\n"
+	"	Out_Color = vec4(Frag_Color.rgb, Frag_Color.a * alpha);\n"
+	"}\n";
+
+static GLuint CompileShader(GLenum vType, const char* vSource)
+{
+	GLuint shader = glCreateShader(vType);
+	glShaderSource(shader, 1, &vSource, nullptr);
+	glCompileShader(shader);
+
+	GLint status = 0;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+	if (status == GL_FALSE)
+	{
+		char log[1024] = "\0";
+		glGetShaderInfoLog(shader, 1023, nullptr, log);
+		Messaging::Instance()->AddError(true, nullptr, nullptr, "Sdf preview shader compilation failed : %s", log);
+		glDeleteShader(shader);
+		return 0U;
+	}
+
+	return shader;
+}
+
+bool SdfPreviewHelper::CreateProgram()
+{
+	if (m_Program)
+		return true;
+	if (m_ProgramFailed)
+		return false;
+
+	m_ProgramFailed = true;
+
+	GLuint vert = CompileShader(GL_VERTEX_SHADER, s_SdfPreviewVertexShader);
+	GLuint frag = CompileShader(GL_FRAGMENT_SHADER, s_SdfPreviewFragmentShader);
+	if (vert && frag)
+	{
+		GLuint program = glCreateProgram();
+		glAttachShader(program, vert);
+		glAttachShader(program, frag);
+		glBindAttribLocation(program, SDF_PREVIEW_ATTRIB_POSITION, "Position");
+		glBindAttribLocation(program, SDF_PREVIEW_ATTRIB_UV, "UV");
+		glBindAttribLocation(program, SDF_PREVIEW_ATTRIB_COLOR, "Color");
+		glLinkProgram(program);
+
+		GLint status = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &status);
+		if (status == GL_FALSE)
+		{
+			char log[1024] = "\0";
+			glGetProgramInfoLog(program, 1023, nullptr, log);
+			Messaging::Instance()->AddError(true, nullptr, nullptr, "Sdf preview shader link failed : %s", log);
+			glDeleteProgram(program);
+		}
+		else
+		{
+			m_Program = program;
+			m_ProjMtxLoc = glGetUniformLocation(m_Program, "ProjMtx");
+			m_TextureLoc = glGetUniformLocation(m_Program, "Texture");
+			m_PxRangeLoc = glGetUniformLocation(m_Program, "PxRange");
+			m_TexSizeLoc = glGetUniformLocation(m_Program, "TexSize");
+			m_MsdfLoc = glGetUniformLocation(m_Program, "Msdf");
+			m_ProgramFailed = false;
+		}
+	}
+
+	// the program keep them
+	if (vert) glDeleteShader(vert);
+	if (frag) glDeleteShader(frag);
+
+	return (m_Program != 0U);
+}
+
+// called by the imgui backend during the render, the vertex and index buffers of the draw list are bound
+void SdfPreviewHelper::SetupRenderStateCallback(const ImDrawList* /*vParentList*/, const ImDrawCmd* vCmd)
+{
+	auto helper = SdfPreviewHelper::Instance();
+	auto params = (const SdfPreviewParamsStruct*)vCmd->UserCallbackData;
+	if (!params || !helper->CreateProgram())
+		return;
+
+	// same ortho projection as the imgui backend
+	const float L = params->displayPos.x;
+	const float R = params->displayPos.x + params->displaySize.x;
+	const float T = params->displayPos.y;
+	const float B = params->displayPos.y + params->displaySize.y;
+	const float ortho_projection[4][4] =
+	{
+		{ 2.0f / (R - L),		0.0f,				0.0f,	0.0f },
+		{ 0.0f,					2.0f / (T - B),		0.0f,	0.0f },
+		{ 0.0f,					0.0f,				-1.0f,	0.0f },
+		{ (R + L) / (L - R),	(T + B) / (B - T),	0.0f,	1.0f },
+	};
+
+	glUseProgram(helper->m_Program);
+	glUniform1i(helper->m_TextureLoc, 0);
+	glUniformMatrix4fv(helper->m_ProjMtxLoc, 1, GL_FALSE, &ortho_projection[0][0]);
+	glUniform1f(helper->m_PxRangeLoc, params->pxRange);
+	glUniform2f(helper->m_TexSizeLoc, params->texSize.x, params->texSize.y);
+	glUniform1i(helper->m_MsdfLoc, params->msdf ? 1 : 0);
+
+	glEnableVertexAttribArray(SDF_PREVIEW_ATTRIB_POSITION);
+	glEnableVertexAttribArray(SDF_PREVIEW_ATTRIB_UV);
+	glEnableVertexAttribArray(SDF_PREVIEW_ATTRIB_COLOR);
+	glVertexAttribPointer(SDF_PREVIEW_ATTRIB_POSITION, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, pos));
+	glVertexAttribPointer(SDF_PREVIEW_ATTRIB_UV, 2, GL_FLOAT, GL_FALSE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, uv));
+	glVertexAttribPointer(SDF_PREVIEW_ATTRIB_COLOR, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
+}
+
+#endif // !VULKAN
+
+bool SdfPreviewHelper::IsSupported() const
+{
+#if VULKAN
+	return false;
+#else
+	return !m_ProgramFailed;
+#endif
+}
+
+void SdfPreviewHelper::Begin(ImDrawList* vDrawList, const ImVec2& vTexSize, const float& vPxRange, const bool& vMsdf)
+{
+#if !VULKAN
+	if (!vDrawList || !IsSupported())
+		return;
+
+	// the render of the last frame is done
+	if (m_FrameCount != ImGui::GetFrameCount())
+	{
+		m_FrameParams.clear();
+		m_FrameCount = ImGui::GetFrameCount();
+	}
+
+	SdfPreviewParamsStruct params;
+	auto viewport = ImGui::GetWindowViewport();
+	params.displayPos = viewport->Pos;
+	params.displaySize = viewport->Size;
+	params.texSize = vTexSize;
+	params.pxRange = vPxRange;
+	params.msdf = vMsdf;
+	m_FrameParams.push_back(params); // deque, the previous pointers stay valid
+
+	vDrawList->AddCallback(SetupRenderStateCallback, &m_FrameParams.back());
+#else
+	(void)vDrawList; (void)vTexSize; (void)vPxRange; (void)vMsdf;
+#endif
+}
+
+void SdfPreviewHelper::End(ImDrawList* vDrawList)
+{
+#if !VULKAN
+	if (!vDrawList || !IsSupported())
+		return;
+
+	vDrawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+#else
+	(void)vDrawList;
+#endif
+}
+
+// must be called before the destruction of the opengl context
+void SdfPreviewHelper::Unit()
+{
+#if !VULKAN
+	if (m_Program)
+	{
+		glDeleteProgram(m_Program);
+		m_Program = 0U;
+	}
+#endif
+	m_FrameParams.clear();
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <globals.h>
+#include <imgui/imgui.h>
+
+#include <deque>
+
+// preview of a distance field texture (see SdfGenerator) with a shader
+// the shader is set by a draw list callback, so the draw commands between Begin and End use it
+// the render state of imgui is restored at End
+// opengl only for the moment, with vulkan the raw distance field is displayed
+
+struct SdfPreviewParamsStruct
+{
+	ImVec2 displayPos; // of the viewport, for the projection
+	ImVec2 displaySize;
+	ImVec2 texSize;
+	float pxRange = 0.0f;
+	bool msdf = false;
+};
+
+class SdfPreviewHelper
+{
+private:
+#if !VULKAN
+	GLuint m_Program = 0U;
+	GLint m_ProjMtxLoc = -1;
+	GLint m_TextureLoc = -1;
+	GLint m_PxRangeLoc = -1;
+	GLint m_TexSizeLoc = -1;
+	GLint m_MsdfLoc = -1;
+	bool m_ProgramFailed = false; // no retry each frame
+#endif
+	std::deque<SdfPreviewParamsStruct> m_FrameParams; // datas of the callbacks, alive until the render of the frame
+	int m_FrameCount = -1;
+
+public:
+	bool IsSupported() const;
+	void Begin(ImDrawList* vDrawList, const ImVec2& vTexSize, const float& vPxRange, const bool& vMsdf);
+	void End(ImDrawList* vDrawList);
+	void Unit();
+
+private:
+#if !VULKAN
+	bool CreateProgram();
+	static void SetupRenderStateCallback(const ImDrawList* vParentList, const ImDrawCmd* vCmd);
+#endif
+
+public: // singleton
+	static SdfPreviewHelper* Instance()
+	{
+		static SdfPreviewHelper _instance;
+		return &_instance;
+	}
+
+protected:
+	SdfPreviewHelper() = default; // Prevent construction
+	SdfPreviewHelper(const SdfPreviewHelper&) {}; // Prevent construction by copying
+	SdfPreviewHelper& operator =(const SdfPreviewHelper&) { return *this; }; // Prevent assignment
+	~SdfPreviewHelper() = default; // Prevent unwanted destruction
+};
@@ -26,6 +26,7 @@
 #include <Panes/FinalFontPane.h>
 #include <Panes/GeneratorPane.h>
 #include <Project/ProjectFile.h>
+#include <Project/GlyphInfos.h>
 #include <Res/CustomFont.h>
 
 #define IMGUI_DEFINE_MATH_OPERATORS
@@ -317,6 +318,8 @@ void SelectionHelper::Clear()
 	m_Zone = ct::fvec4(0.0f, 0.0f, 0.5f, 0.5f);
 	m_SelectionForOperation.clear();
 	m_GlyphSelectedStateFirstClick = -1;
+	m_SelectionTransaction.Clear();
+	m_SelectionTransaction.depth = 0;
 }
 
 void SelectionHelper::Load()
@@ -345,6 +348,63 @@ std::set<FontInfosCodePoint>* SelectionHelper::GetSelection()
 	return &m_SelectionForOperation;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+//// SELECTION TRANSACTION ///////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// all source selection changes done until the commit are only recorded
+// so a range or zone selection of n glyphs cost one maps update instead of n
+void SelectionHelper::BeginSelectionTransaction()
+{
+	m_SelectionTransaction.depth++;
+}
+
+void SelectionHelper::CommitSelectionTransaction()
+{
+	if (m_SelectionTransaction.depth > 0)
+		m_SelectionTransaction.depth--;
+
+	if (m_SelectionTransaction.depth == 0)
+	{
+		if (!m_SelectionTransaction.IsEmpty())
+		{
+			// update maps with deltas only
+			FinalFontPane::Instance()->ApplySelectionDelta(
+				m_SelectionTransaction.added,
+				m_SelectionTransaction.removed);
+			m_SelectionTransaction.Clear();
+
+			// count and analyse only once per transaction
+			ProjectFile::Instance()->UpdateCountSelectedGlyphs();
+		}
+	}
+}
+
+bool SelectionHelper::IsInSelectionTransaction() const
+{
+	return (m_SelectionTransaction.depth > 0);
+}
+
+// if vUpdateMaps and no transaction is opened, the change is commited immediately
+// if vUpdateMaps is false and no transaction is opened, the caller is in charge of the maps update
+void SelectionHelper::RegisterSourceSelectionChange(
+	std::shared_ptr<GlyphInfos> vGlyphInfos,
+	bool vSelected, bool vUpdateMaps)
+{
+	if (vGlyphInfos.use_count())
+	{
+		if (vUpdateMaps || IsInSelectionTransaction())
+		{
+			BeginSelectionTransaction();
+			if (vSelected)
+				m_SelectionTransaction.Add(vGlyphInfos);
+			else
+				m_SelectionTransaction.Remove(vGlyphInfos);
+			CommitSelectionTransaction();
+		}
+	}
+}
+
 void SelectionHelper::SelectWithToolOrApply(
 	SelectionContainerEnum vSelectionContainerEnum)
 {
@@ -642,6 +702,8 @@ void SelectionHelper::ApplySelection(
 			{
 				auto selStruct = getSelStruct(vSelectionContainerEnum);
 
+				BeginSelectionTransaction();
+
 				// to Select
 				auto itSel = selStruct->tmpSel.begin();
 				while (itSel != selStruct->tmpSel.end())
@@ -703,7 +765,7 @@ void SelectionHelper::ApplySelection(
 				}
 
 				// update maps
-				PrepareSelection(vSelectionContainerEnum);
+				CommitSelectionTransaction();
 			}
 			else if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_FINAL)
 			{
@@ -752,14 +814,15 @@ void SelectionHelper::SelectAllGlyphs(std::shared_ptr<FontInfos> vFontInfos,
 
 					if (font)
 					{
+						BeginSelectionTransaction();
+
 						for (const auto& glyph : font->Glyphs)
 						{
 							SelectGlyph(vFontInfos, glyph, false, vSelectionContainerEnum);
 						}
 
 						// update maps
-						ProjectFile::Instance()->UpdateCountSelectedGlyphs();
-						PrepareSelection(vSelectionContainerEnum);
+						CommitSelectionTransaction();
 					}
 				}
 			}
@@ -794,14 +857,15 @@ void SelectionHelper::UnSelectAllGlyphs(std::shared_ptr<FontInfos> vFontInfos,
 
 					if (font)
 					{
+						BeginSelectionTransaction();
+
 						for (const auto& glyph : font->Glyphs)
 						{
 							UnSelectGlyph(vFontInfos, glyph, false, vSelectionContainerEnum);
 						}
 
 						// update maps
-						ProjectFile::Instance()->UpdateCountSelectedGlyphs();
-						PrepareSelection(vSelectionContainerEnum);
+						CommitSelectionTransaction();
 					}
 				}
 			}
@@ -833,14 +897,11 @@ void SelectionHelper::SelectGlyph(std::shared_ptr<FontInfos> vFontInfos, ImFontG
 				if (vFontInfos->m_SelectedGlyphs.find(vGlyph.Codepoint) == vFontInfos->m_SelectedGlyphs.end()) // not found
 				{
 					std::string res = vFontInfos->GetGlyphName(vGlyph.Codepoint);
-					vFontInfos->m_SelectedGlyphs[vGlyph.Codepoint] = GlyphInfos::Create(vFontInfos, vGlyph, res, res);
+					auto glyphInfos = GlyphInfos::Create(vFontInfos, vGlyph, res, res);
+					vFontInfos->m_SelectedGlyphs[vGlyph.Codepoint] = glyphInfos;
 					ProjectFile::Instance()->SetProjectChange();
 
-					if (vUpdateMaps)
-					{
-						ProjectFile::Instance()->UpdateCountSelectedGlyphs();
-						PrepareSelection(vSelectionContainerEnum);
-					}
+					RegisterSourceSelectionChange(glyphInfos, true, vUpdateMaps);
 				}
 			}
 			else if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_FINAL)
@@ -909,16 +970,14 @@ void SelectionHelper::UnSelectGlyph(std::shared_ptr<FontInfos> vFontInfos, uint3
 		{
 			if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_SOURCE)
 			{
-				if (vFontInfos->m_SelectedGlyphs.find(vCodePoint) != vFontInfos->m_SelectedGlyphs.end()) // found
+				auto it = vFontInfos->m_SelectedGlyphs.find(vCodePoint);
+				if (it != vFontInfos->m_SelectedGlyphs.end()) // found
 				{
-					vFontInfos->m_SelectedGlyphs.erase(vCodePoint);
+					auto glyphInfos = it->second; // keep it alive for the maps update
+					vFontInfos->m_SelectedGlyphs.erase(it);
 					ProjectFile::Instance()->SetProjectChange();
 
-					if (vUpdateMaps)
-					{
-						ProjectFile::Instance()->UpdateCountSelectedGlyphs();
-						PrepareSelection(vSelectionContainerEnum);
-					}
+					RegisterSourceSelectionChange(glyphInfos, false, vUpdateMaps);
 				}
 			}
 			else if (vSelectionContainerEnum == SelectionContainerEnum::SELECTION_CONTAINER_FINAL)
@@ -937,12 +996,14 @@ void SelectionHelper::UnSelectGlyph(std::shared_ptr<FontInfos> vFontInfos, uint3
 
 void SelectionHelper::RemoveSelectionFromFinal()
 {
+	BeginSelectionTransaction();
+
 	for (auto& codePoint : m_SelectionForOperation)
 	{
 		UnSelectGlyph(codePoint, false, SelectionContainerEnum::SELECTION_CONTAINER_SOURCE);
 	}
 
-	PrepareSelection(SelectionContainerEnum::SELECTION_CONTAINER_SOURCE);
+	CommitSelectionTransaction();
 
 	m_SelectionForOperation.clear();
 }
@@ -1041,7 +1102,7 @@ void SelectionHelper::SelectGlyphByRangeFromStartCodePoint(
 	std::shared_ptr<FontInfos> vFontInfos,
 	ImFontGlyph vGlyph,
 	uint32_t vFontGlyphIndex,
-	bool vUpdateMaps,
+	bool /*vUpdateMaps*/, // range selection is always commited as one transaction
 	SelectionContainerEnum vSelectionContainerEnum)
 {
 	if (ProjectFile::Instance()->IsLoaded())
@@ -1059,6 +1120,8 @@ void SelectionHelper::SelectGlyphByRangeFromStartCodePoint(
 					ImFont* font = vFontInfos->GetImFont();
 					if (font)
 					{
+						BeginSelectionTransaction();
+
 						int idx = vFontGlyphIndex;
 						ImFontGlyph currentGlyph = font->Glyphs[idx];
 						SelectGlyph(vFontInfos, currentGlyph, false, vSelectionContainerEnum);
@@ -1104,10 +1167,8 @@ void SelectionHelper::SelectGlyphByRangeFromStartCodePoint(
 							}
 						}
 
-						if (vUpdateMaps)
-						{
-							PrepareSelection(vSelectionContainerEnum);
-						}
+						// update maps (only applied on the outer commit if nested)
+						CommitSelectionTransaction();
 					}
 				}
 			}
@@ -1233,7 +1294,7 @@ void SelectionHelper::UnSelectGlyphByRangeFromStartCodePoint(
 	std::shared_ptr<FontInfos> vFontInfos,
 	ImFontGlyph vGlyph,
 	uint32_t vFontGlyphIndex,
-	bool vUpdateMaps,
+	bool /*vUpdateMaps*/, // range selection is always commited as one transaction
 	SelectionContainerEnum vSelectionContainerEnum)
 {
 	if (ProjectFile::Instance()->IsLoaded())
@@ -1251,6 +1312,8 @@ void SelectionHelper::UnSelectGlyphByRangeFromStartCodePoint(
 					ImFont* font = vFontInfos->GetImFont();
 					if (font)
 					{
+						BeginSelectionTransaction();
+
 						int idx = vFontGlyphIndex;
 						ImFontGlyph currentGlyph = font->Glyphs[idx];
 						UnSelectGlyph(vFontInfos, currentGlyph, false, vSelectionContainerEnum);
@@ -1296,10 +1359,8 @@ void SelectionHelper::UnSelectGlyphByRangeFromStartCodePoint(
 							}
 						}
 
-						if (vUpdateMaps)
-						{
-							PrepareSelection(vSelectionContainerEnum);
-						}
+						// update maps (only applied on the outer commit if nested)
+						CommitSelectionTransaction();
 					}
 				}
 			}
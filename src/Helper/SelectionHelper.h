@@ -104,6 +104,40 @@ struct TemporarySelectionStruct
 	}
 };
 
+class GlyphInfos;
+// source selection changes collected between BeginSelectionTransaction / CommitSelectionTransaction
+// the derived maps (final pane views, counts) are updated once with the deltas at commit
+struct SelectionTransactionStruct
+{
+	int depth = 0; // transactions can be nested, only the outer commit apply the changes
+	std::set<std::shared_ptr<GlyphInfos>> added;
+	std::set<std::shared_ptr<GlyphInfos>> removed;
+
+	void Add(std::shared_ptr<GlyphInfos> vGlyphInfos)
+	{
+		if (removed.find(vGlyphInfos) != removed.end()) // found
+			removed.erase(vGlyphInfos);
+		else
+			added.emplace(vGlyphInfos);
+	}
+	void Remove(std::shared_ptr<GlyphInfos> vGlyphInfos)
+	{
+		if (added.find(vGlyphInfos) != added.end()) // found => selected and unselected in the same transaction
+			added.erase(vGlyphInfos);
+		else
+			removed.emplace(vGlyphInfos);
+	}
+	bool IsEmpty() const
+	{
+		return added.empty() && removed.empty();
+	}
+	void Clear()
+	{
+		added.clear();
+		removed.clear();
+	}
+};
+
 class ProjectFile;
 class SelectionHelper : public conf::ConfigAbstract
 {
@@ -125,6 +159,7 @@ private: // structs / classes
 	ReRangeStruct m_ReRangeStruct; // re range : change range of selection
 	TemporarySelectionStruct m_TmpSelectionSrc; // for selection of glyphs from sources
 	TemporarySelectionStruct m_TmpSelectionDst; // for operations on final seletected glyphs // like re range by glyph group
+	SelectionTransactionStruct m_SelectionTransaction; // pending source selection changes
 
 public:
 	typedef std::pair<uint32_t, std::string> FontInfosCodePoint_ToLoad;
@@ -152,6 +187,12 @@ public:
 
 public:
 	std::set<FontInfosCodePoint>* GetSelection();
+
+public: // selection transaction
+	void BeginSelectionTransaction();
+	void CommitSelectionTransaction();
+	bool IsInSelectionTransaction() const;
+
 public:
 	void SelectWithToolOrApply(
 		SelectionContainerEnum vSelectionContainerEnum);
@@ -199,6 +240,9 @@ private:
 private: // selection for view modes
 	void PrepareSelection(
 		SelectionContainerEnum vSelectionContainerEnum);
+	void RegisterSourceSelectionChange(
+		std::shared_ptr<GlyphInfos> vGlyphInfos,
+		bool vSelected, bool vUpdateMaps);
 	
 private: // ReRange
 	void FinalizeSelectionForOperations();
@@ -0,0 +1,277 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TaskSystem.h"
+
+#include <Helper/FrameActionSystem.h>
+#include <Helper/EventLoopHelper.h>
+#include <Helper/Messaging.h>
+
+#include <algorithm>
+#include <exception>
+
+///////////////////////////////////////////////////////////////////////////////////
+//// TASK CONTEXT /////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+TaskContext::TaskContext(const std::string& vName)
+	: m_Name(vName), m_CancelRequested(false), m_Progress(0.0f), m_State((int)TaskStateEnum::TASK_STATE_PENDING)
+{
+
+}
+
+void TaskContext::SetProgress(const float& vProgress, const std::string& vMsg)
+{
+	m_Progress = std::min(std::max(vProgress, 0.0f), 1.0f);
+
+	if (!vMsg.empty())
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_ProgressMsg = vMsg;
+	}
+
+	EventLoopHelper::Instance()->WakeUp(); // for display the progress in event driven mode
+}
+
+void TaskContext::SetError(const std::string& vErrorMsg)
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	m_ErrorMsg = vErrorMsg;
+}
+
+std::string TaskContext::GetProgressMsg() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_ProgressMsg;
+}
+
+std::string TaskContext::GetErrorMsg() const
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_ErrorMsg;
+}
+
+bool TaskContext::IsFinished() const
+{
+	const auto state = GetState();
+	return
+		state == TaskStateEnum::TASK_STATE_DONE ||
+		state == TaskStateEnum::TASK_STATE_FAILED ||
+		state == TaskStateEnum::TASK_STATE_CANCELLED;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// TASK SYSTEM //////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+TaskSystem::~TaskSystem()
+{
+	Unit();
+}
+
+TaskHandle TaskSystem::Submit(const std::string& vName, TaskJob vJob, TaskCompletion vCompletion)
+{
+	auto task = std::make_shared<TaskItem>();
+	task->handle = std::make_shared<TaskContext>(vName);
+	task->handle->m_Future = task->promise.get_future().share();
+	task->job = vJob;
+	task->completion = vCompletion;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		StartWorkers();
+		m_PendingTasks.push_back(task);
+		m_ActiveTasks.push_back(task->handle);
+	}
+	m_Condition.notify_one();
+
+	return task->handle;
+}
+
+bool TaskSystem::ProcessCompletions(FrameActionSystem* vActionSystem)
+{
+	std::deque<std::shared_ptr<TaskItem>> finishedTasks;
+	bool someTasksRunning = false;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		finishedTasks.swap(m_FinishedTasks);
+		m_ActiveTasks.erase(std::remove_if(m_ActiveTasks.begin(), m_ActiveTasks.end(),
+			[](const TaskHandle& vTask) { return vTask->IsFinished(); }), m_ActiveTasks.end());
+		someTasksRunning = !m_ActiveTasks.empty();
+	}
+
+	for (auto& task : finishedTasks)
+	{
+		auto handle = task->handle;
+		auto completion = task->completion;
+		auto action = [handle, completion]()
+		{
+			if (handle->GetState() == TaskStateEnum::TASK_STATE_FAILED)
+			{
+				auto err = handle->GetErrorMsg();
+				Messaging::Instance()->AddError(true, nullptr, nullptr,
+					"Task %s failed : %s", handle->GetName().c_str(), err.empty() ? "unknown error" : err.c_str());
+			}
+
+			if (completion)
+				completion(handle);
+
+			return true;
+		};
+
+		if (vActionSystem)
+			vActionSystem->Add(action);
+		else
+			action();
+	}
+
+	return someTasksRunning;
+}
+
+void TaskSystem::CancelAll()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	for (auto& task : m_ActiveTasks)
+		task->Cancel();
+}
+
+void TaskSystem::Unit()
+{
+	std::vector<std::thread> workers;
+
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		for (auto& task : m_ActiveTasks)
+			task->Cancel();
+		m_StopThreads = true;
+		workers.swap(m_Workers);
+	}
+	m_Condition.notify_all();
+
+	for (auto& worker : workers)
+	{
+		if (worker.joinable())
+			worker.join();
+	}
+
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	// never started
+	for (auto& task : m_PendingTasks)
+	{
+		task->handle->m_State = (int)TaskStateEnum::TASK_STATE_CANCELLED;
+		task->promise.set_value(false);
+	}
+	m_PendingTasks.clear();
+	m_FinishedTasks.clear();
+	m_ActiveTasks.clear();
+	m_StopThreads = false; // the workers can be restarted by a next submit
+}
+
+size_t TaskSystem::GetCountWorkers()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_Workers.size();
+}
+
+std::vector<TaskHandle> TaskSystem::GetActiveTasks()
+{
+	std::lock_guard<std::mutex> lock(m_Mutex);
+	return m_ActiveTasks;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PRIVATE //////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// m_Mutex must be locked
+void TaskSystem::StartWorkers()
+{
+	if (m_Workers.empty())
+	{
+		// the main thread keep one core
+		const size_t countThreads = (size_t)std::max(1, (int)std::thread::hardware_concurrency() - 1);
+		for (size_t i = 0; i < countThreads; ++i)
+			m_Workers.emplace_back(&TaskSystem::WorkerThread, this);
+	}
+}
+
+void TaskSystem::WorkerThread()
+{
+	while (true)
+	{
+		std::shared_ptr<TaskItem> task;
+
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_Condition.wait(lock, [this]() { return m_StopThreads || !m_PendingTasks.empty(); });
+			if (m_StopThreads)
+				break;
+			task = m_PendingTasks.front();
+			m_PendingTasks.pop_front();
+		}
+
+		RunTask(task);
+
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			m_FinishedTasks.push_back(task);
+		}
+
+		EventLoopHelper::Instance()->WakeUp(); // the completion is waiting the main thread
+	}
+}
+
+void TaskSystem::RunTask(std::shared_ptr<TaskItem> vTask)
+{
+	auto& context = *vTask->handle;
+
+	bool res = false;
+	if (!context.IsCancelRequested() && vTask->job)
+	{
+		context.m_State = (int)TaskStateEnum::TASK_STATE_RUNNING;
+
+		try
+		{
+			res = vTask->job(context);
+		}
+		catch (const std::exception& e)
+		{
+			context.SetError(e.what());
+			res = false;
+		}
+		catch (...)
+		{
+			context.SetError("unknown exception");
+			res = false;
+		}
+	}
+
+	if (context.IsCancelRequested())
+		context.m_State = (int)TaskStateEnum::TASK_STATE_CANCELLED;
+	else if (res)
+		context.m_State = (int)TaskStateEnum::TASK_STATE_DONE;
+	else
+		context.m_State = (int)TaskStateEnum::TASK_STATE_FAILED;
+
+	if (res)
+		context.m_Progress = 1.0f;
+
+	vTask->promise.set_value(res);
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <future>
+#include <condition_variable>
+
+// shared pool of worker threads for the long jobs (font parsing, generation..)
+// - a task run a job in a worker thread, the job can check his cancel token and report a progress
+// - the completion function of a task is called in the main thread, by the FrameActionSystem of the MainFrame
+//   (see ProcessCompletions), so the completion can touch the project, the panes, imgui, Messaging..
+// - the error of a task (job returning false with an error msg, or throwing) is reported by Messaging in the main thread
+// the jobs can use Messaging (queued, then added in the main thread), but not imgui, not thread safe
+
+enum class TaskStateEnum
+{
+	TASK_STATE_PENDING = 0, // waiting a free worker
+	TASK_STATE_RUNNING,
+	TASK_STATE_DONE,
+	TASK_STATE_FAILED,
+	TASK_STATE_CANCELLED,
+	TASK_STATE_Count
+};
+
+// view of a task given to the job, shared with his TaskHandle
+class TaskContext
+{
+	friend class TaskSystem;
+
+private:
+	std::string m_Name;
+	std::atomic<bool> m_CancelRequested;
+	std::atomic<float> m_Progress; // [0:1]
+	std::atomic<int> m_State;
+	mutable std::mutex m_Mutex; // for the strings
+	std::string m_ProgressMsg;
+	std::string m_ErrorMsg;
+	std::shared_future<bool> m_Future;
+
+public:
+	explicit TaskContext(const std::string& vName);
+
+	// cancel token, the job must check it time to time and return asap
+	void Cancel() { m_CancelRequested = true; }
+	bool IsCancelRequested() const { return m_CancelRequested; }
+
+	// from the job
+	void SetProgress(const float& vProgress, const std::string& vMsg = "");
+	void SetError(const std::string& vErrorMsg);
+
+	// from everywhere
+	const std::string& GetName() const { return m_Name; }
+	float GetProgress() const { return m_Progress; }
+	std::string GetProgressMsg() const;
+	std::string GetErrorMsg() const;
+	TaskStateEnum GetState() const { return (TaskStateEnum)m_State.load(); }
+	bool IsFinished() const; // done, failed or cancelled
+	// result of the job, wait the end of the task if not finished (not from the main thread)
+	std::shared_future<bool> GetFuture() const { return m_Future; }
+};
+
+typedef std::shared_ptr<TaskContext> TaskHandle;
+// return false if failed, the error msg can be set by TaskContext::SetError
+typedef std::function<bool(TaskContext& vContext)> TaskJob;
+// called in the main thread, after the job (even if failed or cancelled)
+typedef std::function<void(const TaskHandle& vTask)> TaskCompletion;
+
+class FrameActionSystem;
+class TaskSystem
+{
+private:
+	struct TaskItem
+	{
+		TaskHandle handle;
+		TaskJob job;
+		TaskCompletion completion;
+		std::promise<bool> promise;
+	};
+
+private:
+	std::mutex m_Mutex;
+	std::condition_variable m_Condition;
+	std::vector<std::thread> m_Workers; // started at first submit
+	std::deque<std::shared_ptr<TaskItem>> m_PendingTasks;
+	std::deque<std::shared_ptr<TaskItem>> m_FinishedTasks; // waiting their completion in the main thread
+	std::vector<TaskHandle> m_ActiveTasks; // pending or running, for display the progress
+	bool m_StopThreads = false;
+
+public:
+	// run the job in a worker, the completion will be called in the main thread
+	TaskHandle Submit(const std::string& vName, TaskJob vJob, TaskCompletion vCompletion = nullptr);
+	// run a function in a worker and get his result by a future, without completion in the main thread
+	// for split a job in parallel parts. not to call from a job, if waiting the future (the workers can be all busy)
+	template<typename T>
+	std::future<T> Async(std::function<T()> vFunc)
+	{
+		auto packaged = std::make_shared<std::packaged_task<T()>>(vFunc);
+		auto future = packaged->get_future();
+		Submit("Async", [packaged](TaskContext&) { (*packaged)(); return true; });
+		return future;
+	}
+
+	// called each frame by the MainFrame, in the main thread
+	// give the completions of the finished tasks to the action system
+	// return true if some tasks are running (so new frames are needed for the progress)
+	bool ProcessCompletions(FrameActionSystem* vActionSystem);
+
+	void CancelAll();
+	// cancel all and wait the end of the running tasks, the completions are not called
+	// to call before the destruction of the things used by the jobs (project, fonts..)
+	void Unit();
+
+	size_t GetCountWorkers();
+	std::vector<TaskHandle> GetActiveTasks();
+
+private:
+	void StartWorkers();
+	void WorkerThread();
+	void RunTask(std::shared_ptr<TaskItem> vTask);
+
+public: // singleton
+	static TaskSystem* Instance()
+	{
+		static TaskSystem _instance;
+		return &_instance;
+	}
+
+protected:
+	TaskSystem() = default; // Prevent construction
+	TaskSystem(const TaskSystem&) {}; // Prevent construction by copying
+	TaskSystem& operator =(const TaskSystem&) { return *this; }; // Prevent assignment
+	~TaskSystem(); // Prevent unwanted destruction
+};
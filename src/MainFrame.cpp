@@ -38,11 +38,14 @@
 #include <Helper/AssetManager.h>
 #include <Res/CustomFont.h>
 #include <Helper/TextureHelper.h>
+#include <Helper/EventLoopHelper.h>
+#include <Helper/SdfPreviewHelper.h>
+#include <Helper/TaskSystem.h>
+#include <Helper/FrameProfiler.h>
 
 #include <Panes/Manager/LayoutManager.h>
-#ifdef _DEBUG
 #include <Panes/DebugPane.h>
-#endif
+#include <Panes/MemoryPane.h>
 #include <Panes/ParamsPane.h>
 #include <Panes/FinalFontPane.h>
 #include <Panes/SelectionFontPane.h>
@@ -96,9 +99,8 @@ void MainFrame::Init()
 	LayoutManager::Instance()->AddPane(FontStructurePane::Instance(), "Font Structure", STRUCTURE_PANE, PaneDisposal::CENTRAL, false, false);
 	LayoutManager::Instance()->AddPane(GlyphPane::Instance(), "Glyph", GLYPH_PANE, PaneDisposal::CENTRAL, false, false);
 	LayoutManager::Instance()->AddPane(FontPreviewPane::Instance(), "Font Preview", PREVIEW_PANE, PaneDisposal::BOTTOM, false, false);
-#ifdef _DEBUG
 	LayoutManager::Instance()->AddPane(DebugPane::Instance(), "Debug", DEBUG_PANE, PaneDisposal::LEFT, false, false);
-#endif
+	LayoutManager::Instance()->AddPane(MemoryPane::Instance(), "Memory", MEMORY_PANE, PaneDisposal::BOTTOM, false, false);
 #ifdef USE_SHADOW
 	AssetManager::Instance()->LoadTexture2D("btn", "src/res/btn.png");
 #endif
@@ -108,6 +110,13 @@ void MainFrame::Unit()
 {
 	SaveConfigFile("config.xml");
 
+	// the jobs can use the project, the fonts..
+	TaskSystem::Instance()->Unit();
+
+	// gpu ressources, while the context is alive
+	GeneratorPane::Instance()->Unit();
+	SdfPreviewHelper::Instance()->Unit();
+
 	ProjectFile::Instance()->Clear();
 }
 
@@ -122,10 +131,16 @@ void MainFrame::LoadProject(const std::string& vFilePathName)
 	if (ProjectFile::Instance()->LoadAs(vFilePathName))
 	{
 		SetAppTitle(vFilePathName);
+		// only the selected font is loaded now, the others at first display or generation
 		for (auto it : ProjectFile::Instance()->m_Fonts)
 		{
 			std::string absPath = ProjectFile::Instance()->GetAbsolutePath(it.second->m_FontFilePathName);
-			ParamsPane::Instance()->OpenFont(absPath, false);
+			it.second->DeferLoadFont(absPath);
+			if (ProjectFile::Instance()->m_FontToMergeIn.empty() ||
+				ProjectFile::Instance()->m_FontToMergeIn == it.second->m_FontFileName)
+			{
+				ParamsPane::Instance()->SelectFont(it.second);
+			}
 		}
 		ProjectFile::Instance()->UpdateCountSelectedGlyphs();
 		ProjectFile::Instance()->SetProjectChange(false);
@@ -162,6 +177,8 @@ bool MainFrame::Display(ImVec2 vPos, ImVec2 vSize)
 	m_DisplayPos = vPos;
 	m_DisplaySize = vSize;
 
+	FrameProfiler::Instance()->NewFrame();
+
 	if (ImGui::BeginMainMenuBar())
 	{
 		DrawMainMenuBar();
@@ -186,9 +203,8 @@ bool MainFrame::Display(ImVec2 vPos, ImVec2 vSize)
 	{
 		Messaging::Instance()->Draw();
 
-		// ImGui Infos
-		const auto io = ImGui::GetIO();
-		const auto fps = ct::toStr("%.1f ms/frame (%.1f fps)", 1000.0f / io.Framerate, io.Framerate);
+		// Frame time Infos
+		const auto fps = EventLoopHelper::Instance()->GetFrameTimeInfos();
 		const auto size = ImGui::CalcTextSize(fps.c_str());
 		ImGui::Spacing(ImGui::GetContentRegionAvail().x - size.x - ImGui::GetStyle().FramePadding.x * 2.0f);
 		ImGui::Text("%s", fps.c_str());
@@ -209,7 +225,10 @@ bool MainFrame::Display(ImVec2 vPos, ImVec2 vSize)
 	LayoutManager::Instance()->InitAfterFirstDisplay(m_DisplaySize);
 
 	if (TextureHelper::sNeedToSkipRendering)
+	{
+		EventLoopHelper::Instance()->RequestFrames(); // the skipped frame must be redrawn
 		return false; // skip on frame if texture was destroyed
+	}
 
 	return true;
 }
@@ -298,6 +317,23 @@ void MainFrame::DrawMainMenuBar()
 			ImGui::EndMenu();
 		}
 
+		if (ImGui::MenuItem("Event Driven Loop", "", &EventLoopHelper::Instance()->m_EventDriven))
+		{
+			EventLoopHelper::Instance()->RequestFrames();
+		}
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Redraw only on events when idle, for save cpu and gpu\nelse redraw at each vsync");
+
+		if (ImGui::MenuItem("Frame Profiler", "", &FrameProfiler::Instance()->m_Enabled))
+		{
+			if (FrameProfiler::Instance()->m_Enabled)
+				LayoutManager::Instance()->ShowSpecificPane(DEBUG_PANE);
+			else
+				FrameProfiler::Instance()->Clear();
+		}
+		if (ImGui::IsItemHovered())
+			ImGui::SetTooltip("Cpu time, draw commands and vertices of each pane, displayed in the Debug pane");
+
 		ImGui::EndMenu();
 	}
 
@@ -314,7 +350,12 @@ void MainFrame::DrawMainMenuBar()
 
 void MainFrame::DisplayDialogsAndPopups()
 {
-	m_ActionSystem.RunActions(); 
+	// the completions of the background tasks are run as actions
+	if (TaskSystem::Instance()->ProcessCompletions(&m_ActionSystem))
+		EventLoopHelper::Instance()->RequestFrames(); // for display the progress of the running tasks
+
+	if (m_ActionSystem.RunActions())
+		EventLoopHelper::Instance()->RequestFrames(); // the next action will be run at next frame
 
 	if (ProjectFile::Instance()->IsLoaded())
 	{
@@ -455,7 +496,7 @@ void MainFrame::SetAppTitle(const std::string& vFilePathName)
 	if (ps.isOk)
 	{
 		char bufTitle[1024];
-		snprintf(bufTitle, 1023, "ImGuiFontStudio %s - Project : %s.ifs", IMGUIFONTSTUDIO_VERSION, ps.name.c_str());
+		snprintf(bufTitle, 1023, "ImGuiFontStudio %s - Project : %s.%s", IMGUIFONTSTUDIO_VERSION, ps.name.c_str(), ps.ext.c_str());
 		glfwSetWindowTitle(m_Window, bufTitle);
 	}
 }
@@ -576,7 +617,7 @@ open project :
 			if (ProjectFile::Instance()->IsLoaded())
 				path = ProjectFile::Instance()->m_ProjectFilePath;
 			ImGuiFileDialog::Instance()->OpenModal(
-				"OpenProjectDlg", "Open Project File", "Project File{.ifs}", path);
+				"OpenProjectDlg", "Open Project File", "Project File{.ifsb,.ifs}", path);
 			return true;
 		});
 	m_ActionSystem.Add([this]()
@@ -623,7 +664,7 @@ save project :
 				if (ProjectFile::Instance()->IsLoaded())
 					path = ProjectFile::Instance()->m_ProjectFilePath;
 				ImGuiFileDialog::Instance()->OpenModal(
-					"SaveProjectDlg", "Save Project File", "Project File{.ifs}", path);
+					"SaveProjectDlg", "Save Project File", "Compact Project File{.ifsb},Xml Project File{.ifs}", path);
 			}
 			return true;
 		});
@@ -647,7 +688,7 @@ save as project :
 			if (ProjectFile::Instance()->IsLoaded())
 				path = ProjectFile::Instance()->m_ProjectFilePath;
 			ImGuiFileDialog::Instance()->OpenModal(
-				"SaveProjectDlg", "Save Project File", "Project File{.ifs}", path,
+				"SaveProjectDlg", "Save Project File", "Compact Project File{.ifsb},Xml Project File{.ifs}", path,
 				1, nullptr, ImGuiFileDialogFlags_ConfirmOverwrite);
 			return true;
 		});
@@ -769,7 +810,7 @@ bool MainFrame::Action_UnSavedDialog_SaveProject()
 				if (ProjectFile::Instance()->IsLoaded())
 					path = ProjectFile::Instance()->m_ProjectFilePath;
 				ImGuiFileDialog::Instance()->OpenModal(
-					"SaveProjectDlg", "Save Project File", "Project File{.ifs}",
+					"SaveProjectDlg", "Save Project File", "Compact Project File{.ifsb},Xml Project File{.ifs}",
 					path, 1, nullptr, ImGuiFileDialogFlags_ConfirmOverwrite);
 				return true;
 			});
@@ -790,7 +831,7 @@ void MainFrame::Action_UnSavedDialog_SaveAsProject()
 			if (ProjectFile::Instance()->IsLoaded())
 				path = ProjectFile::Instance()->m_ProjectFilePath;
 			ImGuiFileDialog::Instance()->OpenModal(
-				"SaveProjectDlg", "Save Project File", "Project File{.ifs}",
+				"SaveProjectDlg", "Save Project File", "Compact Project File{.ifsb},Xml Project File{.ifs}",
 				path, 1, nullptr, ImGuiFileDialogFlags_ConfirmOverwrite);
 			return true;
 		});
@@ -961,6 +1002,8 @@ std::string MainFrame::getXml(const std::string& vOffset, const std::string& vUs
 	str += vOffset + "<showaboutdialog>" + (m_ShowAboutDialog ? "true" : "false") + "</showaboutdialog>\n";
 	str += vOffset + "<showimgui>" + (m_ShowImGui ? "true" : "false") + "</showimgui>\n";
 	str += vOffset + "<showmetric>" + (m_ShowMetric ? "true" : "false") + "</showmetric>\n";
+	str += vOffset + "<eventdrivenloop>" + (EventLoopHelper::Instance()->m_EventDriven ? "true" : "false") + "</eventdrivenloop>\n";
+	str += vOffset + "<frameprofiler>" + (FrameProfiler::Instance()->m_Enabled ? "true" : "false") + "</frameprofiler>\n";
 	str += vOffset + "<project>" + ProjectFile::Instance()->m_ProjectFilePathName + "</project>\n";
 	
 	return str;
@@ -994,6 +1037,10 @@ bool MainFrame::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement* vP
 		m_ShowImGui = ct::ivariant(strValue).GetB();
 	else if (strName == "showmetric")
 		m_ShowMetric = ct::ivariant(strValue).GetB();
+	else if (strName == "eventdrivenloop")
+		EventLoopHelper::Instance()->m_EventDriven = ct::ivariant(strValue).GetB();
+	else if (strName == "frameprofiler")
+		FrameProfiler::Instance()->m_Enabled = ct::ivariant(strValue).GetB();
 
 	return true;
 }
\ No newline at end of file
@@ -17,14 +17,13 @@
  * limitations under the License.
  */
 
-#ifdef _DEBUG
-
 #include "DebugPane.h"
 
 #include <MainFrame.h>
 
 #include <Panes/Manager/LayoutManager.h>
 #include <Gui/ImWidgets.h>
+#include <Helper/FrameProfiler.h>
 
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui/imgui_internal.h>
@@ -89,6 +88,12 @@ void DebugPane::DrawDebugPane()
 			//ImGuiWindowFlags_NoResize |
 			ImGuiWindowFlags_NoBringToFrontOnFocus))
 		{
+			if (FrameProfiler::Instance()->m_Enabled)
+			{
+				DrawFrameProfilerPane();
+			}
+
+#ifdef _DEBUG
 			if (ProjectFile::Instance()->IsLoaded())
 			{
 				if (LayoutManager::Instance()->IsSpecificPaneFocused(m_PaneFlag))
@@ -96,6 +101,7 @@ void DebugPane::DrawDebugPane()
 					DrawDebugGlyphPane();
 				}
 			}
+#endif
 		}
 
 		ImGui::End();
@@ -195,4 +201,64 @@ void DebugPane::DrawDebugGlyphPane()
 	}
 }
 
-#endif
\ No newline at end of file
+// cpu time of each pane over the last frames (see FrameProfiler)
+// same scale for all the histograms, for compare the panes
+void DebugPane::DrawFrameProfilerPane()
+{
+	const auto& entries = FrameProfiler::Instance()->GetEntries();
+
+	if (ImGui::CollapsingHeader("Frame Profiler", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		if (ImGui::ContrastedButton("Reset"))
+		{
+			FrameProfiler::Instance()->Clear();
+			return;
+		}
+
+		float maxTimeInMs = 0.1f; // not a null scale
+		for (const auto& entry : entries)
+			maxTimeInMs = ct::maxi(maxTimeInMs, entry.maxTimeInMs);
+
+		static ImGuiTableFlags flags =
+			ImGuiTableFlags_SizingFixedFit |
+			ImGuiTableFlags_RowBg |
+			ImGuiTableFlags_Borders |
+			ImGuiTableFlags_Resizable;
+
+		if (ImGui::BeginTable("##FrameProfilerTable", 7, flags))
+		{
+			ImGui::TableSetupColumn("Pane");
+			ImGui::TableSetupColumn("Last");
+			ImGui::TableSetupColumn("Avg");
+			ImGui::TableSetupColumn("Max");
+			ImGui::TableSetupColumn("Cmds");
+			ImGui::TableSetupColumn("Vtx");
+			ImGui::TableSetupColumn("History", ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableHeadersRow();
+
+			int idx = 0;
+			for (const auto& entry : entries)
+			{
+				ImGui::PushID(idx++);
+				ImGui::TableNextRow();
+				if (ImGui::TableSetColumnIndex(0)) ImGui::Text("%s", entry.name.c_str());
+				if (ImGui::TableSetColumnIndex(1)) ImGui::Text("%.2f ms", entry.lastTimeInMs);
+				if (ImGui::TableSetColumnIndex(2)) ImGui::Text("%.2f ms", entry.averageTimeInMs);
+				if (ImGui::TableSetColumnIndex(3)) ImGui::Text("%.2f ms", entry.maxTimeInMs);
+				if (!entry.windowName.empty())
+				{
+					if (ImGui::TableSetColumnIndex(4)) ImGui::Text("%i", entry.countDrawCmds);
+					if (ImGui::TableSetColumnIndex(5)) ImGui::Text("%i", entry.countVertices);
+				}
+				if (ImGui::TableSetColumnIndex(6))
+				{
+					ImGui::PlotHistogram("##history", entry.samples, FRAME_PROFILER_COUNT_SAMPLES, entry.sampleOffset,
+						nullptr, 0.0f, maxTimeInMs, ImVec2(ImGui::GetContentRegionAvail().x, ImGui::GetTextLineHeight() * 2.0f));
+				}
+				ImGui::PopID();
+			}
+
+			ImGui::EndTable();
+		}
+	}
+}
@@ -15,8 +15,6 @@
  */
 #pragma once
 
-#ifdef _DEBUG
-
 #include <Panes/Abstract/AbstractPane.h>
 
 #include <imgui/imgui.h>
@@ -45,6 +43,7 @@ public:
 private:
 	void DrawDebugPane();
 	void DrawDebugGlyphPane();
+	void DrawFrameProfilerPane();
 
 public:
 	void SetGlyphToDebug(std::weak_ptr<GlyphInfos> vGlyphInfos);
@@ -66,5 +65,3 @@ protected:
 	DebugPane& operator =(const DebugPane&) { return *this; }; // Prevent assignment
 	~DebugPane(); // Prevent unwanted destruction};
 };
-
-#endif
\ No newline at end of file
@@ -23,6 +23,7 @@
 #include <Gui/ImWidgets.h>
 #include <Panes/Manager/LayoutManager.h>
 #include <Res/CustomFont.h>
+#include <Helper/GlyphBatchHelper.h>
 #include <Helper/SelectionHelper.h>
 #include <Panes/GlyphPane.h>
 #include <Project/GlyphInfos.h>
@@ -33,6 +34,7 @@
 #include <imgui/imgui_internal.h>
 
 #include <cinttypes> // printf zu
+#include <algorithm>
 
 static char sGlyphNameBuffer[512] = "\0";
 
@@ -171,6 +173,9 @@ void FinalFontPane::DrawFinalFontPane()
 						ImGui::EndMenuBar();
 					}
 
+					// one draw call per font texture for all the glyphs
+					GlyphBatchHelper::Instance()->Begin(ImGui::GetWindowDrawList());
+
 					if (m_FinalFontPaneModeFlags & FinalFontPaneModeFlags::FINAL_FONT_PANE_BY_FONT_NO_ORDER)
 					{
 						DrawSelectionsByFontNoOrder(ProjectFile::Instance()->m_FinalPane_ShowGlyphTooltip);
@@ -195,6 +200,8 @@ void FinalFontPane::DrawFinalFontPane()
 					{
 						DrawSelectionMergedOrderedByGlyphNames();
 					}
+
+					GlyphBatchHelper::Instance()->End();
 				}
 			}
 		}
@@ -245,6 +252,129 @@ void FinalFontPane::PrepareSelection()
 	}
 }
 
+template<typename T>
+static void EraseGlyphFromMap(
+	std::map<T, std::vector<std::shared_ptr<GlyphInfos>>>& vMap,
+	const T& vKey, const std::shared_ptr<GlyphInfos>& vGlyphInfos)
+{
+	auto it = vMap.find(vKey);
+	if (it != vMap.end()) // found
+	{
+		auto& glyphs = it->second;
+		glyphs.erase(std::remove(glyphs.begin(), glyphs.end(), vGlyphInfos), glyphs.end());
+		if (glyphs.empty())
+			vMap.erase(it);
+	}
+}
+
+// update the prepared views with the glyphs added / removed from sources
+// called once per selection transaction (see SelectionHelper::CommitSelectionTransaction)
+// a view not yet prepared (empty) is fully prepared, else only the deltas are applied
+void FinalFontPane::ApplySelectionDelta(
+	const std::set<std::shared_ptr<GlyphInfos>>& vAdded,
+	const std::set<std::shared_ptr<GlyphInfos>>& vRemoved)
+{
+	if (vAdded.empty() && vRemoved.empty())
+		return;
+
+	// fonts touched by this delta
+	std::set<std::shared_ptr<FontInfos>> fonts;
+	for (const auto& glyphInfos : vAdded)
+	{
+		auto fontInfos = glyphInfos->GetFontInfos().lock();
+		if (fontInfos)
+			fonts.emplace(fontInfos);
+	}
+	for (const auto& glyphInfos : vRemoved)
+	{
+		auto fontInfos = glyphInfos->GetFontInfos().lock();
+		if (fontInfos)
+			fonts.emplace(fontInfos);
+	}
+
+	// by font views, only for touched fonts
+	for (const auto& fontInfos : fonts)
+	{
+		if (fontInfos->m_GlyphsOrderedByCodePoints.empty())
+		{
+			PrepareSelectionByFontOrderedByCodePoint_OneFontOnly(fontInfos);
+		}
+		else
+		{
+			for (const auto& glyphInfos : vRemoved)
+			{
+				if (glyphInfos->GetFontInfos().lock() == fontInfos)
+					EraseGlyphFromMap(fontInfos->m_GlyphsOrderedByCodePoints, glyphInfos->newCodePoint, glyphInfos);
+			}
+			for (const auto& glyphInfos : vAdded)
+			{
+				if (glyphInfos->GetFontInfos().lock() == fontInfos)
+					fontInfos->m_GlyphsOrderedByCodePoints[glyphInfos->newCodePoint].push_back(glyphInfos);
+			}
+		}
+
+		if (fontInfos->m_GlyphsOrderedByGlyphName.empty())
+		{
+			PrepareSelectionByFontOrderedByGlyphNames_OneFontOnly(fontInfos);
+		}
+		else
+		{
+			for (const auto& glyphInfos : vRemoved)
+			{
+				if (glyphInfos->GetFontInfos().lock() == fontInfos)
+					EraseGlyphFromMap(fontInfos->m_GlyphsOrderedByGlyphName, glyphInfos->newHeaderName, glyphInfos);
+			}
+			for (const auto& glyphInfos : vAdded)
+			{
+				if (glyphInfos->GetFontInfos().lock() == fontInfos)
+					fontInfos->m_GlyphsOrderedByGlyphName[glyphInfos->newHeaderName].push_back(glyphInfos);
+			}
+		}
+	}
+
+	// merged views
+	if (m_GlyphsMergedNoOrder.empty())
+	{
+		PrepareSelectionMergedNoOrder();
+	}
+	else
+	{
+		if (!vRemoved.empty())
+		{
+			m_GlyphsMergedNoOrder.erase(std::remove_if(m_GlyphsMergedNoOrder.begin(), m_GlyphsMergedNoOrder.end(),
+				[&vRemoved](const std::shared_ptr<GlyphInfos>& vGlyphInfos)
+				{
+					return vRemoved.find(vGlyphInfos) != vRemoved.end(); // found
+				}), m_GlyphsMergedNoOrder.end());
+		}
+		m_GlyphsMergedNoOrder.insert(m_GlyphsMergedNoOrder.end(), vAdded.begin(), vAdded.end());
+	}
+
+	if (m_GlyphsMergedOrderedByCodePoints.empty())
+	{
+		PrepareSelectionMergedOrderedByCodePoint();
+	}
+	else
+	{
+		for (const auto& glyphInfos : vRemoved)
+			EraseGlyphFromMap(m_GlyphsMergedOrderedByCodePoints, glyphInfos->newCodePoint, glyphInfos);
+		for (const auto& glyphInfos : vAdded)
+			m_GlyphsMergedOrderedByCodePoints[glyphInfos->newCodePoint].push_back(glyphInfos);
+	}
+
+	if (m_GlyphsMergedOrderedByGlyphName.empty())
+	{
+		PrepareSelectionMergedOrderedByGlyphNames();
+	}
+	else
+	{
+		for (const auto& glyphInfos : vRemoved)
+			EraseGlyphFromMap(m_GlyphsMergedOrderedByGlyphName, glyphInfos->newHeaderName, glyphInfos);
+		for (const auto& glyphInfos : vAdded)
+			m_GlyphsMergedOrderedByGlyphName[glyphInfos->newHeaderName].push_back(glyphInfos);
+	}
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////
 ////// PRIVATE ////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////////////////
@@ -498,6 +628,7 @@ void FinalFontPane::DrawSelectionsByFontNoOrder_OneFontOnly(
 		if (vFontInfos->m_SelectedGlyphs.empty())
 			return;
 
+		vFontInfos->EnsureLoaded(); // deferred font, loaded at first display
 		if (vFontInfos->m_ImFontAtlas.IsBuilt())
 		{
 			if (vFontInfos->m_ImFontAtlas.TexID)
@@ -577,20 +708,27 @@ void FinalFontPane::DrawSelectionsByFontNoOrder_OneFontOnly(
 
 void FinalFontPane::PrepareSelectionByFontOrderedByCodePoint()
 {
-
 		for (auto itFont : ProjectFile::Instance()->m_Fonts)
 		{
-			itFont.second->m_GlyphsOrderedByCodePoints.clear();
+			PrepareSelectionByFontOrderedByCodePoint_OneFontOnly(itFont.second);
+		}
+}
 
-			for (auto& itGlyph : itFont.second->m_SelectedGlyphs)
+void FinalFontPane::PrepareSelectionByFontOrderedByCodePoint_OneFontOnly(std::shared_ptr<FontInfos> vFontInfos)
+{
+	if (vFontInfos.use_count())
+	{
+		vFontInfos->m_GlyphsOrderedByCodePoints.clear();
+
+		for (auto& itGlyph : vFontInfos->m_SelectedGlyphs)
+		{
+			if (itGlyph.second)
 			{
-				if (itGlyph.second)
-				{
-					itGlyph.second->SetFontInfos(itFont.second);
-					itFont.second->m_GlyphsOrderedByCodePoints[itGlyph.second->newCodePoint].push_back(itGlyph.second);
-				}
+				itGlyph.second->SetFontInfos(vFontInfos);
+				vFontInfos->m_GlyphsOrderedByCodePoints[itGlyph.second->newCodePoint].push_back(itGlyph.second);
 			}
 		}
+	}
 }
 
 // this func can be called by FinalFontPane et SelectedFontPane
@@ -624,6 +762,7 @@ void FinalFontPane::DrawSelectionsByFontOrderedByCodePoint_OneFontOnly(
 		if (vFontInfos->m_GlyphsOrderedByCodePoints.empty())
 			return;
 
+		vFontInfos->EnsureLoaded();
 		if (vFontInfos->m_ImFontAtlas.IsBuilt())
 		{
 			if (vFontInfos->m_ImFontAtlas.TexID)
@@ -720,17 +859,25 @@ void FinalFontPane::PrepareSelectionByFontOrderedByGlyphNames()
 {
 		for (auto itFont : ProjectFile::Instance()->m_Fonts)
 		{
-			itFont.second->m_GlyphsOrderedByGlyphName.clear();
+			PrepareSelectionByFontOrderedByGlyphNames_OneFontOnly(itFont.second);
+		}
+}
 
-			for (auto& itGlyph : itFont.second->m_SelectedGlyphs)
+void FinalFontPane::PrepareSelectionByFontOrderedByGlyphNames_OneFontOnly(std::shared_ptr<FontInfos> vFontInfos)
+{
+	if (vFontInfos.use_count())
+	{
+		vFontInfos->m_GlyphsOrderedByGlyphName.clear();
+
+		for (auto& itGlyph : vFontInfos->m_SelectedGlyphs)
+		{
+			if (itGlyph.second)
 			{
-				if (itGlyph.second)
-				{
-					itGlyph.second->SetFontInfos(itFont.second);
-					itFont.second->m_GlyphsOrderedByGlyphName[itGlyph.second->newHeaderName].push_back(itGlyph.second);
-				}
+				itGlyph.second->SetFontInfos(vFontInfos);
+				vFontInfos->m_GlyphsOrderedByGlyphName[itGlyph.second->newHeaderName].push_back(itGlyph.second);
 			}
 		}
+	}
 }
 
 // this func can be called by FinalFontPane et SelectedFontPane
@@ -762,6 +909,7 @@ void FinalFontPane::DrawSelectionsByFontOrderedByGlyphNames_OneFontOnly(
 		if (vFontInfos->m_GlyphCodePointToName.empty())
 			return;
 
+		vFontInfos->EnsureLoaded();
 		if (vFontInfos->m_ImFontAtlas.IsBuilt())
 		{
 			if (vFontInfos->m_ImFontAtlas.TexID)
@@ -895,6 +1043,7 @@ void FinalFontPane::DrawSelectionMergedNoOrder()
 					auto fontInfosPtr = fontInfos.lock();
 					if (fontInfosPtr.use_count())
 					{
+						fontInfosPtr->EnsureLoaded();
 						if (fontInfosPtr->m_ImFontAtlas.IsBuilt())
 						{
 							if (fontInfosPtr->m_ImFontAtlas.TexID)
@@ -999,6 +1148,7 @@ void FinalFontPane::DrawSelectionMergedOrderedByCodePoint()
 						auto fontInfosPtr = fontInfos.lock();
 						if (fontInfosPtr.use_count())
 						{
+							fontInfosPtr->EnsureLoaded();
 							if (fontInfosPtr->m_ImFontAtlas.IsBuilt())
 							{
 								if (fontInfosPtr->m_ImFontAtlas.TexID)
@@ -1103,6 +1253,7 @@ void FinalFontPane::DrawSelectionMergedOrderedByGlyphNames()
 						auto fontInfosPtr = fontInfos.lock();
 						if (fontInfosPtr.use_count())
 						{
+							fontInfosPtr->EnsureLoaded();
 							if (fontInfosPtr->m_ImFontAtlas.IsBuilt())
 							{
 								if (fontInfosPtr->m_ImFontAtlas.TexID)
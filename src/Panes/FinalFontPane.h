@@ -21,6 +21,8 @@
 
 #include <imgui/imgui.h>
 #include <map>
+#include <set>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -65,6 +67,9 @@ public:
 	void SetFinalFontPaneMode(FinalFontPaneModeFlags vFinalFontPaneModeFlags);
 	bool IsFinalFontPaneMode(FinalFontPaneModeFlags vFinalFontPaneModeFlags);
 	void PrepareSelection();
+	void ApplySelectionDelta(
+		const std::set<std::shared_ptr<GlyphInfos>>& vAdded,
+		const std::set<std::shared_ptr<GlyphInfos>>& vRemoved);
 
 private:
 	void DrawFinalFontPane();
@@ -85,6 +90,11 @@ private:
 		bool vForceEditModeOneColumn = false,
 		bool vShowTooltipInfos = false);
 
+	static void PrepareSelectionByFontOrderedByCodePoint_OneFontOnly(
+		std::shared_ptr<FontInfos> vFontInfos);
+	static void PrepareSelectionByFontOrderedByGlyphNames_OneFontOnly(
+		std::shared_ptr<FontInfos> vFontInfos);
+
 public:
 	static void PrepareSelectionByFontOrderedByCodePoint();
 	void DrawSelectionsByFontOrderedByCodePoint_OneFontOnly(
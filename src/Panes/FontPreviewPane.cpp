@@ -37,6 +37,7 @@
 #include <ctools/FileHelper.h>
 #include <sfntly/font_factory.h>
 #include <Gui/ImWidgets.h>
+#include <Helper/GlyphBatchHelper.h>
 #include <Helper/SelectionHelper.h>
 #include <Project/GlyphInfos.h>
 
@@ -127,6 +128,9 @@ void FontPreviewPane::DrawFontPreviewPane()
 		{
 			if (ProjectFile::Instance()->IsLoaded())
 			{
+				// one draw call per font texture for all the glyphs
+				GlyphBatchHelper::Instance()->Begin(ImGui::GetWindowDrawList());
+
 				ImGui::Text("Select glyphs to test in Final Pane");
 				
 				ImGui::Text("Current Selection");
@@ -219,6 +223,8 @@ void FontPreviewPane::DrawFontPreviewPane()
 				DrawMixerWidget();
 
 				DrawMixedFontResult();
+
+				GlyphBatchHelper::Instance()->End();
 			}
 		}
 
@@ -440,13 +446,9 @@ void FontPreviewPane::DrawMixedFontResult()
 									auto glyph = glyphInfos->second->m_SelectedGlyphs[glyphInfos->first]->glyph;
 									ImVec2 pMin = ImVec2(pos.x + offsetX + trans.x, pos.y - ascOffset - trans.y);
 
-									ImTextureID texId = (ImTextureID)glyphFont->ContainerAtlas->TexID;
-
-									window->DrawList->PushTextureID(texId);
-									glyphFont->RenderChar(
-										window->DrawList, ProjectFile::Instance()->m_FontTestInfos.m_PreviewFontSize,
+									GlyphBatchHelper::Instance()->AddChar(
+										window->DrawList, glyphFont, ProjectFile::Instance()->m_FontTestInfos.m_PreviewFontSize,
 										pMin, colFont, (ImWchar)glyphInfos->first);
-									window->DrawList->PopTextureID();
 									offsetX += glyph.AdvanceX * scale;
 								}
 							}
@@ -461,20 +463,20 @@ void FontPreviewPane::DrawMixedFontResult()
 					if (glyph)
 					{
 						ImVec2 pMin = ImVec2(pos.x + offsetX, pos.y);
-						ImTextureID texId = (ImTextureID)font->ContainerAtlas->TexID;
-						window->DrawList->PushTextureID(texId);
-						font->RenderChar(window->DrawList, ProjectFile::Instance()->m_FontTestInfos.m_PreviewFontSize, pMin, colFont, (ImWchar)c);
-						window->DrawList->PopTextureID();
+						GlyphBatchHelper::Instance()->AddChar(window->DrawList, font, ProjectFile::Instance()->m_FontTestInfos.m_PreviewFontSize, pMin, colFont, (ImWchar)c);
 						offsetX += glyph->AdvanceX * testFontScale;
 					}
 				}
+			}
 
-				if (ProjectFile::Instance()->m_FontTestInfos.m_ShowBaseLine)
-				{
-					// Base Line
-					float asc = font->Ascent * testFontScale;
-					window->DrawList->AddLine(ImVec2(bb.Min.x, bb.Min.y + asc), ImVec2(bb.Max.x, bb.Min.y + asc), ImGui::GetColorU32(ImGuiCol_PlotHistogram), 1.0f); // base line
-				}
+			if (ProjectFile::Instance()->m_FontTestInfos.m_ShowBaseLine)
+			{
+				// over the glyphs, so they are drawn before
+				GlyphBatchHelper::Instance()->Flush();
+
+				// Base Line
+				float asc = font->Ascent * testFontScale;
+				window->DrawList->AddLine(ImVec2(bb.Min.x, bb.Min.y + asc), ImVec2(bb.Max.x, bb.Min.y + asc), ImGui::GetColorU32(ImGuiCol_PlotHistogram), 1.0f); // base line
 			}
 		}
 	}
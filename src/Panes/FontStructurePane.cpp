@@ -46,7 +46,10 @@ bool FontStructurePane::Init()
 
 void FontStructurePane::Unit()
 {
-
+	if (m_ParseTask)
+		m_ParseTask->Cancel();
+	m_ParseTask.reset();
+	m_FontParser.reset();
 }
 
 int FontStructurePane::DrawPanes(int vWidgetId, std::string vUserDatas)
@@ -90,7 +93,15 @@ void FontStructurePane::DrawFontStructurePane()
         {
             if (ProjectFile::Instance()->IsLoaded())
             {
-                if (ImGui::ContrastedButton("Analyse Font"))
+                if (m_ParseTask)
+                {
+                    ImGui::ProgressBar(m_ParseTask->GetProgress(), ImVec2(-1.0f, 0.0f), "Parsing..");
+                    if (ImGui::ContrastedButton("Cancel"))
+                    {
+                        m_ParseTask->Cancel();
+                    }
+                }
+                else if (ImGui::ContrastedButton("Analyse Font"))
                 {
 					std::string fontFilePathName = FileHelper::Instance()->CorrectSlashTypeForFilePathName(ProjectFile::Instance()->m_SelectedFont->m_FontFilePathName);
 
@@ -99,7 +110,7 @@ void FontStructurePane::DrawFontStructurePane()
 						fontFilePathName = ProjectFile::Instance()->GetAbsolutePath(fontFilePathName);
 					}
 
-					m_FontParser.ParseFont(fontFilePathName);
+					ParseFont(fontFilePathName);
                 }
 
                 DisplayAnalyze();
@@ -116,5 +127,37 @@ void FontStructurePane::DrawFontStructurePane()
 
 void FontStructurePane::DisplayAnalyze()
 {
-    m_PaneWidgetId = m_FontParser.draw(m_PaneWidgetId);
+    if (m_FontParser)
+        m_PaneWidgetId = m_FontParser->draw(m_PaneWidgetId);
+}
+
+// the parsing of big fonts can take some seconds, so done in a worker
+// the current analyze is displayed until the new one is ready
+void FontStructurePane::ParseFont(const std::string& vFontFilePathName)
+{
+	auto parser = std::make_shared<FontParser>();
+	m_ParseTask = TaskSystem::Instance()->Submit("Font Analyse",
+		[parser, vFontFilePathName](TaskContext& vContext)
+		{
+			vContext.SetProgress(0.0f, "Loading");
+			if (!parser->ParseFont(vFontFilePathName))
+			{
+				vContext.SetError("can't read or parse the font file " + vFontFilePathName);
+				return false; // the current analyze is kept
+			}
+			if (vContext.IsCancelRequested())
+				return false;
+			vContext.SetProgress(1.0f);
+			return true;
+		},
+		[this, parser](const TaskHandle& vTask)
+		{
+			if (vTask != m_ParseTask) // cancelled by Unit or replaced
+				return;
+
+			if (vTask->GetState() == TaskStateEnum::TASK_STATE_DONE)
+				m_FontParser = parser;
+
+			m_ParseTask.reset();
+		});
 }
@@ -19,15 +19,18 @@
 #include <Panes/Abstract/AbstractPane.h>
 
 #include <Helper/FontParser.h>
+#include <Helper/TaskSystem.h>
 
 #include <string>
+#include <memory>
 
 class ProjectFile;
 class FontInfos;
 class FontStructurePane : public AbstractPane
 {
 private:
-	FontParser m_FontParser;
+	std::shared_ptr<FontParser> m_FontParser; // replaced at the end of the parsing task
+	TaskHandle m_ParseTask = nullptr;
 
 public:
 	bool Init() override;
@@ -39,6 +42,7 @@ public:
 private:
 	void DrawFontStructurePane();
 	void DisplayAnalyze();
+	void ParseFont(const std::string& vFontFilePathName);
 
 public: // singleton
 	static FontStructurePane *Instance()
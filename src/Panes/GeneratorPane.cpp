@@ -32,12 +32,16 @@
 #include <Panes/Manager/LayoutManager.h>
 #include <Gui/ImWidgets.h>
 #include <Helper/Messaging.h>
+#include <Helper/SdfPreviewHelper.h>
 #include <Helper/SelectionHelper.h>
+#include <Helper/TextureHelper.h>
 #include <Helper/ThemeHelper.h>
 #include <Panes/FinalFontPane.h>
 #include <Panes/SourceFontPane.h>
 #include <Project/ProjectFile.h>
 #include <Generator/Generator.h>
+#include <Generator/GenerationProfiler.h>
+#include <Generator/SdfGenerator.h>
 #include <Project/FontInfos.h>
 
 #include <cinttypes> // printf zu
@@ -73,7 +77,10 @@ bool GeneratorPane::Init()
 
 void GeneratorPane::Unit()
 {
-
+	if (m_GenerationTask)
+		m_GenerationTask->Cancel();
+	m_GenerationTask.reset();
+	m_SdfPreviewTexture.reset();
 }
 
 int GeneratorPane::DrawPanes(int vWidgetId, std::string vUserDatas)
@@ -96,11 +103,15 @@ void GeneratorPane::DrawDialogsAndPopups(std::string vUserDatas)
 		{
 			ProjectFile::Instance()->m_LastGeneratedPath = ImGuiFileDialog::Instance()->GetCurrentPath();
 			ProjectFile::Instance()->m_LastGeneratedFileName = ImGuiFileDialog::Instance()->GetCurrentFileName();
-			Generator::Instance()->Generate();
+			StartGeneration();
 		}
 
 		ImGuiFileDialog::Instance()->Close();
 	}
+
+	DrawGenerationProgress();
+
+	m_GenerationSummaryDialog.DrawDialog();
 }
 
 int GeneratorPane::DrawWidgets(int vWidgetId, std::string vUserDatas)
@@ -165,7 +176,7 @@ void GeneratorPane::DrawFontsGenerator()
 				std::string path = FileHelper::Instance()->GetAppPath() + "/exports";
 				path = FileHelper::Instance()->CorrectSlashTypeForFilePathName(path);
 				FileHelper::Instance()->CreateDirectoryIfNotExist(path);
-				Generator::Instance()->Generate(path, "test.ttf");
+				StartGeneration(path, "test.ttf");
 			}
 			if (ImGui::ContrastedButton("Quick Font Merged", nullptr, nullptr, btnWidth))
 			{
@@ -178,7 +189,7 @@ void GeneratorPane::DrawFontsGenerator()
 				std::string path = FileHelper::Instance()->GetAppPath() + "/exports";
 				path = FileHelper::Instance()->CorrectSlashTypeForFilePathName(path);
 				FileHelper::Instance()->CreateDirectoryIfNotExist(path);
-				Generator::Instance()->Generate(path, "test.ttf");
+				StartGeneration(path, "test.ttf");
 			}
 			if (ImGui::ContrastedButton("Quick Header Font Current", nullptr, nullptr, btnWidth))
 			{
@@ -187,7 +198,7 @@ void GeneratorPane::DrawFontsGenerator()
 				std::string path = FileHelper::Instance()->GetAppPath() + "/exports";
 				path = FileHelper::Instance()->CorrectSlashTypeForFilePathName(path);
 				FileHelper::Instance()->CreateDirectoryIfNotExist(path);
-				Generator::Instance()->Generate(path, "test.h");
+				StartGeneration(path, "test.h");
 			}
 			if (ImGui::ContrastedButton("Quick Card Font Current", nullptr, nullptr, btnWidth))
 			{
@@ -196,7 +207,7 @@ void GeneratorPane::DrawFontsGenerator()
 				std::string path = FileHelper::Instance()->GetAppPath() + "/exports";
 				path = FileHelper::Instance()->CorrectSlashTypeForFilePathName(path);
 				FileHelper::Instance()->CreateDirectoryIfNotExist(path);
-				Generator::Instance()->Generate(path, "test.png");
+				StartGeneration(path, "test.png");
 			}
 
 			ImGui::EndFramedGroup();
@@ -277,6 +288,7 @@ void GeneratorPane::DrawFontsGenerator()
 
 			// un header est lié a un TTF ou un CPP ne petu aps etre les deux
 			// donc on fait soit l'un soit l'autre
+			mrw = maxWidth / 3.0f - ImGui::GetStyle().FramePadding.x;
 			change |= GenMode::RadioButtonLabeled_BitWize_GenMode(mrw, "Font", "Font File",
 				GENERATOR_MODE_FONT,
 				true, false, GENERATOR_MODE_RADIO_FONT_SRC);
@@ -284,6 +296,10 @@ void GeneratorPane::DrawFontsGenerator()
 			change |= GenMode::RadioButtonLabeled_BitWize_GenMode(mrw, "Src", "Source File for C++/C#\n\twith font as a bytes array",
 				GENERATOR_MODE_SRC,
 				true, false, GENERATOR_MODE_RADIO_FONT_SRC);
+			ImGui::SameLine();
+			change |= GenMode::RadioButtonLabeled_BitWize_GenMode(mrw, "Atlas", "Prebaked Atlas\n\tglyphs already rasterized (binary + C++ source)\n\tno font rasterization at app startup",
+				GENERATOR_MODE_ATLAS,
+				true, false, GENERATOR_MODE_RADIO_FONT_SRC);
 
 			ImGui::FramedGroupText("Settings");
 			if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_HEADER) ||
@@ -326,6 +342,18 @@ void GeneratorPane::DrawFontsGenerator()
 #endif
 			}
 
+			if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_HEADER))
+			{
+				ImGui::FramedGroupText("Header");
+				change |= ImGui::SliderUIntDefaultCompact(maxWidth - ImGui::GetStyle().FramePadding.x, "Ranges Gap",
+					&ProjectFile::Instance()->m_HeaderRangesGapTolerance, 0U, 256U, defaultProjectFile.m_HeaderRangesGapTolerance);
+				if (ImGui::IsItemHovered())
+					ImGui::SetTooltip("max count of not selected codepoints between two glyph ranges for merge them\nless ranges but more glyphs rasterized");
+				change |= GenMode::RadioButtonLabeled_BitWize_GenMode(maxWidth - ImGui::GetStyle().FramePadding.x,
+					"Names Table", "add a name to codepoint table, sorted by name\nfor lookup the glyphs by name without allocation\n\tc++ : constexpr FindByName\n\tc : static inline FindByName\n\tc# : TryGetCodePoint",
+					GENERATOR_MODE_HEADER_SETTINGS_NAMES_TABLE);
+			}
+
 			if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_MERGED))
 			{
 				ImGui::FramedGroupText("Merged Mode");
@@ -342,6 +370,30 @@ void GeneratorPane::DrawFontsGenerator()
 					GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES);
 			}
 
+			if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_ATLAS))
+			{
+				ImGui::FramedGroupText("Atlas");
+				mrw = maxWidth / 2.0f - ImGui::GetStyle().FramePadding.x;
+				change |= GenMode::RadioButtonLabeled_BitWize_GenMode(mrw, "SDF", "+ Signed Distance Field Atlas (name_Sdf)\n\tone channel, sharp at any size with a shader\n\tthe corners are rounded",
+					GENERATOR_MODE_ATLAS_SETTINGS_SDF,
+					true, false, GENERATOR_MODE_RADIO_ATLAS_DISTANCE_FIELD);
+				ImGui::SameLine();
+				change |= GenMode::RadioButtonLabeled_BitWize_GenMode(mrw, "MSDF", "+ Multi channel Signed Distance Field Atlas (name_Msdf)\n\trgba, sharp corners with the median of rgb\n\ttrue distance in alpha",
+					GENERATOR_MODE_ATLAS_SETTINGS_MSDF,
+					true, false, GENERATOR_MODE_RADIO_ATLAS_DISTANCE_FIELD);
+
+				if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_RADIO_ATLAS_DISTANCE_FIELD))
+				{
+					const float aw = maxWidth - ImGui::GetStyle().FramePadding.x;
+					change |= ImGui::SliderUIntDefaultCompact(aw, "Glyph Size", &ProjectFile::Instance()->m_AtlasSdfGlyphSizeInPixel,
+						8U, 128U, defaultProjectFile.m_AtlasSdfGlyphSizeInPixel);
+					change |= ImGui::SliderFloatDefaultCompact(aw, "Px Range", &ProjectFile::Instance()->m_AtlasSdfPxRange,
+						1.0f, 16.0f, defaultProjectFile.m_AtlasSdfPxRange, 0.0f, "%.1f");
+
+					DrawDistanceFieldPreview(aw);
+				}
+			}
+
 			ImGui::EndFramedGroup();
 		}
 
@@ -354,10 +406,14 @@ void GeneratorPane::DrawFontsGenerator()
 				GenMode::RadioButtonLabeled_BitWize_GenMode(maxWidth - ImGui::GetStyle().FramePadding.x,
 					"Auto Opening", "Auto Opening of Generated Files in associated app after generation",
 					GENERATOR_MODE_OPEN_GENERATED_FILES_AUTO);
+				GenMode::RadioButtonLabeled_BitWize_GenMode(maxWidth - ImGui::GetStyle().FramePadding.x,
+					"Skip Unchanged", "Skip the outputs without changes since the last generation\n(same font file, glyphs selection and settings)\nthe files are left untouched",
+					GENERATOR_MODE_SKIP_UNCHANGED_OUTPUTS);
 				if (ImGui::ContrastedButton(ICON_IGFS_GENERATE " Generate", nullptr, nullptr, maxWidth - ImGui::GetStyle().FramePadding.x))
 				{
 					btnClick = true;
 					if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_FONT)) exts = ".ttf";
+					else if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_ATLAS)) exts = ".ifsa";
 					else if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_SRC))
 					{
 						if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_LANG_C)) exts = ".c";
@@ -469,7 +525,8 @@ bool GeneratorPane::CheckAndDisplayGenerationConditions()
 	if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_HEADER) ||
 		ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_CARD) ||
 		ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_FONT) ||
-		ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_SRC))
+		ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_SRC) ||
+		ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_ATLAS))
 	{
 
 	}
@@ -495,12 +552,13 @@ bool GeneratorPane::CheckAndDisplayGenerationConditions()
 
 	if (ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_HEADER))
 	{
-		// header need SRC or Font at least
+		// header need SRC or Font or Atlas at least
 		if (!(ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_FONT) ||
-			ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_SRC)))
+			ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_SRC) ||
+			ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_ATLAS)))
 		{
 			res = false;
-			ImGui::FramedGroupText(ImGui::CustomStyle::BadColor, "the Header is linked ot a font or a cpp.\nPlease Select Cpp or Font at least");
+			ImGui::FramedGroupText(ImGui::CustomStyle::BadColor, "the Header is linked ot a font or a cpp or an atlas.\nPlease Select Cpp or Font or Atlas at least");
 		}
 
 		// need on language at mini
@@ -640,6 +698,9 @@ void GeneratorPane::Show_BatchMode_PerFontSettings()
 							true, false, GENERATOR_MODE_RADIO_FONT_SRC); ImGui::SameLine();
 						change |= ImGui::RadioButtonLabeled_BitWize<GenModeFlags>(0.0f, "S##FEAT", "Src Feature",
 							&itFont.second->m_GenModeFlags, GENERATOR_MODE_SRC,
+							true, false, GENERATOR_MODE_RADIO_FONT_SRC); ImGui::SameLine();
+						change |= ImGui::RadioButtonLabeled_BitWize<GenModeFlags>(0.0f, "A##FEAT", "Prebaked Atlas Feature",
+							&itFont.second->m_GenModeFlags, GENERATOR_MODE_ATLAS,
 							true, false, GENERATOR_MODE_RADIO_FONT_SRC);
 						if (itFont.second->IsGenMode(GENERATOR_MODE_SRC))
 						{
@@ -681,6 +742,112 @@ errors types :
  it seem we need to have a gen mode per target
  in batch mode if a font have issue with header we need to not gen them but we need to show that to the user
 */
+///////////////////////////////////////////////////////////////////////////////////
+//// DISTANCE FIELD PREVIEW ///////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+void GeneratorPane::DrawDistanceFieldPreview(float vWidth)
+{
+	if (ImGui::ContrastedButton("Bake Preview", "Bake the distance field atlas of the selected font\nwith the current settings", nullptr, vWidth))
+	{
+		BakeDistanceFieldPreview();
+	}
+
+	if (m_SdfPreviewTexture)
+	{
+		ImGui::SliderFloatDefaultCompact(vWidth, "Zoom", &m_SdfPreviewZoom, 0.25f, 8.0f, 1.0f, 0.0f, "%.2f");
+
+#if VULKAN
+		ImTextureID texId = (ImTextureID)&m_SdfPreviewTexture->descriptor;
+#else
+		ImTextureID texId = (ImTextureID)(size_t)m_SdfPreviewTexture->textureId;
+#endif
+
+		// the glyphs in lines like a text, no glyph is cut
+		const float lineHeight = (m_SdfPreviewAtlas.ascent - m_SdfPreviewAtlas.descent) * m_SdfPreviewZoom;
+		const ImVec2 pos = ImGui::GetCursorScreenPos();
+		float x = 0.0f, y = 0.0f;
+
+		auto drawList = ImGui::GetWindowDrawList();
+		SdfPreviewHelper::Instance()->Begin(drawList,
+			ImVec2((float)m_SdfPreviewAtlas.width, (float)m_SdfPreviewAtlas.height),
+			m_SdfPreviewAtlas.pxRange,
+			m_SdfPreviewAtlas.format == PrebakedAtlasFormatEnum::PREBAKED_ATLAS_FORMAT_MSDF);
+		for (const auto& glyph : m_SdfPreviewAtlas.glyphs)
+		{
+			const float adv = glyph.advanceX * m_SdfPreviewZoom;
+			if (x > 0.0f && x + adv > vWidth)
+			{
+				x = 0.0f;
+				y += lineHeight;
+			}
+
+			if (glyph.x1 > glyph.x0 && glyph.y1 > glyph.y0)
+			{
+				drawList->AddImage(texId,
+					pos + ImVec2(x + glyph.x0 * m_SdfPreviewZoom, y + glyph.y0 * m_SdfPreviewZoom),
+					pos + ImVec2(x + glyph.x1 * m_SdfPreviewZoom, y + glyph.y1 * m_SdfPreviewZoom),
+					ImVec2(glyph.u0, glyph.v0), ImVec2(glyph.u1, glyph.v1),
+					ImGui::GetColorU32(ImGuiCol_Text));
+			}
+
+			x += adv;
+		}
+		SdfPreviewHelper::Instance()->End(drawList);
+
+		ImGui::Dummy(ImVec2(vWidth, y + lineHeight));
+	}
+}
+
+void GeneratorPane::BakeDistanceFieldPreview()
+{
+	m_SdfPreviewTexture.reset();
+	m_SdfPreviewAtlas = PrebakedAtlasStruct();
+
+	auto font = ProjectFile::Instance()->m_SelectedFont;
+	if (font)
+	{
+		const auto format = ProjectFile::Instance()->IsGenMode(GENERATOR_MODE_ATLAS_SETTINGS_MSDF) ?
+			PrebakedAtlasFormatEnum::PREBAKED_ATLAS_FORMAT_MSDF :
+			PrebakedAtlasFormatEnum::PREBAKED_ATLAS_FORMAT_SDF;
+
+		PrebakedAtlasStruct atlas;
+		if (SdfGenerator::BakeAtlas({ font }, format,
+			ProjectFile::Instance()->m_AtlasSdfGlyphSizeInPixel,
+			ProjectFile::Instance()->m_AtlasSdfPxRange, &atlas))
+		{
+			// the textures are rgba, the sdf value is copied in the 4 channels
+			std::vector<uint8_t> rgba;
+			uint8_t* pixels = atlas.pixels.data();
+			if (atlas.channels == 1U)
+			{
+				rgba.resize(atlas.pixels.size() * 4U);
+				for (size_t i = 0U; i < atlas.pixels.size(); ++i)
+				{
+					rgba[i * 4U + 0U] = atlas.pixels[i];
+					rgba[i * 4U + 1U] = atlas.pixels[i];
+					rgba[i * 4U + 2U] = atlas.pixels[i];
+					rgba[i * 4U + 3U] = atlas.pixels[i];
+				}
+				pixels = rgba.data();
+			}
+
+			// linear filtering needed for interpolate the distance
+#if VULKAN
+			VkCommandPool command_pool = MainFrame::sMainWindowData.Frames[MainFrame::sMainWindowData.FrameIndex].CommandPool;
+			m_SdfPreviewTexture = TextureHelper::CreateTextureFromBuffer(command_pool, pixels,
+				(int)atlas.width, (int)atlas.height, 4, TextureFilteringEnum::TEX_FILTER_LINEAR);
+#else
+			m_SdfPreviewTexture = TextureHelper::CreateTextureFromBuffer(pixels,
+				(int)atlas.width, (int)atlas.height, 4, TextureFilteringEnum::TEX_FILTER_LINEAR);
+#endif
+
+			atlas.pixels.clear(); // on gpu now
+			m_SdfPreviewAtlas = atlas;
+		}
+	}
+}
+
 void GeneratorPane::ModifyConfigurationAccordingToSelectedFeaturesAndErrors()
 {
 	// current font
@@ -895,3 +1062,87 @@ void GeneratorPane::GeneratorFileDialogPane(const char* vFilter, IGFDUserDatas v
 
 }
 
+///////////////////////////////////////////////////////////////////////////////////
+//// GENERATION ///////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+// the generation is done in a worker, the ui stay responsive
+// the progress popup is modal, so the project can't be modified during the generation
+void GeneratorPane::StartGeneration(const std::string& vFilePath, const std::string& vFileName)
+{
+	if (m_GenerationTask) // one at a time
+		return;
+
+	Generator::Instance()->PrepareGeneration(); // textures, main thread only
+
+	GenerationProfiler::Instance()->Reset();
+	GenerationProfiler::Instance()->SetEnabled(true);
+	m_GenerationStartTime = std::chrono::steady_clock::now();
+
+	// the errors are reported by the generator, so the task never fail
+	// the task is cancelled as soon as a cancel is requested, but the generation only if an output was abandoned
+	auto success = std::make_shared<bool>(false);
+	auto cancelled = std::make_shared<bool>(false);
+	m_GenerationTask = TaskSystem::Instance()->Submit("Generation",
+		[vFilePath, vFileName, success, cancelled](TaskContext& vContext)
+		{
+			*success = Generator::Instance()->Generate(vFilePath, vFileName, &vContext);
+			*cancelled = Generator::Instance()->IsGenerationCancelled();
+			return true;
+		},
+		[this, success, cancelled](const TaskHandle& vTask)
+		{
+			EndGeneration(vTask, *success, *cancelled);
+		});
+}
+
+void GeneratorPane::EndGeneration(const TaskHandle& vTask, const bool& vSuccess, const bool& vCancelled)
+{
+	if (vTask != m_GenerationTask) // cancelled by Unit
+		return;
+
+	GenerationProfiler::Instance()->SetEnabled(false);
+
+	const double totalTimeInMs = std::chrono::duration<double, std::milli>(
+		std::chrono::steady_clock::now() - m_GenerationStartTime).count();
+	m_GenerationSummaryDialog.OpenDialog(GenerationProfiler::Instance()->GetFonts(), totalTimeInMs,
+		vSuccess, vCancelled);
+
+	Generator::Instance()->FinishGeneration();
+
+	m_GenerationTask.reset();
+}
+
+void GeneratorPane::DrawGenerationProgress()
+{
+	if (m_GenerationTask && !ImGui::IsPopupOpen("Generation##GenerationProgress"))
+	{
+		ImGui::OpenPopup("Generation##GenerationProgress");
+	}
+
+	if (ImGui::BeginPopupModal("Generation##GenerationProgress", nullptr,
+		ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoDocking))
+	{
+		if (m_GenerationTask)
+		{
+			const auto msg = m_GenerationTask->GetProgressMsg();
+			ImGui::Text("Generation of %s", msg.c_str());
+			ImGui::ProgressBar(m_GenerationTask->GetProgress(), ImVec2(300.0f, 0.0f));
+
+			if (m_GenerationTask->IsCancelRequested())
+			{
+				ImGui::Text("Cancelling..");
+			}
+			else if (ImGui::ContrastedButton("Cancel"))
+			{
+				m_GenerationTask->Cancel();
+			}
+		}
+		else
+		{
+			ImGui::CloseCurrentPopup();
+		}
+
+		ImGui::EndPopup();
+	}
+}
@@ -18,10 +18,15 @@
 #include <Panes/Abstract/AbstractPane.h>
 
 #include <ImGuiFileDialog/ImGuiFileDialog.h>
+#include <Generator/AtlasGenerator.h>
+#include <Generator/GenerationSummaryDialog.h>
+#include <Helper/TaskSystem.h>
 
 #include <stdint.h>
 #include <string>
 #include <map>
+#include <memory>
+#include <chrono>
 
 enum GeneratorStatusFlags
 {
@@ -36,12 +41,23 @@ enum GeneratorStatusFlags
 };
 
 class ProjectFile;
+struct TextureObject;
 
 class GeneratorPane : public AbstractPane
 {
 private: // STATUS FLAGS
 	GeneratorStatusFlags m_GeneratorStatusFlags = GENERATOR_STATUS_DEFAULT;
 
+private: // DISTANCE FIELD PREVIEW
+	PrebakedAtlasStruct m_SdfPreviewAtlas; // only the glyphs are kept
+	std::shared_ptr<TextureObject> m_SdfPreviewTexture = nullptr;
+	float m_SdfPreviewZoom = 1.0f;
+
+private: // GENERATION
+	TaskHandle m_GenerationTask = nullptr; // the generation is done in a worker
+	std::chrono::steady_clock::time_point m_GenerationStartTime;
+	GenerationSummaryDialog m_GenerationSummaryDialog;
+
 public:
 	bool Init() override;
 	void Unit() override;
@@ -61,6 +77,12 @@ private:
 	bool CheckAndDisplayGenerationConditions();
 	void Show_BatchMode_PerFontSettings();
 	void ModifyConfigurationAccordingToSelectedFeaturesAndErrors();
+	void DrawDistanceFieldPreview(float vWidth);
+	void BakeDistanceFieldPreview();
+
+	void StartGeneration(const std::string& vFilePath = "", const std::string& vFileName = "");
+	void EndGeneration(const TaskHandle& vTask, const bool& vSuccess, const bool& vCancelled);
+	void DrawGenerationProgress();
 
 public: // singleton
 	static GeneratorPane *Instance()
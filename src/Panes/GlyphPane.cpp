@@ -172,64 +172,47 @@ bool GlyphPane::LoadGlyph( std::shared_ptr<FontInfos> vFontInfos, std::weak_ptr<
 		auto glyphInfosPtr = vGlyphInfos.lock();
 		if (glyphInfosPtr.use_count())
 		{
-			std::string fontPathName = ProjectFile::Instance()->GetAbsolutePath(vFontInfos->m_FontFilePathName);
-
-			if (FileHelper::Instance()->IsFileExist(fontPathName))
+			// parsed one time per font, so the glyph edition is instant after the first access
+			auto sfntlyFontPtr = vFontInfos->GetSfntlyFont();
+			if (sfntlyFontPtr)
 			{
-				FontGenerator m_FontHelper;
+				uint32_t codePoint = glyphInfosPtr->glyph.Codepoint;
+				uint32_t glyphId = sfntlyFontPtr->m_CMapTable->GlyphId(codePoint);
+				uint32_t length = sfntlyFontPtr->m_LocaTable->GlyphLength(glyphId);
+				uint32_t offset = sfntlyFontPtr->m_LocaTable->GlyphOffset(glyphId);
+
+				// Get the GLYF table for the current glyph id.
+				auto g = sfntlyFontPtr->m_GlyfTable->GetGlyph(offset, length);
 
-				m_fontInstance.m_Font.Attach(m_FontHelper.LoadFontFile(fontPathName.c_str()));
-				if (m_fontInstance.m_Font)
+				if (g->GlyphType() == sfntly::GlyphType::kSimple)
 				{
-					sfntly::Ptr<sfntly::CMapTable> cmap_table = down_cast<sfntly::CMapTable*>(m_fontInstance.m_Font->GetTable(sfntly::Tag::cmap));
-					m_fontInstance.m_CMapTable.Attach(cmap_table->GetCMap(sfntly::CMapTable::WINDOWS_BMP));
-					if (m_fontInstance.m_CMapTable)
+					auto glyph = down_cast<sfntly::GlyphTable::SimpleGlyph*>(g);
+					if (glyph)
 					{
-						m_fontInstance.m_GlyfTable = down_cast<sfntly::GlyphTable*>(m_fontInstance.m_Font->GetTable(sfntly::Tag::glyf));
-						m_fontInstance.m_LocaTable = down_cast<sfntly::LocaTable*>(m_fontInstance.m_Font->GetTable(sfntly::Tag::loca));
-
-						if (m_fontInstance.m_GlyfTable && m_fontInstance.m_LocaTable)
-						{
-							uint32_t codePoint = glyphInfosPtr->glyph.Codepoint;
-							uint32_t glyphId = m_fontInstance.m_CMapTable->GlyphId(codePoint);
-							uint32_t length = m_fontInstance.m_LocaTable->GlyphLength(glyphId);
-							uint32_t offset = m_fontInstance.m_LocaTable->GlyphOffset(glyphId);
-
-							// Get the GLYF table for the current glyph id.
-							auto g = m_fontInstance.m_GlyfTable->GetGlyph(offset, length);
-
-							if (g->GlyphType() == sfntly::GlyphType::kSimple)
-							{
-								auto glyph = down_cast<sfntly::GlyphTable::SimpleGlyph*>(g);
-								if (glyph)
-								{
-									m_GlyphToDisplay = vGlyphInfos;
-									glyphInfosPtr->simpleGlyph.LoadSimpleGlyph(glyph);
-									limitContour = glyphInfosPtr->simpleGlyph.GetCountContours();
-									glyphInfosPtr->simpleGlyph.m_Translation = glyphInfosPtr->m_Translation;
-									glyphInfosPtr->simpleGlyph.m_Scale = glyphInfosPtr->m_Scale;
+						m_GlyphToDisplay = vGlyphInfos;
+						glyphInfosPtr->simpleGlyph.LoadSimpleGlyph(glyph);
+						limitContour = glyphInfosPtr->simpleGlyph.GetCountContours();
+						glyphInfosPtr->simpleGlyph.m_Translation = glyphInfosPtr->m_Translation;
+						glyphInfosPtr->simpleGlyph.m_Scale = glyphInfosPtr->m_Scale;
 #ifdef _DEBUG
-									DebugPane::Instance()->SetGlyphToDebug(m_GlyphToDisplay);
+						DebugPane::Instance()->SetGlyphToDebug(m_GlyphToDisplay);
 #endif
-									// show and active the glyph pane
-									LayoutManager::Instance()->ShowAndFocusSpecificPane(m_PaneFlag);
-
-									res = true;
-								}
-							}
-							else if (g->GlyphType() == sfntly::GlyphType::kComposite)
-							{
-								m_GlyphToDisplay.reset();
-
-								// show and active the glyph pane
-								LayoutManager::Instance()->ShowAndFocusSpecificPane(m_PaneFlag);
-
-								Messaging::Instance()->AddWarning(true, nullptr, nullptr,
-									"Composite glyph drawing is not supported for the moment");
-							}
-						}
+						// show and active the glyph pane
+						LayoutManager::Instance()->ShowAndFocusSpecificPane(m_PaneFlag);
+
+						res = true;
 					}
 				}
+				else if (g->GlyphType() == sfntly::GlyphType::kComposite)
+				{
+					m_GlyphToDisplay.reset();
+
+					// show and active the glyph pane
+					LayoutManager::Instance()->ShowAndFocusSpecificPane(m_PaneFlag);
+
+					Messaging::Instance()->AddWarning(true, nullptr, nullptr,
+						"Composite glyph drawing is not supported for the moment");
+				}
 			}
 		}
 	}
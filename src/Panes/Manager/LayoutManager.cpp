@@ -29,6 +29,7 @@ SOFTWARE.
 
 #include <ctools/FileHelper.h>
 #include <ctools/Logger.h>
+#include <Helper/FrameProfiler.h>
 
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include <imgui/imgui_internal.h>
@@ -262,8 +263,11 @@ void LayoutManager::DisplayMenu(ImVec2 vSize)
 
 int LayoutManager::DisplayPanes(int vWidgetId, std::string vUserDatas)
 {
+	FrameProfilerScope profilerScope("LayoutManager::DisplayPanes");
+
 	for (const auto& pane : m_PanesByFlag)
 	{
+		FrameProfilerScope paneProfilerScope(pane.second->m_PaneName, pane.second->m_PaneName);
 		vWidgetId = pane.second->DrawPanes(vWidgetId, vUserDatas);
 	}
 
@@ -272,6 +276,8 @@ int LayoutManager::DisplayPanes(int vWidgetId, std::string vUserDatas)
 
 void LayoutManager::DrawDialogsAndPopups(std::string vUserDatas)
 {
+	FrameProfilerScope profilerScope("LayoutManager::DrawDialogsAndPopups");
+
 	for (const auto& pane : m_PanesByFlag)
 	{
 		pane.second->DrawDialogsAndPopups(vUserDatas);
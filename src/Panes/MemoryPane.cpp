@@ -0,0 +1,257 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "MemoryPane.h"
+
+#include <MainFrame.h>
+
+#include <Panes/Manager/LayoutManager.h>
+#include <Project/ProjectFile.h>
+#include <Gui/ImWidgets.h>
+#include <Helper/MemoryTracker.h>
+
+#define MEMORY_PANE_REFRESH_DELAY 1.0 // seconds between two auto refresh
+
+MemoryPane::MemoryPane() = default;
+MemoryPane::~MemoryPane() = default;
+
+///////////////////////////////////////////////////////////////////////////////////
+//// OVERRIDES ////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+bool MemoryPane::Init()
+{
+	return true;
+}
+
+void MemoryPane::Unit()
+{
+	m_FontsMemoryUsage.clear();
+}
+
+int MemoryPane::DrawPanes(int vWidgetId, std::string vUserDatas)
+{
+	m_PaneWidgetId = vWidgetId;
+
+	DrawMemoryPane();
+
+	return m_PaneWidgetId;
+}
+
+void MemoryPane::DrawDialogsAndPopups(std::string vUserDatas)
+{
+
+}
+
+int MemoryPane::DrawWidgets(int vWidgetId, std::string vUserDatas)
+{
+	UNUSED(vUserDatas);
+
+	return vWidgetId;
+}
+
+///////////////////////////////////////////////////////////////////////////////////
+//// PRIVATE //////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+void MemoryPane::DrawMemoryPane()
+{
+	if (LayoutManager::Instance()->m_Pane_Shown & m_PaneFlag)
+	{
+		if (ImGui::BeginFlag<PaneFlags>(m_PaneName,
+			&LayoutManager::Instance()->m_Pane_Shown, m_PaneFlag,
+			//ImGuiWindowFlags_NoTitleBar |
+			//ImGuiWindowFlags_MenuBar |
+			//ImGuiWindowFlags_NoMove |
+			ImGuiWindowFlags_NoCollapse |
+			//ImGuiWindowFlags_NoResize |
+			ImGuiWindowFlags_NoBringToFrontOnFocus))
+		{
+			DrawAllocatorsMemory();
+			DrawFontsMemory();
+		}
+
+		ImGui::End();
+	}
+}
+
+void MemoryPane::DrawAllocatorsMemory()
+{
+	if (ImGui::CollapsingHeader("Allocators", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		if (!MemoryTracker::Instance()->IsInstalled())
+		{
+			ImGui::TextWrapped("The allocators are not installed");
+			return;
+		}
+
+		static ImGuiTableFlags flags =
+			ImGuiTableFlags_SizingFixedFit |
+			ImGuiTableFlags_RowBg |
+			ImGuiTableFlags_Borders |
+			ImGuiTableFlags_Resizable;
+
+		if (ImGui::BeginTable("##AllocatorsMemoryTable", 5, flags))
+		{
+			ImGui::TableSetupColumn("Category");
+			ImGui::TableSetupColumn("Current");
+			ImGui::TableSetupColumn("Peak");
+			ImGui::TableSetupColumn("Alive Allocs");
+			ImGui::TableSetupColumn("Total Allocs");
+			ImGui::TableHeadersRow();
+
+			for (int i = 0; i < (int)MemoryCategoryEnum::MEMORY_CATEGORY_Count; ++i)
+			{
+				const auto category = (MemoryCategoryEnum)i;
+				const auto stats = MemoryTracker::Instance()->GetStats(category);
+
+				ImGui::TableNextRow();
+				if (ImGui::TableSetColumnIndex(0)) ImGui::Text("%s", MemoryTracker::GetCategoryName(category));
+				if (ImGui::TableSetColumnIndex(1)) TextSize(stats.currentBytes);
+				if (ImGui::TableSetColumnIndex(2)) TextSize(stats.peakBytes);
+				if (ImGui::TableSetColumnIndex(3)) ImGui::Text("%u", (uint32_t)stats.countAllocs);
+				if (ImGui::TableSetColumnIndex(4)) ImGui::Text("%u", (uint32_t)stats.totalAllocs);
+			}
+
+			ImGui::EndTable();
+		}
+	}
+}
+
+// the atlas are also in the imgui allocator
+void MemoryPane::DrawFontsMemory()
+{
+	if (ImGui::CollapsingHeader("Fonts", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		const double currentTime = ImGui::GetTime();
+		bool needRefresh = ImGui::ContrastedButton("Refresh");
+		ImGui::SameLine();
+		ImGui::Checkbox("Auto Refresh", &m_AutoRefresh);
+		if (m_AutoRefresh && (m_LastRefreshTime < 0.0 || currentTime - m_LastRefreshTime > MEMORY_PANE_REFRESH_DELAY))
+			needRefresh = true;
+		if (needRefresh)
+		{
+			RefreshFontsMemory();
+			m_LastRefreshTime = currentTime;
+		}
+
+		if (m_FontsMemoryUsage.empty())
+		{
+			ImGui::TextWrapped("No fonts loaded");
+			return;
+		}
+
+		static ImGuiTableFlags flags =
+			ImGuiTableFlags_SizingFixedFit |
+			ImGuiTableFlags_RowBg |
+			ImGuiTableFlags_Borders |
+			ImGuiTableFlags_Resizable |
+			ImGuiTableFlags_ScrollX;
+
+		if (ImGui::BeginTable("##FontsMemoryTable", 11, flags))
+		{
+			ImGui::TableSetupScrollFreeze(1, 1);
+			ImGui::TableSetupColumn("Font");
+			ImGui::TableSetupColumn("Atlas Pixels");
+			ImGui::TableSetupColumn("Atlas Glyphs");
+			ImGui::TableSetupColumn("Glyph Names");
+			ImGui::TableSetupColumn("CodePoint Maps");
+			ImGui::TableSetupColumn("Selection");
+			ImGui::TableSetupColumn("Ordered");
+			ImGui::TableSetupColumn("Filtered");
+			ImGui::TableSetupColumn("Total");
+			ImGui::TableSetupColumn("Texture (GPU)");
+			ImGui::TableSetupColumn("File");
+			ImGui::TableHeadersRow();
+
+			FontMemoryUsageStruct totals;
+			for (const auto& it : m_FontsMemoryUsage)
+			{
+				const auto& usage = it.second;
+
+				ImGui::TableNextRow();
+				if (ImGui::TableSetColumnIndex(0)) ImGui::Text("%s", it.first.c_str());
+				if (ImGui::TableSetColumnIndex(1)) TextSize(usage.atlasPixels);
+				if (ImGui::TableSetColumnIndex(2)) TextSize(usage.atlasGlyphs);
+				if (ImGui::TableSetColumnIndex(3)) TextSize(usage.glyphNames);
+				if (ImGui::TableSetColumnIndex(4)) TextSize(usage.codePointMaps);
+				if (ImGui::TableSetColumnIndex(5)) TextSize(usage.selectedGlyphs);
+				if (ImGui::TableSetColumnIndex(6)) TextSize(usage.orderedGlyphs);
+				if (ImGui::TableSetColumnIndex(7)) TextSize(usage.filteredGlyphs);
+				if (ImGui::TableSetColumnIndex(8)) TextSize(usage.GetTotal());
+				if (ImGui::TableSetColumnIndex(9)) TextSize(usage.texture);
+				if (ImGui::TableSetColumnIndex(10)) TextSize(usage.fontFile);
+
+				totals.atlasPixels += usage.atlasPixels;
+				totals.atlasGlyphs += usage.atlasGlyphs;
+				totals.glyphNames += usage.glyphNames;
+				totals.codePointMaps += usage.codePointMaps;
+				totals.selectedGlyphs += usage.selectedGlyphs;
+				totals.orderedGlyphs += usage.orderedGlyphs;
+				totals.filteredGlyphs += usage.filteredGlyphs;
+				totals.texture += usage.texture;
+				totals.fontFile += usage.fontFile;
+			}
+
+			if (m_FontsMemoryUsage.size() > 1U)
+			{
+				ImGui::TableNextRow(ImGuiTableRowFlags_Headers);
+				if (ImGui::TableSetColumnIndex(0)) ImGui::Text("Totals");
+				if (ImGui::TableSetColumnIndex(1)) TextSize(totals.atlasPixels);
+				if (ImGui::TableSetColumnIndex(2)) TextSize(totals.atlasGlyphs);
+				if (ImGui::TableSetColumnIndex(3)) TextSize(totals.glyphNames);
+				if (ImGui::TableSetColumnIndex(4)) TextSize(totals.codePointMaps);
+				if (ImGui::TableSetColumnIndex(5)) TextSize(totals.selectedGlyphs);
+				if (ImGui::TableSetColumnIndex(6)) TextSize(totals.orderedGlyphs);
+				if (ImGui::TableSetColumnIndex(7)) TextSize(totals.filteredGlyphs);
+				if (ImGui::TableSetColumnIndex(8)) TextSize(totals.GetTotal());
+				if (ImGui::TableSetColumnIndex(9)) TextSize(totals.texture);
+				if (ImGui::TableSetColumnIndex(10)) TextSize(totals.fontFile);
+			}
+
+			ImGui::EndTable();
+		}
+	}
+}
+
+void MemoryPane::RefreshFontsMemory()
+{
+	m_FontsMemoryUsage.clear();
+
+	if (ProjectFile::Instance()->IsLoaded())
+	{
+		for (const auto& it : ProjectFile::Instance()->m_Fonts)
+		{
+			if (it.second)
+			{
+				m_FontsMemoryUsage.emplace_back(it.second->m_FontFileName, it.second->GetMemoryUsage());
+			}
+		}
+	}
+}
+
+void MemoryPane::TextSize(const size_t& vBytes)
+{
+	if (vBytes >= 1024U * 1024U)
+		ImGui::Text("%.2f MB", (double)vBytes / (1024.0 * 1024.0));
+	else if (vBytes >= 1024U)
+		ImGui::Text("%.2f KB", (double)vBytes / 1024.0);
+	else
+		ImGui::Text("%u B", (uint32_t)vBytes);
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <Panes/Abstract/AbstractPane.h>
+
+#include <imgui/imgui.h>
+
+#include <Project/FontInfos.h>
+
+#include <string>
+#include <vector>
+#include <utility>
+
+// memory of the imgui / freetype allocators and of each font (see MemoryTracker)
+// the fonts are measured on refresh only, the walk of the glyphs is not for each frame
+class MemoryPane : public AbstractPane
+{
+private:
+	std::vector<std::pair<std::string, FontMemoryUsageStruct>> m_FontsMemoryUsage; // font name, usage
+	bool m_AutoRefresh = true;
+	double m_LastRefreshTime = -1.0; // imgui time in seconds
+
+public:
+	bool Init() override;
+	void Unit() override;
+	int DrawPanes(int vWidgetId, std::string vUserDatas)  override;
+	void DrawDialogsAndPopups(std::string vUserDatas) override;
+	int DrawWidgets(int vWidgetId, std::string vUserDatas)  override;
+
+private:
+	void DrawMemoryPane();
+	void DrawAllocatorsMemory();
+	void DrawFontsMemory();
+	void RefreshFontsMemory();
+	static void TextSize(const size_t& vBytes);
+
+public: // singleton
+	static MemoryPane *Instance()
+	{
+		static MemoryPane _instance;
+		return &_instance;
+	}
+
+protected:
+	MemoryPane(); // Prevent construction
+	MemoryPane(const MemoryPane&) {}; // Prevent construction by copying
+	MemoryPane& operator =(const MemoryPane&) { return *this; }; // Prevent assignment
+	~MemoryPane(); // Prevent unwanted destruction};
+};
@@ -531,6 +531,7 @@ void ParamsPane::SelectFont( std::shared_ptr<FontInfos> vFontInfos)
 		ProjectFile::Instance()->m_SelectedFont = vFontInfos;
 		if (vFontInfos.use_count())
 		{
+			vFontInfos->EnsureLoaded(); // the selected font is displayed
 			ProjectFile::Instance()->m_FontToMergeIn = vFontInfos->m_FontFileName;
 		}
 		ProjectFile::Instance()->SetProjectChange();
@@ -221,6 +221,7 @@ void SourceFontPane::DrawFontAtlas_Virtual( std::shared_ptr<FontInfos> vFontInfo
 		{
 			ProjectFile::Instance()->m_Preview_Glyph_CountX = ct::maxi(ProjectFile::Instance()->m_Preview_Glyph_CountX, 1);
 
+			vFontInfos->EnsureLoaded(); // deferred font, loaded at first display
 			if (vFontInfos->m_ImFontAtlas.IsBuilt())
 			{
 				if (vFontInfos->m_ImFontAtlas.TexID)
@@ -238,6 +239,9 @@ void SourceFontPane::DrawFontAtlas_Virtual( std::shared_ptr<FontInfos> vFontInfo
 							uint32_t countGlyphs = (uint32_t)vFontInfos->m_FilteredGlyphs.size();
 							int rowCount = (int)ct::ceil((double)countGlyphs / (double)glyphCountX);
 							
+							// all the selection changes of this frame are commited at once
+							SelectionHelper::Instance()->BeginSelectionTransaction();
+
 							m_VirtualClipper.Begin(rowCount, cell_size.y);
 							while (m_VirtualClipper.Step())
 							{
@@ -303,10 +307,17 @@ void SourceFontPane::DrawFontAtlas_Virtual( std::shared_ptr<FontInfos> vFontInfo
 								}
 							}
 							m_VirtualClipper.End();
-						}
 
-						SelectionHelper::Instance()->SelectWithToolOrApply(
-							SelectionContainerEnum::SELECTION_CONTAINER_SOURCE);
+							SelectionHelper::Instance()->SelectWithToolOrApply(
+								SelectionContainerEnum::SELECTION_CONTAINER_SOURCE);
+
+							SelectionHelper::Instance()->CommitSelectionTransaction();
+						}
+						else
+						{
+							SelectionHelper::Instance()->SelectWithToolOrApply(
+								SelectionContainerEnum::SELECTION_CONTAINER_SOURCE);
+						}
 					}
 				}
 			}
@@ -320,6 +331,7 @@ void SourceFontPane::DrawFontTexture(std::shared_ptr<FontInfos> vFontInfos)
 {
 	if (vFontInfos.use_count())
 	{
+		vFontInfos->EnsureLoaded();
 		if (vFontInfos->m_ImFontAtlas.IsBuilt())
 		{
 			if (vFontInfos->m_ImFontAtlas.TexID)
@@ -22,6 +22,10 @@
 #include <Project/ProjectFile.h>
 #include <Gui/ImWidgets.h>
 #include <Helper/Messaging.h>
+#include <Helper/FontBlobRegistry.h>
+#include <Helper/FontPrefetcher.h>
+#include <Helper/MemoryTracker.h>
+#include <Generator/FontGenerator.h>
 #include <ctools/Logger.h>
 #include <Panes/ParamsPane.h>
 #include <MainFrame.h>
@@ -30,6 +34,7 @@
 #include <imgui/imstb_truetype.h>
 
 #include <array>
+#include <chrono>
 
 using namespace ImGuiFreeType;
 
@@ -59,6 +64,31 @@ static std::string GetPrefixFromFontFileName(const std::string& vFileName)
     return res;
 }
 
+// measure the duration of each stage of a font build
+class FontBuildStageTimer
+{
+private:
+	std::vector<std::pair<std::string, double>>* m_Times = nullptr;
+	std::chrono::steady_clock::time_point m_Start;
+
+public:
+	explicit FontBuildStageTimer(std::vector<std::pair<std::string, double>>* vTimes)
+		: m_Times(vTimes), m_Start(std::chrono::steady_clock::now())
+	{
+		if (m_Times)
+			m_Times->clear();
+	}
+
+	// end the current stage, and start the next one
+	void Stage(const char* vStageName)
+	{
+		auto now = std::chrono::steady_clock::now();
+		if (m_Times)
+			m_Times->emplace_back(vStageName, std::chrono::duration<double, std::milli>(now - m_Start).count());
+		m_Start = now;
+	}
+};
+
 std::shared_ptr<FontInfos> FontInfos::Create()
 {
 	auto res = std::make_shared<FontInfos>();
@@ -77,6 +107,10 @@ void FontInfos::Clear()
 {
 	DestroyFontTexture();
 	m_ImFontAtlas.Clear();
+	m_SfntlyFont.reset();
+	m_SfntlyFailedBlob.reset();
+	m_FontBlob.reset(); // after the atlas, who point on it
+	m_DeferredFontFilePathName.clear();
 	m_GlyphNames.clear();
 	m_GlyphCodePointToName.clear();
 	m_SelectedGlyphs.clear();
@@ -94,6 +128,9 @@ bool FontInfos::LoadFont( const std::string& vFontFilePathName)
 {
 	bool res = false;
 
+	// cleared before any return, else EnsureLoaded / GetImFont will call it again
+	m_DeferredFontFilePathName.clear();
+
 	if (!ProjectFile::Instance()->IsLoaded())
 		return res;
 
@@ -125,33 +162,28 @@ bool FontInfos::LoadFont( const std::string& vFontFilePathName)
 		{
 			m_FontFileName = ps.name + "." + ps.ext;
 
-			ImFont *font = m_ImFontAtlas.AddFontFromFileTTF(
-				fontFilePathName.c_str(),
-				(float)m_FontSize,
-				&m_FontConfig);
+			FontBuildStageTimer timer(&m_LastBuildStageTimes);
+
+			// the font file is read one time and shared, the atlas only keep a view on it
+			// an owned copy, not a mapping, the file can be rewritten on disk while loaded
+			ImFont* font = nullptr;
+			m_FontBlob = FontBlobRegistry::Instance()->GetOwnedBlob(fontFilePathName);
+			FontPrefetcher::Instance()->Release(fontFilePathName); // the blob is now kept by the font
+			if (m_FontBlob)
+			{
+				m_FontConfig.FontDataOwnedByAtlas = false;
+				font = m_ImFontAtlas.AddFontFromMemoryTTF(
+					(void*)m_FontBlob->GetDatas(),
+					(int)m_FontBlob->GetSize(),
+					(float)m_FontSize,
+					&m_FontConfig);
+			}
+			timer.Stage("File loading");
 			if (font)
 			{
-				bool success = false;
-
-				m_ImFontAtlas.TexGlyphPadding = m_FontPadding;
-
-				for (int n = 0; n < m_ImFontAtlas.ConfigData.Size; n++)
-				{
-					ImFontConfig* font_config = (ImFontConfig*)&m_ImFontAtlas.ConfigData[n];
-					font_config->RasterizerMultiply = m_FontMultiply;
-					font_config->OversampleH = m_Oversample;
-					font_config->OversampleV = m_Oversample;
-				}
-				
 				FT_Error freetypeError = 0;
-				if (m_RasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE)
-				{
-					success = BuildFontAtlas(&m_ImFontAtlas, m_FreeTypeFlag, &freetypeError);
-				}
-				else if (m_RasterizerMode == RasterizerEnum::RASTERIZER_STB)
-				{
-					success = m_ImFontAtlas.Build();
-				}
+				bool success = RasterizeAtlas(&freetypeError);
+				timer.Stage("Atlas");
 
 				m_FontFilePathName = ProjectFile::Instance()->GetRelativePath(fontFilePathName);
 
@@ -164,13 +196,18 @@ bool FontInfos::LoadFont( const std::string& vFontFilePathName)
 
 						DestroyFontTexture();
 						CreateFontTexture();
+						timer.Stage("Texture");
 
 						FillGlyphNames();
+						timer.Stage("Glyph names");
 						GenerateCodePointToGlypNamesDB();
+						timer.Stage("Glyphs db");
 						FillGlyphColoreds();
+						timer.Stage("Colored glyphs");
 						UpdateInfos();
 						UpdateFiltering();
 						UpdateSelectedGlyphs(font);
+						timer.Stage("Infos / filtering / selection");
 
 						m_NeedFilePathResolve = false;
 
@@ -210,6 +247,138 @@ bool FontInfos::LoadFont( const std::string& vFontFilePathName)
 	return res;
 }
 
+// only the saved metadatas (selection, params) are restored at project open
+// the atlas, texture and glyphs db are built at first display or generation (see EnsureLoaded)
+// the file is prefetched in background meanwhile
+void FontInfos::DeferLoadFont(const std::string& vFontFilePathName)
+{
+	std::string fontFilePathName = FileHelper::Instance()->CorrectSlashTypeForFilePathName(vFontFilePathName);
+
+	if (!FileHelper::Instance()->IsAbsolutePath(fontFilePathName))
+	{
+		fontFilePathName = ProjectFile::Instance()->GetAbsolutePath(fontFilePathName);
+	}
+
+	if (FileHelper::Instance()->IsFileExist(fontFilePathName))
+	{
+		m_DeferredFontFilePathName = fontFilePathName;
+		m_NeedFilePathResolve = false;
+		FontPrefetcher::Instance()->Add(fontFilePathName);
+	}
+	else
+	{
+		LoadFont(fontFilePathName); // for the error message and the path resolve
+	}
+}
+
+// load the font if deferred, return true if the font is ready for display / generation
+bool FontInfos::EnsureLoaded()
+{
+	if (IsLoadDeferred())
+	{
+		const std::string fontFilePathName = m_DeferredFontFilePathName;
+
+		// a deferred load is not a change of the project
+		const bool changed = ProjectFile::Instance()->IsThereAnyNotSavedChanged();
+		LoadFont(fontFilePathName);
+		ProjectFile::Instance()->SetProjectChange(changed);
+	}
+
+	// not GetImFont, who call this func while the load is deferred
+	return (!IsLoadDeferred() && !m_ImFontAtlas.Fonts.empty());
+}
+
+// rebuild only the stages needed by a param change
+// the font datas, the glyph names and (if not asked) the colored glyphs are kept
+// return false if the font is not loaded or if the atlas build fail, a full LoadFont is needed in this case
+bool FontInfos::RebuildFont(FontRebuildStageFlags vStages)
+{
+	if (IsLoadDeferred())
+		return true; // the new params will be used by the deferred load
+
+	if (m_ImFontAtlas.ConfigData.empty() || !GetImFont())
+		return false;
+
+	if (vStages == FONT_REBUILD_STAGE_NONE)
+		return true;
+
+	FontBuildStageTimer timer(&m_LastBuildStageTimes);
+
+	if (vStages & FONT_REBUILD_STAGE_ATLAS)
+	{
+		m_FontConfig.OversampleH = m_Oversample;
+		m_FontConfig.OversampleV = m_Oversample;
+		for (int n = 0; n < m_ImFontAtlas.ConfigData.Size; n++)
+		{
+			m_ImFontAtlas.ConfigData[n].SizePixels = (float)m_FontSize;
+		}
+
+		FT_Error freetypeError = 0;
+		if (!RasterizeAtlas(&freetypeError) || !GetImFont())
+			return false;
+		timer.Stage("Atlas");
+	}
+
+	if (vStages & (FONT_REBUILD_STAGE_ATLAS | FONT_REBUILD_STAGE_TEXTURE))
+	{
+		DestroyFontTexture();
+		CreateFontTexture();
+		timer.Stage("Texture");
+	}
+
+	if (vStages & FONT_REBUILD_STAGE_GLYPHS_DB)
+	{
+		GenerateCodePointToGlypNamesDB();
+		timer.Stage("Glyphs db");
+	}
+
+	if (vStages & FONT_REBUILD_STAGE_COLORED)
+	{
+		FillGlyphColoreds();
+		timer.Stage("Colored glyphs");
+	}
+
+	// the glyphs (uv's, advance..) are copied in the filtered and selected glyphs
+	if (vStages & (FONT_REBUILD_STAGE_ATLAS | FONT_REBUILD_STAGE_GLYPHS_DB | FONT_REBUILD_STAGE_COLORED))
+	{
+		UpdateInfos();
+		UpdateFiltering();
+		UpdateSelectedGlyphs(GetImFont());
+		timer.Stage("Infos / filtering / selection");
+	}
+
+	ProjectFile::Instance()->SetProjectChange();
+
+	return true;
+}
+
+// build the atlas with the font datas already in m_ImFontAtlas.ConfigData
+bool FontInfos::RasterizeAtlas(FT_Error* vFreetypeError)
+{
+	bool success = false;
+
+	m_ImFontAtlas.TexGlyphPadding = m_FontPadding;
+
+	for (int n = 0; n < m_ImFontAtlas.ConfigData.Size; n++)
+	{
+		ImFontConfig* font_config = (ImFontConfig*)&m_ImFontAtlas.ConfigData[n];
+		font_config->RasterizerMultiply = m_FontMultiply;
+		font_config->OversampleH = m_Oversample;
+		font_config->OversampleV = m_Oversample;
+	}
+
+	if (m_RasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE)
+	{
+		success = BuildFontAtlas(&m_ImFontAtlas, m_FreeTypeFlag, vFreetypeError);
+	}
+	else if (m_RasterizerMode == RasterizerEnum::RASTERIZER_STB)
+	{
+		success = m_ImFontAtlas.Build();
+	}
+
+	return success;
+}
+
 static const char *standardMacNames[258] = 
 { ".notdef", ".null", "nonmarkingreturn", "space", "exclam", "quotedbl", "numbersign", "dollar", "percent", 
 "ampersand", "quotesingle", "parenleft", "parenright", "asterisk", "plus", "comma", "hyphen", "period", 
@@ -394,7 +563,7 @@ void FontInfos::DrawInfos()
 {
 	if (!m_ImFontAtlas.Fonts.empty())
 	{
-		bool needFontReGen = false;
+		FontRebuildStageFlags rebuildStages = FONT_REBUILD_STAGE_NONE;
 
 		float aw = 0.0f;
 
@@ -448,6 +617,21 @@ void FontInfos::DrawInfos()
 
 				ImGui::Text("Selected glyphs : %u", (uint32_t)m_SelectedGlyphs.size());
 
+				if (!m_LastBuildStageTimes.empty())
+				{
+					double totalTime = 0.0;
+					for (const auto& stage : m_LastBuildStageTimes)
+						totalTime += stage.second;
+					ImGui::Text("Last build : %.2f ms", totalTime);
+					if (ImGui::IsItemHovered())
+					{
+						ImGui::BeginTooltip();
+						for (const auto& stage : m_LastBuildStageTimes)
+							ImGui::Text("%s : %.2f ms", stage.first.c_str(), stage.second);
+						ImGui::EndTooltip();
+					}
+				}
+
 				ImGui::EndFramedGroup();
 			}
 		}
@@ -486,7 +670,7 @@ void FontInfos::DrawInfos()
 
 			if (ImGui::RadioButtonLabeled(aw, "FreeType", "Use FreeType Raterizer", FontInfos::m_RasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE))
 			{
-				needFontReGen = true;
+				rebuildStages |= FONT_REBUILD_STAGE_ATLAS | FONT_REBUILD_STAGE_GLYPHS_DB | FONT_REBUILD_STAGE_COLORED;
 				FontInfos::m_RasterizerMode = RasterizerEnum::RASTERIZER_FREETYPE;
 			}
 
@@ -494,14 +678,14 @@ void FontInfos::DrawInfos()
 
 			if (ImGui::RadioButtonLabeled(aw, "Stb", "Use Stb Raterizer", FontInfos::m_RasterizerMode == RasterizerEnum::RASTERIZER_STB))
 			{
-				needFontReGen = true;
+				rebuildStages |= FONT_REBUILD_STAGE_ATLAS | FONT_REBUILD_STAGE_GLYPHS_DB | FONT_REBUILD_STAGE_COLORED;
 				FontInfos::m_RasterizerMode = RasterizerEnum::RASTERIZER_STB;
 			}
 
 #ifdef _DEBUG
 			if (ImGui::RadioButtonLabeled(aw, "Linear", "Use Linear Texture Filtering", m_TextureFiltering == TextureFilteringEnum::TEX_FILTER_LINEAR))
 			{
-				needFontReGen = true;
+				rebuildStages |= FONT_REBUILD_STAGE_TEXTURE;
 				m_TextureFiltering = TextureFilteringEnum::TEX_FILTER_LINEAR;
 			}
 
@@ -509,50 +693,52 @@ void FontInfos::DrawInfos()
 
 			if (ImGui::RadioButtonLabeled(aw, "Nearest", "Use Nearest Texture Filtering", m_TextureFiltering == TextureFilteringEnum::TEX_FILTER_NEAREST))
 			{
-				needFontReGen = true;
+				rebuildStages |= FONT_REBUILD_STAGE_TEXTURE;
 				m_TextureFiltering = TextureFilteringEnum::TEX_FILTER_NEAREST;
 			}
 #endif
 
 			ImGui::FramedGroupSeparator();
 
-			needFontReGen |= ImGui::SliderIntDefaultCompact(-1.0f, "Font Size", &ProjectFile::Instance()->m_SelectedFont->m_FontSize, 7, 50, defaultFontInfosValues.m_FontSize);
+			if (ImGui::SliderIntDefaultCompact(-1.0f, "Font Size", &ProjectFile::Instance()->m_SelectedFont->m_FontSize, 7, 50, defaultFontInfosValues.m_FontSize)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS;
 
 			if (FontInfos::m_RasterizerMode == RasterizerEnum::RASTERIZER_STB)
 			{
-				needFontReGen |= ImGui::SliderIntDefaultCompact(-1.0f, "Font Anti-aliasing", &ProjectFile::Instance()->m_SelectedFont->m_Oversample, 1, 5, defaultFontInfosValues.m_Oversample);
+				if (ImGui::SliderIntDefaultCompact(-1.0f, "Font Anti-aliasing", &ProjectFile::Instance()->m_SelectedFont->m_Oversample, 1, 5, defaultFontInfosValues.m_Oversample)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS;
 			}
 			else if (FontInfos::m_RasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE)
 			{
-				needFontReGen |= ImGui::SliderFloatDefaultCompact(-1.0f, "Multiply", &m_FontMultiply, 0.0f, 2.0f, 1.0f);
+				if (ImGui::SliderFloatDefaultCompact(-1.0f, "Multiply", &m_FontMultiply, 0.0f, 2.0f, 1.0f)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS;
 			}
 
-			needFontReGen |= ImGui::SliderIntDefaultCompact(-1.0f, "Padding", &m_FontPadding, 0, 16, 1);
+			if (ImGui::SliderIntDefaultCompact(-1.0f, "Padding", &m_FontPadding, 0, 16, 1)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS;
 
 			if (FontInfos::m_RasterizerMode == RasterizerEnum::RASTERIZER_FREETYPE)
 			{
 				if (ImGui::CollapsingHeader("Freetype Settings"))
 				{
-					needFontReGen |= ImGui::CheckboxFlags("NoHinting", &m_FreeTypeFlag, FreeType_NoHinting);
-					needFontReGen |= ImGui::CheckboxFlags("NoAutoHint", &m_FreeTypeFlag, FreeType_NoAutoHint);
-					needFontReGen |= ImGui::CheckboxFlags("ForceAutoHint", &m_FreeTypeFlag, FreeType_ForceAutoHint);
-					needFontReGen |= ImGui::CheckboxFlags("LightHinting", &m_FreeTypeFlag, FreeType_LightHinting);
-					needFontReGen |= ImGui::CheckboxFlags("MonoHinting", &m_FreeTypeFlag, FreeType_MonoHinting);
-					needFontReGen |= ImGui::CheckboxFlags("Bold", &m_FreeTypeFlag, FreeType_Bold);
-					needFontReGen |= ImGui::CheckboxFlags("Oblique", &m_FreeTypeFlag, FreeType_Oblique);
-					needFontReGen |= ImGui::CheckboxFlags("Monochrome", &m_FreeTypeFlag, FreeType_Monochrome);
-					needFontReGen |= ImGui::CheckboxFlags("LoadColor", &m_FreeTypeFlag, FreeType_LoadColor);
+					if (ImGui::CheckboxFlags("NoHinting", &m_FreeTypeFlag, FreeType_NoHinting)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS;
+					if (ImGui::CheckboxFlags("NoAutoHint", &m_FreeTypeFlag, FreeType_NoAutoHint)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS;
+					if (ImGui::CheckboxFlags("ForceAutoHint", &m_FreeTypeFlag, FreeType_ForceAutoHint)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS;
+					if (ImGui::CheckboxFlags("LightHinting", &m_FreeTypeFlag, FreeType_LightHinting)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS;
+					if (ImGui::CheckboxFlags("MonoHinting", &m_FreeTypeFlag, FreeType_MonoHinting)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS;
+					if (ImGui::CheckboxFlags("Bold", &m_FreeTypeFlag, FreeType_Bold)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS;
+					if (ImGui::CheckboxFlags("Oblique", &m_FreeTypeFlag, FreeType_Oblique)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS;
+					if (ImGui::CheckboxFlags("Monochrome", &m_FreeTypeFlag, FreeType_Monochrome)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS;
+					if (ImGui::CheckboxFlags("LoadColor", &m_FreeTypeFlag, FreeType_LoadColor)) rebuildStages |= FONT_REBUILD_STAGE_ATLAS | FONT_REBUILD_STAGE_COLORED;
 				}
 			}
 
 			ImGui::EndFramedGroup();
 		}
 
-		if (needFontReGen)
+		if (rebuildStages != FONT_REBUILD_STAGE_NONE)
 		{
 			ProjectFile::Instance()->m_SelectedFont->m_FontSize = ct::clamp(ProjectFile::Instance()->m_SelectedFont->m_FontSize, 7, 50);
 			ProjectFile::Instance()->m_SelectedFont->m_Oversample = ct::clamp(ProjectFile::Instance()->m_SelectedFont->m_Oversample, 1, 5);
-			ParamsPane::Instance()->OpenFont(ProjectFile::Instance()->m_SelectedFont->m_FontFilePathName, false);
+			// only the needed stages, else full load
+			if (!ProjectFile::Instance()->m_SelectedFont->RebuildFont(rebuildStages))
+				ParamsPane::Instance()->OpenFont(ProjectFile::Instance()->m_SelectedFont->m_FontFilePathName, false);
 			ProjectFile::Instance()->SetProjectChange();
 		}
 	}
@@ -721,8 +907,12 @@ void FontInfos::ClearTranslations()
 		ProjectFile::Instance()->SetProjectChange();
 }
 
+// a deferred font is loaded here, at first display
 ImFont* FontInfos::GetImFont()
 {
+	if (IsLoadDeferred())
+		EnsureLoaded();
+
 	if (!m_ImFontAtlas.Fonts.empty())
 	{
 		return m_ImFontAtlas.Fonts[0];
@@ -730,6 +920,101 @@ ImFont* FontInfos::GetImFont()
 	return nullptr;
 }
 
+// the sfntly font is parsed only one time per font datas (glyph edition, font generation)
+// a new load of the font (m_FontBlob changed) will parse it again at next call
+// a parse failure is kept, so not parsed again (and not reported again) until the font datas change
+// once resolved (or failed) the call only read the font, so the generation job can call it
+// after Generator::PrepareGeneration
+std::shared_ptr<SfntlyFont> FontInfos::GetSfntlyFont()
+{
+	if (IsLoadDeferred())
+		EnsureLoaded();
+
+	if (!m_FontBlob)
+		return nullptr;
+
+	if (m_SfntlyFont && m_SfntlyFont->m_FontBlob == m_FontBlob)
+		return m_SfntlyFont;
+
+	if (m_SfntlyFailedBlob.lock() == m_FontBlob)
+		return nullptr;
+
+	m_SfntlyFont = SfntlyFont::Create(m_FontBlob);
+	if (!m_SfntlyFont)
+	{
+		m_SfntlyFailedBlob = m_FontBlob;
+		Messaging::Instance()->AddError(true, nullptr, nullptr,
+			"sfntly fail to parse the font file %s", m_FontFileName.c_str());
+	}
+
+	return m_SfntlyFont;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+//// MEMORY //////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// the atlas is allocated by imgui, so also counted in the imgui category of MemoryTracker
+FontMemoryUsageStruct FontInfos::GetMemoryUsage() const
+{
+	FontMemoryUsageStruct res;
+
+	const size_t countPixels = (size_t)m_ImFontAtlas.TexWidth * (size_t)m_ImFontAtlas.TexHeight;
+	if (m_ImFontAtlas.TexPixelsAlpha8)
+		res.atlasPixels += countPixels;
+	if (m_ImFontAtlas.TexPixelsRGBA32)
+		res.atlasPixels += countPixels * 4U;
+
+	for (auto font : m_ImFontAtlas.Fonts)
+	{
+		if (font)
+		{
+			res.atlasGlyphs += sizeof(ImFont) +
+				(size_t)font->Glyphs.Capacity * sizeof(ImFontGlyph) +
+				(size_t)font->IndexAdvanceX.Capacity * sizeof(float) +
+				(size_t)font->IndexLookup.Capacity * sizeof(ImWchar);
+		}
+	}
+
+	res.glyphNames = MemoryTracker::GetVectorSize(m_GlyphNames);
+	for (const auto& name : m_GlyphNames)
+		res.glyphNames += MemoryTracker::GetStringSize(name);
+
+	res.codePointMaps =
+		MemoryTracker::GetMapNodesSize(m_GlyphCodePointToName) +
+		MemoryTracker::GetMapNodesSize(m_GlyphCodePointToGlyphIndex) +
+		MemoryTracker::GetMapNodesSize(m_GlyphGlyphIndexToCodePoint) +
+		MemoryTracker::GetMapNodesSize(m_ColoredGlyphs);
+	for (const auto& it : m_GlyphCodePointToName)
+		res.codePointMaps += MemoryTracker::GetStringSize(it.second);
+
+	res.selectedGlyphs = MemoryTracker::GetMapNodesSize(m_SelectedGlyphs);
+	for (const auto& it : m_SelectedGlyphs)
+	{
+		if (it.second)
+			res.selectedGlyphs += it.second->GetMemoryUsage();
+	}
+
+	// the GlyphInfos are the ones of m_SelectedGlyphs, only the containers are counted
+	res.orderedGlyphs =
+		MemoryTracker::GetMapNodesSize(m_GlyphsOrderedByCodePoints) +
+		MemoryTracker::GetMapNodesSize(m_GlyphsOrderedByGlyphName);
+	for (const auto& it : m_GlyphsOrderedByCodePoints)
+		res.orderedGlyphs += MemoryTracker::GetVectorSize(it.second);
+	for (const auto& it : m_GlyphsOrderedByGlyphName)
+		res.orderedGlyphs += MemoryTracker::GetStringSize(it.first) + MemoryTracker::GetVectorSize(it.second);
+
+	res.filteredGlyphs = MemoryTracker::GetVectorSize(m_FilteredGlyphs);
+
+	if (m_FontTexture)
+		res.texture = (size_t)m_FontTexture->w * (size_t)m_FontTexture->h * (size_t)m_FontTexture->n;
+
+	if (m_FontBlob)
+		res.fontFile = m_FontBlob->GetSize();
+
+	return res;
+}
+
 //////////////////////////////////////////////////////////////////////////////
 //// FONT TEXTURE ////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -765,14 +1050,14 @@ void FontInfos::DestroyFontTexture()
 
 std::string FontInfos::getXml(const std::string& vOffset, const std::string& vUserDatas)
 {
-	UNUSED(vUserDatas);
-
 	std::string res;
 
 	res += vOffset + "<font name=\"" + m_FontFileName + "\">\n";
 
-	if (!m_SelectedGlyphs.empty())
+	// the compact project file save the glyphs in binary records
+	if (!m_SelectedGlyphs.empty() && vUserDatas != PROJECT_COMPACT_XML_USER_DATAS)
 	{
+		res.reserve(m_SelectedGlyphs.size() * 128U); // avoid the reallocations of the concatenations
 		res += vOffset + "\t<glyphs>\n";
 		for (auto &it : m_SelectedGlyphs)
 		{
@@ -24,6 +24,7 @@
 #include <Generator/GenMode.h>
 
 #include <Helper/TextureHelper.h>
+#include <Helper/FontBlobRegistry.h>
 
 #include <imgui/imgui.h>
 #include <string>
@@ -39,6 +40,17 @@ enum class RasterizerEnum
 	RASTERIZER_Count
 };
 
+// stages of a font build, a param change only need some of them
+typedef int FontRebuildStageFlags;
+enum _FontRebuildStageFlags
+{
+	FONT_REBUILD_STAGE_NONE = 0,
+	FONT_REBUILD_STAGE_TEXTURE = (1 << 0), // texture params (filtering) : only a new texture upload
+	FONT_REBUILD_STAGE_ATLAS = (1 << 1), // rasterizer params (size, oversample, multiply, padding, freetype flags) : atlas build with the loaded font datas
+	FONT_REBUILD_STAGE_GLYPHS_DB = (1 << 2), // rasterizer change : the rasterized glyphs can change, so the codepoint/names db
+	FONT_REBUILD_STAGE_COLORED = (1 << 3), // rasterizer or color flag change : the colored glyphs map
+};
+
 struct GlyphsRange
 {
 //	std::set<uint32_t> datas;
@@ -46,7 +58,28 @@ struct GlyphsRange
 	int rangeEnd = 0;
 };
 
+// memory used by a font, in bytes (see FontInfos::GetMemoryUsage and MemoryPane)
+// the heap of the std containers is estimated
+struct FontMemoryUsageStruct
+{
+	size_t atlasPixels = 0U; // alpha8 and rgba32 pixels of the imgui atlas
+	size_t atlasGlyphs = 0U; // glyphs and lookup tables of the imgui fonts
+	size_t glyphNames = 0U;
+	size_t codePointMaps = 0U; // codepoint <> name / glyph index / colored
+	size_t selectedGlyphs = 0U; // GlyphInfos of the selection
+	size_t orderedGlyphs = 0U; // selection ordered by codepoints and names
+	size_t filteredGlyphs = 0U;
+	size_t texture = 0U; // gpu, not in the total
+	size_t fontFile = 0U; // file datas, shared between the fonts of the same file, not in the total
+
+	size_t GetTotal() const
+	{
+		return atlasPixels + atlasGlyphs + glyphNames + codePointMaps + selectedGlyphs + orderedGlyphs + filteredGlyphs;
+	}
+};
+
 class ProjectFile;
+class SfntlyFont;
 class FontInfos : public conf::ConfigAbstract, public GenMode
 {
 public:
@@ -54,6 +87,9 @@ public:
 
 public: // not to save
 	std::weak_ptr<FontInfos> m_This;
+	std::shared_ptr<const FontBlob> m_FontBlob = nullptr; // font file datas, must outlive the atlas config
+	std::shared_ptr<SfntlyFont> m_SfntlyFont = nullptr; // sfntly parsing of m_FontBlob, created at first need (see GetSfntlyFont)
+	std::weak_ptr<const FontBlob> m_SfntlyFailedBlob; // sfntly fail to parse it, not parsed again
 	ImFontAtlas m_ImFontAtlas;
 	std::shared_ptr<TextureObject> m_FontTexture = nullptr;
 	std::vector<std::string> m_GlyphNames;
@@ -77,6 +113,8 @@ public: // not to save
 	std::vector<std::pair<std::string, std::string>> m_InfosToDisplay;
 	ImGuiListClipper m_InfosToDisplayClipper;
 	std::vector<ImFontGlyph> m_FilteredGlyphs;
+	std::vector<std::pair<std::string, double>> m_LastBuildStageTimes; // stage name, duration in ms
+	std::string m_DeferredFontFilePathName; // font file to load at first need (see EnsureLoaded), empty when loaded
 
 public: // to save
 	std::map<uint32_t, std::shared_ptr<GlyphInfos>> m_SelectedGlyphs;
@@ -98,6 +136,10 @@ public: // to save
 
 public: // callable
 	bool LoadFont( const std::string& vFontFilePathName);
+	void DeferLoadFont(const std::string& vFontFilePathName);
+	bool EnsureLoaded();
+	bool IsLoadDeferred() const { return !m_DeferredFontFilePathName.empty(); }
+	bool RebuildFont(FontRebuildStageFlags vStages);
 	void Clear();
 	std::string GetGlyphName(uint32_t vCodePoint);
 	void DrawInfos();
@@ -108,12 +150,17 @@ public: // callable
 	void ClearScales();
 	void ClearTranslations();
 	ImFont* GetImFont();
+	std::shared_ptr<SfntlyFont> GetSfntlyFont();
+	FontMemoryUsageStruct GetMemoryUsage() const;
 
 private: // Glyph Names Extraction / DB
 	void FillGlyphNames();
 	void GenerateCodePointToGlypNamesDB();
 	void FillGlyphColoreds();
 
+private: // Atlas
+	bool RasterizeAtlas(ImGuiFreeType::FT_Error* vFreetypeError);
+
 private: // Texture
 	void CreateFontTexture();
 	void DestroyFontTexture();
@@ -28,6 +28,8 @@
 #include <Gui/ImWidgets.h>
 #include <Helper/ThemeHelper.h>
 #include <Helper/AssetManager.h>
+#include <Helper/GlyphBatchHelper.h>
+#include <Helper/MemoryTracker.h>
 #include <Panes/DebugPane.h>
 
  ///////////////////////////////////////////////////////////////////////////////////
@@ -112,6 +114,30 @@ void SimpleGlyph_Solo::Clear()
 	onCurve.clear();
 	isValid = false;
 	rc = 0;
+	++m_GlyphVersion; // outline cache invalidated
+}
+
+// heap only, the outline cache included
+size_t SimpleGlyph_Solo::GetMemoryUsage() const
+{
+	size_t res = MemoryTracker::GetVectorSize(coords);
+	for (const auto& contour : coords)
+		res += MemoryTracker::GetVectorSize(contour);
+	res += MemoryTracker::GetVectorSize(onCurve);
+	for (const auto& contour : onCurve)
+		res += MemoryTracker::GetVectorSize(contour);
+
+	res += MemoryTracker::GetVectorSize(m_OutlineCache.outlines);
+	for (const auto& outline : m_OutlineCache.outlines)
+		res += MemoryTracker::GetVectorSize(outline);
+	res += MemoryTracker::GetVectorSize(m_OutlineCache.controlLines);
+	for (const auto& line : m_OutlineCache.controlLines)
+		res += MemoryTracker::GetVectorSize(line);
+	res += MemoryTracker::GetVectorSize(m_OutlineCache.strokes);
+	for (const auto& stroke : m_OutlineCache.strokes)
+		res += MemoryTracker::GetVectorSize(stroke.vtxs) + MemoryTracker::GetVectorSize(stroke.idxs);
+
+	return res;
 }
 
 void SimpleGlyph_Solo::LoadSimpleGlyph(sfntly::GlyphTable::SimpleGlyph *vGlyph)
@@ -213,6 +239,153 @@ ImVec2 SimpleGlyph_Solo::getLocalToScreen(ImVec2 vLocalPos, ImVec2 vZoneStart, I
 	return screenPos;
 }
 
+///////////////////////////////////////////////////////////////////////////////////
+//// OUTLINE CACHE ////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////////
+
+#define GLYPH_OUTLINE_ZOOM_BUCKETS_PER_OCTAVE 4.0f // the auto tesselation is redone each quarter of zoom octave
+#define GLYPH_OUTLINE_MAX_SEGMENTS 64
+
+static inline bool IsSameVec2(const ImVec2& a, const ImVec2& b)
+{
+	return IS_FLOAT_EQUAL(a.x, b.x) && IS_FLOAT_EQUAL(a.y, b.y);
+}
+
+// the contours flattened in font space, like the PathBezierQuadraticCurveTo of DrawCurves before the cache
+// in auto mode (vQuadBezierCountSegments == 0), the count of segments is computed for the upper zoom of the bucket
+void SimpleGlyph_Solo::FlattenOutline(int vQuadBezierCountSegments, int vZoomBucket, float vCurveTessellationTol)
+{
+	auto& cache = m_OutlineCache;
+	cache.outlines.clear();
+	cache.controlLines.clear();
+
+	const float bucketScale = powf(2.0f, (float)(vZoomBucket + 1) / GLYPH_OUTLINE_ZOOM_BUCKETS_PER_OCTAVE);
+	const float tol = ImMax(vCurveTessellationTol, 0.01f);
+
+	int cmax = (int)coords.size();
+	for (int c = 0; c < cmax; c++)
+	{
+		cache.outlines.emplace_back();
+		cache.controlLines.emplace_back();
+		auto& outline = cache.outlines.back();
+		auto& controlLine = cache.controlLines.back();
+
+		int pmax = (int)coords[c].size();
+
+		int firstOn = 0;
+		for (int p = 0; p < pmax; p++)
+		{
+			if (IsOnCurve(c, p))
+			{
+				firstOn = p;
+				break;
+			}
+		}
+
+		ct::ivec2 first = GetCoords(c, firstOn);
+		ImVec2 last = ImVec2((float)first.x, (float)first.y);
+		outline.push_back(last);
+		controlLine.push_back(last);
+
+		for (int i = 0; i < pmax; i++)
+		{
+			int icurr = firstOn + i + 1;
+			int inext = firstOn + i + 2;
+			ct::ivec2 cur = GetCoords(c, icurr);
+			ImVec2 p1 = ImVec2((float)cur.x, (float)cur.y);
+
+			if (IsOnCurve(c, icurr))
+			{
+				outline.push_back(p1);
+				controlLine.push_back(p1);
+				last = p1;
+			}
+			else
+			{
+				ct::ivec2 nex = GetCoords(c, inext);
+				if (!IsOnCurve(c, inext))
+				{
+					nex.x = (int)(((double)nex.x + (double)cur.x) * 0.5);
+					nex.y = (int)(((double)nex.y + (double)cur.y) * 0.5);
+				}
+				ImVec2 p2 = ImVec2((float)nex.x, (float)nex.y);
+
+				int countSegments = vQuadBezierCountSegments;
+				if (countSegments <= 0)
+				{
+					// max distance between the curve and n segments : |p0 - 2p1 + p2| / (4 n^2)
+					const ImVec2 d = (last - p1 * 2.0f + p2) * bucketScale;
+					const float dist = sqrtf(d.x * d.x + d.y * d.y);
+					countSegments = (int)ceilf(sqrtf(dist / (4.0f * tol)));
+				}
+				countSegments = ImClamp(countSegments, 1, GLYPH_OUTLINE_MAX_SEGMENTS);
+
+				for (int seg = 1; seg <= countSegments; seg++)
+				{
+					const float t = (float)seg / (float)countSegments;
+					const float u = 1.0f - t;
+					outline.push_back(last * (u * u) + p1 * (2.0f * u * t) + p2 * (t * t));
+				}
+
+				controlLine.push_back(p1);
+				controlLine.push_back(p2);
+				last = p2;
+			}
+		}
+	}
+
+	cache.stroked = false;
+}
+
+// the flattened contours stroked like DrawCurves before the cache (1px closed lines)
+// the vertexs are relative to the canvas start, so only an offset is applied at each frame
+void SimpleGlyph_Solo::StrokeOutline(ImDrawList* vDrawList, int vMaxContour, GlyphDrawingFlags vGlyphDrawingFlags,
+	float vCanvasScale, ImVec2 vCanvasOrigin, ImVec2 vCanvasSize, ImVec2 vLocalOrigin)
+{
+	auto& cache = m_OutlineCache;
+	cache.strokes.clear();
+
+	// a draw list only for stroke, with the same flags (anti aliasing) and the same white pixel
+	ImDrawList tmpDrawList(ImGui::GetDrawListSharedData());
+	std::vector<ImVec2> points;
+
+	const int cmax = ImMin((int)cache.outlines.size(), vMaxContour);
+	for (int c = 0; c < cmax; c++)
+	{
+		tmpDrawList._ResetForNewFrame();
+		tmpDrawList.Flags = vDrawList->Flags;
+
+		points.clear();
+		for (const auto& p : cache.outlines[c])
+		{
+			points.push_back(ImVec2(
+				(p.x - vLocalOrigin.x) * vCanvasScale + vCanvasOrigin.x,
+				vCanvasSize.y - (p.y - vLocalOrigin.y) * vCanvasScale + vCanvasOrigin.y));
+		}
+		tmpDrawList.AddPolyline(points.data(), (int)points.size(), cache.outlineCol, ImDrawFlags_Closed, 1.0f);
+
+		if (vGlyphDrawingFlags & GLYPH_DRAWING_GLYPH_CONTROL_LINES) // control lines
+		{
+			points.clear();
+			for (const auto& p : cache.controlLines[c])
+			{
+				points.push_back(ImVec2(
+					(p.x - vLocalOrigin.x) * vCanvasScale + vCanvasOrigin.x,
+					vCanvasSize.y - (p.y - vLocalOrigin.y) * vCanvasScale + vCanvasOrigin.y));
+			}
+			tmpDrawList.AddPolyline(points.data(), (int)points.size(), cache.controlLineCol, ImDrawFlags_Closed, 1.0f);
+		}
+
+		// the indexs start at 0 after the reset
+		cache.strokes.emplace_back();
+		auto& stroke = cache.strokes.back();
+		stroke.vtxs.assign(tmpDrawList.VtxBuffer.begin(), tmpDrawList.VtxBuffer.end());
+		stroke.idxs.assign(tmpDrawList.IdxBuffer.begin(), tmpDrawList.IdxBuffer.end());
+	}
+
+	cache.stroked = true;
+}
+
 // https://github.com/rillig/sfntly/tree/master/java/src/com/google/typography/font/tools/fontviewer
 // we will display the glyph metrics like here : https://www.libsdl.org/projects/SDL_ttf/docs/metrics.png
 void SimpleGlyph_Solo::DrawCurves(
@@ -377,83 +550,74 @@ void SimpleGlyph_Solo::DrawCurves(
 			}
 
 
-			// glyph
-			int cmax = (int)coords.size();
-			for (int c = 0; c < cmax; c++)
+			// glyph, see GlyphOutlineCacheStruct
 			{
-				if (c >= vMaxContour) break;
-
-				int pmax = (int)coords[c].size();
-
-				int firstOn = 0;
-				for (int p = 0; p < pmax; p++)
+				auto& cache = m_OutlineCache;
+
+				const int zoomBucket = (int)ImFloor(log2f(ImMax(newScale, 1e-6f)) * GLYPH_OUTLINE_ZOOM_BUCKETS_PER_OCTAVE);
+				if (!cache.flattened ||
+					cache.glyphVersion != m_GlyphVersion ||
+					!IsSameVec2(ImVec2(cache.translation.x, cache.translation.y), ImVec2(m_Translation.x, m_Translation.y)) ||
+					!IsSameVec2(ImVec2(cache.scale.x, cache.scale.y), ImVec2(m_Scale.x, m_Scale.y)) ||
+					cache.quadBezierCountSegments != vQuadBezierCountSegments ||
+					(vQuadBezierCountSegments <= 0 && cache.zoomBucket != zoomBucket))
 				{
-					if (IsOnCurve(c, p))
-					{
-						firstOn = p;
-						break;
-					}
+					FlattenOutline(vQuadBezierCountSegments, zoomBucket, ImGui::GetStyle().CurveTessellationTol);
+					cache.flattened = true;
+					cache.glyphVersion = m_GlyphVersion;
+					cache.translation = m_Translation;
+					cache.scale = m_Scale;
+					cache.quadBezierCountSegments = vQuadBezierCountSegments;
+					cache.zoomBucket = zoomBucket;
 				}
 
-				// curve
-
-				drawList->PathLineTo(LocalToScreen(GetCoords(c, firstOn)));
-
-				for (int i = 0; i < pmax; i++)
+				const ImU32 outlineCol = ImGui::GetColorU32(ImGuiCol_Text);
+				const ImU32 controlLineCol = ImGui::GetColorU32(ImVec4(0, 0, 1, 1));
+				const bool controlLinesShown = (vGlyphDrawingFlags & GLYPH_DRAWING_GLYPH_CONTROL_LINES);
+				const ImVec2 texUvWhitePixel = ImGui::GetDrawListSharedData()->TexUvWhitePixel;
+				if (!cache.stroked ||
+					!IS_FLOAT_EQUAL(cache.canvasScale, newScale) ||
+					!IsSameVec2(cache.canvasOrigin, fbboxOrign) ||
+					!IsSameVec2(cache.canvasSize, fontBBoxSize) ||
+					!IsSameVec2(cache.texUvWhitePixel, texUvWhitePixel) ||
+					cache.maxContour != vMaxContour ||
+					cache.controlLinesShown != controlLinesShown ||
+					cache.outlineCol != outlineCol ||
+					cache.controlLineCol != controlLineCol ||
+					cache.drawListFlags != drawList->Flags)
 				{
-					int icurr = firstOn + i + 1;
-					int inext = firstOn + i + 2;
-					ct::ivec2 cur = GetCoords(c, icurr);
-
-					if (IsOnCurve(c, icurr))
-					{
-						drawList->PathLineTo(LocalToScreen(cur));
-					}
-					else
-					{
-						ct::ivec2 nex = GetCoords(c, inext);
-						if (!IsOnCurve(c, inext))
-						{
-							nex.x = (int)(((double)nex.x + (double)cur.x) * 0.5);
-							nex.y = (int)(((double)nex.y + (double)cur.y) * 0.5);
-						}
-						drawList->PathBezierQuadraticCurveTo(LocalToScreen(cur), LocalToScreen(nex), vQuadBezierCountSegments);
-					}
+					cache.outlineCol = outlineCol;
+					cache.controlLineCol = controlLineCol;
+					StrokeOutline(drawList, vMaxContour, vGlyphDrawingFlags,
+						newScale, fbboxOrign, fontBBoxSize, ImVec2((float)frc.x, (float)frc.y));
+					cache.canvasScale = newScale;
+					cache.canvasOrigin = fbboxOrign;
+					cache.canvasSize = fontBBoxSize;
+					cache.texUvWhitePixel = texUvWhitePixel;
+					cache.maxContour = vMaxContour;
+					cache.controlLinesShown = controlLinesShown;
+					cache.drawListFlags = drawList->Flags;
 				}
 
-				drawList->PathStroke(ImGui::GetColorU32(ImGuiCol_Text), true);
-
-#ifdef _DEBUG
-				//DebugPane::Instance()->DrawGlyphCurrentPoint(newScale, posOrigin, drawList);
-#endif
-
-				if (vGlyphDrawingFlags & GLYPH_DRAWING_GLYPH_CONTROL_LINES) // control lines
+				// copy of the cached vertexs, with the canvas start as offset
+				for (const auto& stroke : cache.strokes)
 				{
-					drawList->PathLineTo(LocalToScreen(GetCoords(c, firstOn)));
+					if (stroke.vtxs.empty() || stroke.idxs.empty())
+						continue;
 
-					for (int i = 0; i < pmax; i++)
+					drawList->PrimReserve((int)stroke.idxs.size(), (int)stroke.vtxs.size());
+					const ImDrawIdx baseIdx = (ImDrawIdx)drawList->_VtxCurrentIdx;
+					for (const auto& vtx : stroke.vtxs)
 					{
-						int icurr = firstOn + i + 1;
-						int inext = firstOn + i + 2;
-						ct::ivec2 cur = GetCoords(c, icurr);
-						if (IsOnCurve(c, icurr))
-						{
-							drawList->PathLineTo(LocalToScreen(cur));
-						}
-						else
-						{
-							ct::ivec2 nex = GetCoords(c, inext);
-							if (!IsOnCurve(c, inext))
-							{
-								nex.x = (int)(((double)nex.x + (double)cur.x) * 0.5);
-								nex.y = (int)(((double)nex.y + (double)cur.y) * 0.5);
-							}
-							drawList->PathLineTo(LocalToScreen(cur));
-							drawList->PathLineTo(LocalToScreen(nex));
-						}
+						*drawList->_VtxWritePtr = vtx;
+						drawList->_VtxWritePtr->pos += contentStart;
+						drawList->_VtxWritePtr++;
 					}
-
-					drawList->PathStroke(ImGui::GetColorU32(ImVec4(0, 0, 1, 1)), true);
+					for (const auto& idx : stroke.idxs)
+					{
+						*drawList->_IdxWritePtr++ = (ImDrawIdx)(baseIdx + idx);
+					}
+					drawList->_VtxCurrentIdx += (unsigned int)stroke.vtxs.size();
 				}
 			}
 
@@ -490,6 +654,18 @@ void CompositeGlyph_Solo::Clear()
 	rc = 0;
 }
 
+// heap only
+size_t CompositeGlyph_Solo::GetMemoryUsage() const
+{
+	size_t res = MemoryTracker::GetVectorSize(coords);
+	for (const auto& contour : coords)
+		res += MemoryTracker::GetVectorSize(contour);
+	res += MemoryTracker::GetVectorSize(onCurve);
+	for (const auto& contour : onCurve)
+		res += MemoryTracker::GetVectorSize(contour);
+	return res;
+}
+
 void CompositeGlyph_Solo::LoadCompositeGlyph(sfntly::GlyphTable::CompositeGlyph* vGlyph)
 {
 	if (vGlyph)
@@ -929,6 +1105,17 @@ void GlyphInfos::SetFontInfos(std::weak_ptr<FontInfos> vFontInfos)
 	}
 }
 
+// the object itself (allocated by Create) and his heap
+size_t GlyphInfos::GetMemoryUsage() const
+{
+	return sizeof(GlyphInfos) +
+		MemoryTracker::GetStringSize(oldHeaderName) +
+		MemoryTracker::GetStringSize(newHeaderName) +
+		MemoryTracker::GetStringSize(editHeaderName) +
+		simpleGlyph.GetMemoryUsage() +
+		compositeGlyph.GetMemoryUsage();
+}
+
 void GlyphInfos::GetGlyphButtonColorsForCodePoint(bool vShowRangeColoring, CodePoint vCurCdp, CodePoint vLastCdp, ImVec4* vOut3StateColors)
 {
 	if (vOut3StateColors)
@@ -1128,9 +1315,7 @@ void GlyphInfos::RenderGlyph(ImFont* vFont, ImDrawList* vDrawList, float vGlyphH
 		ImVec2 uv0 = ImVec2(glyph->U0, glyph->V0);
 		ImVec2 uv1 = ImVec2(glyph->U1, glyph->V1);
 
-		vDrawList->PushTextureID(vFont->ContainerAtlas->TexID);
-		vDrawList->PrimReserve(6, 4);
-		vDrawList->PrimRectUV(pMin, pMax, uv0, uv1, vCol);
-		vDrawList->PopTextureID();
+		// batched by texture if the pane record the glyphs, see GlyphBatchHelper
+		GlyphBatchHelper::Instance()->AddGlyphQuad(vDrawList, vFont->ContainerAtlas->TexID, pMin, pMax, uv0, uv1, vCol);
 	}
 }
\ No newline at end of file
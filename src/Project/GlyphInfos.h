@@ -20,6 +20,7 @@
 #include <imgui/imgui.h>
 #include <string>
 #include <memory>
+#include <vector>
 #include <ctools/cTools.h>
 #include <sfntly/table/truetype/glyph_table.h>
 
@@ -71,6 +72,45 @@ enum _GlyphDrawingFlags
 
 class FontInfos;
 class GlyphInfos;
+
+// cache of the glyph outline drawn by SimpleGlyph_Solo::DrawCurves
+// - the contours are flattened in font space, only when the glyph, the transform,
+//   the count of segments or the zoom bucket change (the auto tesselation depend of the zoom)
+// - the stroked vertexs are kept relative to the canvas start and only copied in the draw list each frame,
+//   restroked when the canvas scale, the colors or the flags change
+struct GlyphOutlineStrokeStruct
+{
+	std::vector<ImDrawVert> vtxs;
+	std::vector<ImDrawIdx> idxs;
+};
+
+struct GlyphOutlineCacheStruct
+{
+	// flattening key
+	bool flattened = false;
+	uint32_t glyphVersion = 0U;
+	ct::fvec2 translation;
+	ct::fvec2 scale;
+	int quadBezierCountSegments = -1;
+	int zoomBucket = 0;
+	// flattened contours, in font space
+	std::vector<std::vector<ImVec2>> outlines;
+	std::vector<std::vector<ImVec2>> controlLines;
+
+	// stroking key
+	bool stroked = false;
+	float canvasScale = 0.0f;
+	ImVec2 canvasOrigin;
+	ImVec2 canvasSize;
+	ImVec2 texUvWhitePixel;
+	int maxContour = 0;
+	bool controlLinesShown = false;
+	ImU32 outlineCol = 0;
+	ImU32 controlLineCol = 0;
+	ImDrawListFlags drawListFlags = 0;
+	// one stroke per contour, < 65536 vertexs each
+	std::vector<GlyphOutlineStrokeStruct> strokes;
+};
 class SimpleGlyph_Solo
 {
 public:
@@ -83,13 +123,21 @@ public:
 	ct::fvec2 m_Translation; // translation in first
 	ct::fvec2 m_Scale = 1.0f; // scale in second
 
+private:
+	uint32_t m_GlyphVersion = 0U; // increased at each load, for invalidate the outline cache
+	GlyphOutlineCacheStruct m_OutlineCache;
+
 private:
 	ImVec2 getScreenToLocal(ImVec2 vScreenPos, ImVec2 vZoneStart, ImVec2 vWorldBBoxOrigin, ImVec2 vWorlBBoxSize, float vWorldScale, ImVec2 vLocalBBoxOrigin);
 	ImVec2 getLocalToScreen(ImVec2 vLocalPos, ImVec2 vZoneStart, ImVec2 vWorldBBoxOrigin, ImVec2 vWorlBBoxSize, float vWorldScale, ImVec2 vLocalBBoxOrigin);
+	void FlattenOutline(int vQuadBezierCountSegments, int vZoomBucket, float vCurveTessellationTol);
+	void StrokeOutline(ImDrawList* vDrawList, int vMaxContour, GlyphDrawingFlags vGlyphDrawingFlags,
+		float vCanvasScale, ImVec2 vCanvasOrigin, ImVec2 vCanvasSize, ImVec2 vLocalOrigin);
 
 public:
 	void Clear();
 	void LoadSimpleGlyph(sfntly::GlyphTable::SimpleGlyph *vGlyph);
+	size_t GetMemoryUsage() const;
 	int GetCountContours() const;
 	ct::ivec2 GetCoords(int32_t vContour, int32_t vPoint);
 	bool IsOnCurve(int32_t vContour, int32_t vPoint);
@@ -127,6 +175,7 @@ private:
 public:
 	void Clear();
 	void LoadCompositeGlyph(sfntly::GlyphTable::CompositeGlyph* vGlyph);
+	size_t GetMemoryUsage() const;
 	int GetCountContours() const;
 	ct::ivec2 GetCoords(int32_t vContour, int32_t vPoint);
 	bool IsOnCurve(int32_t vContour, int32_t vPoint);
@@ -210,4 +259,5 @@ public:
 
 	std::weak_ptr<FontInfos> GetFontInfos();
 	void SetFontInfos(std::weak_ptr<FontInfos> vFontInfos);
+	size_t GetMemoryUsage() const; // estimated
 };
@@ -0,0 +1,668 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ProjectCompactFile.h"
+
+#include <Generator/MemoryStream.h>
+#include <Generator/FontChecksum.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <utility>
+
+#define PROJECT_COMPACT_FILE_MAGIC "IFSB"
+#define PROJECT_COMPACT_FILE_VERSION 2
+#define PROJECT_COMPACT_FILE_HEADER_SIZE 6U // magic + version
+#define PROJECT_COMPACT_MIN_JOURNAL_SIZE (64U * 1024U) // under this size, the journal is never compacted
+
+static FILE* OpenFile(const std::string& vFilePathName, const char* vMode)
+{
+#ifdef MSVC
+	FILE* f = nullptr;
+	errno_t err = fopen_s(&f, vFilePathName.c_str(), vMode);
+	if (err) return nullptr;
+	return f;
+#else
+	return fopen(vFilePathName.c_str(), vMode);
+#endif
+}
+
+static uint32_t FloatToBits(float vValue)
+{
+	uint32_t res = 0U;
+	memcpy(&res, &vValue, sizeof(float));
+	return res;
+}
+
+static float BitsToFloat(uint32_t vBits)
+{
+	float res = 0.0f;
+	memcpy(&res, &vBits, sizeof(float));
+	return res;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool GlyphRecordStruct::operator == (const GlyphRecordStruct& v) const
+{
+	return
+		orgCodePoint == v.orgCodePoint &&
+		newCodePoint == v.newCodePoint &&
+		translation[0] == v.translation[0] &&
+		translation[1] == v.translation[1] &&
+		scale[0] == v.scale[0] &&
+		scale[1] == v.scale[1] &&
+		orgName == v.orgName &&
+		newName == v.newName;
+}
+
+void ProjectCompactDatas::Clear()
+{
+	settings.clear();
+	glyphs.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool ProjectCompactFile::IsCompactFile(const std::string& vFilePathName)
+{
+	bool res = false;
+
+	FILE* f = OpenFile(GetLoadableFilePathName(vFilePathName), "rb");
+	if (f)
+	{
+		char magic[4] = {};
+		if (fread(magic, 1, 4, f) == 4)
+		{
+			res = (memcmp(magic, PROJECT_COMPACT_FILE_MAGIC, 4) == 0);
+		}
+		fclose(f);
+	}
+
+	return res;
+}
+
+bool ProjectCompactFile::IsCompactFilePathName(const std::string& vFilePathName)
+{
+	const std::string ext = std::string(".") + PROJECT_COMPACT_FILE_EXT;
+	return vFilePathName.size() > ext.size() &&
+		vFilePathName.compare(vFilePathName.size() - ext.size(), ext.size(), ext) == 0;
+}
+
+void ProjectCompactFile::Clear()
+{
+	m_FilePathName.clear();
+	m_LastSaved.Clear();
+	m_FileSize = 0U;
+	m_SnapshotSize = 0U;
+	m_CountJournalRecords = 0U;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//// LOAD /////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool ProjectCompactFile::Load(const std::string& vFilePathName, ProjectCompactDatas* vOutDatas)
+{
+	Clear();
+
+	if (!vOutDatas)
+		return false;
+
+	vOutDatas->Clear();
+
+	// the file can be missing after a crash during his replace by a new snapshot, but not the temporary file
+	const std::string loadableFilePathName = GetLoadableFilePathName(vFilePathName);
+	const bool recovered = (loadableFilePathName != vFilePathName);
+
+	std::vector<uint8_t> fileDatas;
+	FILE* f = OpenFile(loadableFilePathName, "rb");
+	if (!f)
+		return false;
+	if (fseek(f, 0, SEEK_END) == 0)
+	{
+		const long fileSize = ftell(f);
+		if (fileSize > 0 && fseek(f, 0, SEEK_SET) == 0)
+		{
+			fileDatas.resize((size_t)fileSize);
+			if (fread(fileDatas.data(), 1, fileDatas.size(), f) != fileDatas.size())
+				fileDatas.clear();
+		}
+	}
+	fclose(f);
+
+	if (fileDatas.size() < PROJECT_COMPACT_FILE_HEADER_SIZE ||
+		memcmp(fileDatas.data(), PROJECT_COMPACT_FILE_MAGIC, 4) != 0)
+		return false;
+
+	MemoryStream stream;
+	stream.SetView(fileDatas.data(), fileDatas.size());
+	stream.SetPos(4U);
+	if (stream.ReadUShort() != PROJECT_COMPACT_FILE_VERSION)
+		return false;
+
+	size_t validEnd = stream.GetPos();
+	size_t snapshotEnd = 0U;
+	size_t countJournalRecords = 0U;
+
+	MemoryStream payload;
+	while (validEnd + 5U <= fileDatas.size())
+	{
+		stream.SetPos(validEnd);
+		const auto type = (RecordTypeEnum)stream.ReadByte();
+		const size_t payloadSize = (size_t)stream.ReadULong();
+		const size_t payloadPos = stream.GetPos();
+		if (payloadSize > fileDatas.size() - payloadPos ||
+			fileDatas.size() - payloadPos - payloadSize < 4U)
+			break; // truncated record
+
+		const uint8_t* payloadDatas = fileDatas.data() + payloadPos;
+		stream.SetPos(payloadPos + payloadSize);
+		if ((uint32_t)stream.ReadULong() != FontChecksum::ComputeChecksum(payloadDatas, payloadSize))
+			break; // corrupted record
+
+		payload.SetView(payloadDatas, payloadSize);
+
+		bool ok = true;
+		std::string fontName;
+		GlyphRecordsMap glyphs;
+		switch (type)
+		{
+		case RecordTypeEnum::RECORD_SETTINGS:
+			vOutDatas->settings = payload.ReadString(payloadSize);
+			break;
+		case RecordTypeEnum::RECORD_GLYPHS_SET:
+			ok = ReadGlyphsPayload(&payload, &fontName, &glyphs);
+			if (ok)
+			{
+				if (glyphs.empty())
+					vOutDatas->glyphs.erase(fontName);
+				else
+					vOutDatas->glyphs[fontName] = std::move(glyphs);
+			}
+			break;
+		case RecordTypeEnum::RECORD_GLYPHS_UPSERT:
+			ok = ReadGlyphsPayload(&payload, &fontName, &glyphs);
+			if (ok)
+			{
+				auto& fontGlyphs = vOutDatas->glyphs[fontName];
+				for (auto& it : glyphs)
+				{
+					fontGlyphs[it.first] = std::move(it.second);
+				}
+			}
+			break;
+		case RecordTypeEnum::RECORD_GLYPHS_ERASE:
+			ok = ReadErasePayload(&payload, &fontName, &glyphs);
+			if (ok)
+			{
+				auto it = vOutDatas->glyphs.find(fontName);
+				if (it != vOutDatas->glyphs.end())
+				{
+					for (const auto& glyph : glyphs)
+					{
+						it->second.erase(glyph.first);
+					}
+					if (it->second.empty())
+						vOutDatas->glyphs.erase(it);
+				}
+			}
+			break;
+		case RecordTypeEnum::RECORD_SNAPSHOT_END:
+			snapshotEnd = payloadPos + payloadSize + 4U;
+			break;
+		default: // unknown record of a futur version, skipped
+			break;
+		}
+
+		if (!ok)
+			break;
+
+		validEnd = payloadPos + payloadSize + 4U;
+		if (snapshotEnd && validEnd > snapshotEnd)
+			++countJournalRecords;
+	}
+
+	if (vOutDatas->settings.empty())
+		return false;
+
+	// the temporary file take his place. if not possible, the next save will be a snapshot (file size differ)
+	if (recovered)
+		ReplaceFile(loadableFilePathName, vFilePathName);
+
+	// the journal is continued only if the file is not damaged
+	m_FilePathName = vFilePathName;
+	m_LastSaved = *vOutDatas;
+	m_FileSize = validEnd;
+	m_SnapshotSize = snapshotEnd ? snapshotEnd : validEnd;
+	m_CountJournalRecords = countJournalRecords;
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//// SAVE /////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool ProjectCompactFile::Save(const std::string& vFilePathName, ProjectCompactDatas vDatas)
+{
+	// the journal can be continued only if the file is the one we have written
+	if (!m_FilePathName.empty() &&
+		vFilePathName == m_FilePathName &&
+		m_FileSize == GetFileSize(vFilePathName))
+	{
+		bool needSnapshot = false;
+		if (AppendJournal(vDatas, &needSnapshot))
+			return true;
+		if (!needSnapshot)
+			return false;
+	}
+
+	return WriteSnapshot(vFilePathName, vDatas);
+}
+
+bool ProjectCompactFile::WriteSnapshot(const std::string& vFilePathName, ProjectCompactDatas& vDatas)
+{
+	MemoryStream stream, payload;
+
+	size_t reserveSize = 64U + vDatas.settings.size();
+	for (const auto& font : vDatas.glyphs)
+	{
+		reserveSize += 64U + font.second.size() * 48U;
+	}
+	stream.Reserve(reserveSize);
+
+	WriteFileHeader(&stream);
+
+	payload.WriteBytes((const uint8_t*)vDatas.settings.data(), vDatas.settings.size());
+	WriteRecord(&stream, RecordTypeEnum::RECORD_SETTINGS, &payload);
+
+	for (const auto& font : vDatas.glyphs)
+	{
+		if (!font.second.empty())
+		{
+			payload.Clear();
+			WriteGlyphsPayload(&payload, font.first, font.second);
+			WriteRecord(&stream, RecordTypeEnum::RECORD_GLYPHS_SET, &payload);
+		}
+	}
+
+	payload.Clear();
+	WriteRecord(&stream, RecordTypeEnum::RECORD_SNAPSHOT_END, &payload);
+
+	// written in a temporary file first, for not lost the project if the write fail
+	const std::string tmpFilePathName = GetTmpFilePathName(vFilePathName);
+	if (!WriteFile(tmpFilePathName, &stream, false))
+	{
+		remove(tmpFilePathName.c_str());
+		return false;
+	}
+	if (!ReplaceFile(tmpFilePathName, vFilePathName))
+		return false;
+
+	m_FilePathName = vFilePathName;
+	m_LastSaved = std::move(vDatas); // not used after
+	m_FileSize = stream.Size();
+	m_SnapshotSize = m_FileSize;
+	m_CountJournalRecords = 0U;
+
+	return true;
+}
+
+bool ProjectCompactFile::AppendJournal(ProjectCompactDatas& vDatas, bool* vNeedSnapshot)
+{
+	MemoryStream stream, payload;
+	size_t countRecords = 0U;
+
+	if (vDatas.settings != m_LastSaved.settings)
+	{
+		payload.WriteBytes((const uint8_t*)vDatas.settings.data(), vDatas.settings.size());
+		WriteRecord(&stream, RecordTypeEnum::RECORD_SETTINGS, &payload);
+		++countRecords;
+	}
+
+	static const GlyphRecordsMap _emptyGlyphs;
+
+	for (const auto& font : vDatas.glyphs)
+	{
+		auto itOld = m_LastSaved.glyphs.find(font.first);
+		const GlyphRecordsMap& oldGlyphs = (itOld != m_LastSaved.glyphs.end()) ? itOld->second : _emptyGlyphs;
+
+		GlyphRecordsMap upserts, erases;
+		for (const auto& glyph : font.second)
+		{
+			auto it = oldGlyphs.find(glyph.first);
+			if (it == oldGlyphs.end() || it->second != glyph.second)
+				upserts[glyph.first] = glyph.second;
+		}
+		for (const auto& glyph : oldGlyphs)
+		{
+			if (font.second.find(glyph.first) == font.second.end())
+				erases[glyph.first] = glyph.second;
+		}
+
+		if (upserts.size() + erases.size() > font.second.size() / 2U)
+		{
+			// big change, the full glyph set is smaller
+			payload.Clear();
+			WriteGlyphsPayload(&payload, font.first, font.second);
+			WriteRecord(&stream, RecordTypeEnum::RECORD_GLYPHS_SET, &payload);
+			++countRecords;
+		}
+		else
+		{
+			if (!upserts.empty())
+			{
+				payload.Clear();
+				WriteGlyphsPayload(&payload, font.first, upserts);
+				WriteRecord(&stream, RecordTypeEnum::RECORD_GLYPHS_UPSERT, &payload);
+				++countRecords;
+			}
+			if (!erases.empty())
+			{
+				payload.Clear();
+				WriteErasePayload(&payload, font.first, erases);
+				WriteRecord(&stream, RecordTypeEnum::RECORD_GLYPHS_ERASE, &payload);
+				++countRecords;
+			}
+		}
+	}
+
+	// fonts removed or without selection now
+	for (const auto& font : m_LastSaved.glyphs)
+	{
+		if (vDatas.glyphs.find(font.first) == vDatas.glyphs.end())
+		{
+			payload.Clear();
+			WriteGlyphsPayload(&payload, font.first, _emptyGlyphs);
+			WriteRecord(&stream, RecordTypeEnum::RECORD_GLYPHS_SET, &payload);
+			++countRecords;
+		}
+	}
+
+	if (!countRecords)
+		return true; // nothing changed
+
+	// compaction when the journal become bigger than the snapshot
+	const size_t journalSize = GetJournalSize() + stream.Size();
+	if (journalSize > PROJECT_COMPACT_MIN_JOURNAL_SIZE && journalSize > m_SnapshotSize)
+	{
+		if (vNeedSnapshot)
+			*vNeedSnapshot = true;
+		return false;
+	}
+
+	if (!WriteFile(m_FilePathName, &stream, true))
+	{
+		// the file can have a partial record now, it will be ignored at load
+		// but we cant append after it, so the next save will be a snapshot
+		m_FileSize = 0U;
+		if (vNeedSnapshot)
+			*vNeedSnapshot = true;
+		return false;
+	}
+
+	m_LastSaved = std::move(vDatas); // not used after
+	m_FileSize += stream.Size();
+	m_CountJournalRecords += countRecords;
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//// RECORDS //////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+void ProjectCompactFile::WriteFileHeader(MemoryStream* vStream)
+{
+	vStream->WriteBytes((const uint8_t*)PROJECT_COMPACT_FILE_MAGIC, 4U);
+	vStream->WriteUShort(PROJECT_COMPACT_FILE_VERSION);
+}
+
+void ProjectCompactFile::WriteRecord(MemoryStream* vStream, RecordTypeEnum vType, MemoryStream* vPayload)
+{
+	const size_t payloadSize = vPayload->Size();
+	vStream->WriteByte((uint8_t)vType);
+	vStream->WriteULong((int64_t)payloadSize);
+	vStream->WriteBytes(vPayload->GetDatas(), payloadSize);
+	vStream->WriteULong((int64_t)FontChecksum::ComputeChecksum(vPayload->GetDatas(), payloadSize));
+}
+
+void ProjectCompactFile::WriteString(MemoryStream* vStream, const std::string& vString)
+{
+	const size_t len = (vString.size() < 0xFFFF) ? vString.size() : 0xFFFF;
+	vStream->WriteUShort((int32_t)len);
+	vStream->WriteBytes((const uint8_t*)vString.data(), len);
+}
+
+std::string ProjectCompactFile::ReadString(MemoryStream* vStream)
+{
+	const size_t len = (size_t)vStream->ReadUShort();
+	return vStream->ReadString(len);
+}
+
+// columnar : font name, count, then one array per field
+void ProjectCompactFile::WriteGlyphsPayload(MemoryStream* vStream, const std::string& vFontName, const GlyphRecordsMap& vGlyphs)
+{
+	const size_t count = vGlyphs.size();
+
+	std::vector<uint32_t> orgCodePoints, newCodePoints, transforms;
+	orgCodePoints.reserve(count);
+	newCodePoints.reserve(count);
+	transforms.reserve(count * 4U);
+	for (const auto& it : vGlyphs)
+	{
+		orgCodePoints.push_back(it.second.orgCodePoint);
+		newCodePoints.push_back(it.second.newCodePoint);
+		transforms.push_back(FloatToBits(it.second.translation[0]));
+		transforms.push_back(FloatToBits(it.second.translation[1]));
+		transforms.push_back(FloatToBits(it.second.scale[0]));
+		transforms.push_back(FloatToBits(it.second.scale[1]));
+	}
+
+	vStream->Reserve(vStream->Size() + 8U + vFontName.size() + count * 32U);
+
+	WriteString(vStream, vFontName);
+	vStream->WriteULong((int64_t)count);
+	vStream->WriteULongs(orgCodePoints.data(), orgCodePoints.size());
+	vStream->WriteULongs(newCodePoints.data(), newCodePoints.size());
+	vStream->WriteULongs(transforms.data(), transforms.size());
+	for (const auto& it : vGlyphs)
+	{
+		WriteString(vStream, it.second.orgName);
+	}
+	for (const auto& it : vGlyphs)
+	{
+		WriteString(vStream, it.second.newName);
+	}
+}
+
+bool ProjectCompactFile::ReadGlyphsPayload(MemoryStream* vStream, std::string* vFontName, GlyphRecordsMap* vGlyphs)
+{
+	*vFontName = ReadString(vStream);
+	const size_t count = (size_t)vStream->ReadULong();
+	if (vStream->GetPos() > vStream->Size() ||
+		count * 24U > vStream->Size() - vStream->GetPos())
+		return false; // not enough datas for the codepoints and transforms
+
+	std::vector<uint32_t> orgCodePoints(count), newCodePoints(count), transforms(count * 4U);
+	if (vStream->ReadULongs(orgCodePoints.data(), count) != count ||
+		vStream->ReadULongs(newCodePoints.data(), count) != count ||
+		vStream->ReadULongs(transforms.data(), count * 4U) != count * 4U)
+		return false;
+
+	std::vector<GlyphRecordStruct> records(count);
+	for (size_t i = 0U; i < count; ++i)
+	{
+		auto& record = records[i];
+		record.orgCodePoint = orgCodePoints[i];
+		record.newCodePoint = newCodePoints[i];
+		record.translation[0] = BitsToFloat(transforms[i * 4U]);
+		record.translation[1] = BitsToFloat(transforms[i * 4U + 1U]);
+		record.scale[0] = BitsToFloat(transforms[i * 4U + 2U]);
+		record.scale[1] = BitsToFloat(transforms[i * 4U + 3U]);
+	}
+	for (auto& record : records)
+	{
+		record.orgName = ReadString(vStream);
+	}
+	for (auto& record : records)
+	{
+		record.newName = ReadString(vStream);
+	}
+	if (vStream->GetPos() > vStream->Size())
+		return false;
+
+	vGlyphs->clear();
+	for (auto& record : records)
+	{
+		const uint32_t codePoint = record.orgCodePoint;
+		(*vGlyphs)[codePoint] = std::move(record);
+	}
+
+	return true;
+}
+
+void ProjectCompactFile::WriteErasePayload(MemoryStream* vStream, const std::string& vFontName, const GlyphRecordsMap& vGlyphs)
+{
+	std::vector<uint32_t> codePoints;
+	codePoints.reserve(vGlyphs.size());
+	for (const auto& it : vGlyphs)
+	{
+		codePoints.push_back(it.first);
+	}
+
+	WriteString(vStream, vFontName);
+	vStream->WriteULong((int64_t)codePoints.size());
+	vStream->WriteULongs(codePoints.data(), codePoints.size());
+}
+
+bool ProjectCompactFile::ReadErasePayload(MemoryStream* vStream, std::string* vFontName, GlyphRecordsMap* vGlyphs)
+{
+	*vFontName = ReadString(vStream);
+	const size_t count = (size_t)vStream->ReadULong();
+	if (vStream->GetPos() > vStream->Size() ||
+		count * 4U > vStream->Size() - vStream->GetPos())
+		return false;
+
+	std::vector<uint32_t> codePoints(count);
+	if (vStream->ReadULongs(codePoints.data(), count) != count)
+		return false;
+
+	vGlyphs->clear();
+	for (const auto& codePoint : codePoints)
+	{
+		(*vGlyphs)[codePoint].orgCodePoint = codePoint;
+	}
+
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//// FILE /////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+
+bool ProjectCompactFile::WriteFile(const std::string& vFilePathName, MemoryStream* vStream, bool vAppend)
+{
+	bool res = false;
+
+	FILE* f = OpenFile(vFilePathName, vAppend ? "ab" : "wb");
+	if (f)
+	{
+		const size_t size = vStream->Size();
+		res = (fwrite(vStream->GetDatas(), 1, size, f) == size);
+		res &= (fflush(f) == 0);
+		fclose(f);
+	}
+
+	return res;
+}
+
+// atomic replace of the file, the old or the new file exist at any time
+bool ProjectCompactFile::ReplaceFile(const std::string& vSrcFilePathName, const std::string& vDstFilePathName)
+{
+#ifdef _WIN32
+	return (MoveFileExA(vSrcFilePathName.c_str(), vDstFilePathName.c_str(),
+		MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0);
+#else
+	return (rename(vSrcFilePathName.c_str(), vDstFilePathName.c_str()) == 0);
+#endif
+}
+
+size_t ProjectCompactFile::GetFileSize(const std::string& vFilePathName)
+{
+	size_t res = 0U;
+
+	FILE* f = OpenFile(vFilePathName, "rb");
+	if (f)
+	{
+		if (fseek(f, 0, SEEK_END) == 0)
+		{
+			const long size = ftell(f);
+			if (size > 0)
+				res = (size_t)size;
+		}
+		fclose(f);
+	}
+
+	return res;
+}
+
+bool ProjectCompactFile::IsFileExist(const std::string& vFilePathName)
+{
+	FILE* f = OpenFile(vFilePathName, "rb");
+	if (f)
+	{
+		fclose(f);
+		return true;
+	}
+	return false;
+}
+
+std::string ProjectCompactFile::GetTmpFilePathName(const std::string& vFilePathName)
+{
+	return vFilePathName + ".tmp";
+}
+
+// the file, or his temporary file if the file is missing (crash during the replace)
+std::string ProjectCompactFile::GetLoadableFilePathName(const std::string& vFilePathName)
+{
+	if (!IsFileExist(vFilePathName))
+	{
+		const std::string tmpFilePathName = GetTmpFilePathName(vFilePathName);
+		if (IsFileExist(tmpFilePathName))
+			return tmpFilePathName;
+	}
+	return vFilePathName;
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2020 Stephane Cuillerdier (aka Aiekick)
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <map>
+
+// compact project file (.ifsb), the xml project file (.ifs) is kept for import / export
+//
+// the file is a magic + version, followed by records :
+// [type:u8][size:u32][payload:size bytes][checksum:u32]
+// - the settings record is the xml of the project without the glyphs (small)
+// - the glyphs records are columnar binary arrays, per font
+// a save append only the diff with the last save (the journal),
+// the file is rewritten (compacted) when the journal become bigger than the snapshot
+// a truncated or corrupted record at end (crash during a save) is ignored at load
+
+#define PROJECT_COMPACT_FILE_EXT "ifsb"
+#define PROJECT_COMPACT_XML_USER_DATAS "compact" // user datas of getXml for not write the glyphs in the xml
+
+struct GlyphRecordStruct
+{
+	uint32_t orgCodePoint = 0U;
+	uint32_t newCodePoint = 0U;
+	std::string orgName;
+	std::string newName;
+	float translation[2] = { 0.0f, 0.0f };
+	float scale[2] = { 1.0f, 1.0f };
+
+	bool operator == (const GlyphRecordStruct& v) const;
+	bool operator != (const GlyphRecordStruct& v) const { return !(*this == v); }
+};
+
+typedef std::map<uint32_t, GlyphRecordStruct> GlyphRecordsMap; // key is orgCodePoint
+
+struct ProjectCompactDatas
+{
+	std::string settings; // xml
+	std::map<std::string, GlyphRecordsMap> glyphs; // key is font name
+
+	void Clear();
+};
+
+class MemoryStream;
+class ProjectCompactFile
+{
+private:
+	enum class RecordTypeEnum : uint8_t
+	{
+		RECORD_SETTINGS = 1, // replace the settings
+		RECORD_GLYPHS_SET, // replace all the glyphs of a font
+		RECORD_GLYPHS_UPSERT, // add or replace some glyphs of a font
+		RECORD_GLYPHS_ERASE, // remove some glyphs of a font
+		RECORD_SNAPSHOT_END, // end of the full save, the next records are the journal
+	};
+
+private:
+	// state of the file after the last load or save, for the journal
+	std::string m_FilePathName;
+	ProjectCompactDatas m_LastSaved;
+	size_t m_FileSize = 0U;
+	size_t m_SnapshotSize = 0U;
+	size_t m_CountJournalRecords = 0U;
+
+public:
+	static bool IsCompactFile(const std::string& vFilePathName);
+	static bool IsCompactFilePathName(const std::string& vFilePathName); // by extention
+
+public:
+	void Clear();
+	bool Load(const std::string& vFilePathName, ProjectCompactDatas* vOutDatas);
+	bool Save(const std::string& vFilePathName, ProjectCompactDatas vDatas);
+
+	size_t GetCountJournalRecords() const { return m_CountJournalRecords; }
+	size_t GetJournalSize() const { return m_FileSize - m_SnapshotSize; }
+
+private:
+	bool WriteSnapshot(const std::string& vFilePathName, ProjectCompactDatas& vDatas);
+	bool AppendJournal(ProjectCompactDatas& vDatas, bool* vNeedSnapshot);
+
+	static void WriteFileHeader(MemoryStream* vStream);
+	static void WriteRecord(MemoryStream* vStream, RecordTypeEnum vType, MemoryStream* vPayload);
+	static void WriteGlyphsPayload(MemoryStream* vStream, const std::string& vFontName, const GlyphRecordsMap& vGlyphs);
+	static void WriteErasePayload(MemoryStream* vStream, const std::string& vFontName, const GlyphRecordsMap& vGlyphs);
+	static void WriteString(MemoryStream* vStream, const std::string& vString);
+	static std::string ReadString(MemoryStream* vStream);
+	static bool ReadGlyphsPayload(MemoryStream* vStream, std::string* vFontName, GlyphRecordsMap* vGlyphs);
+	static bool ReadErasePayload(MemoryStream* vStream, std::string* vFontName, GlyphRecordsMap* vGlyphs);
+	static bool WriteFile(const std::string& vFilePathName, MemoryStream* vStream, bool vAppend);
+	static bool ReplaceFile(const std::string& vSrcFilePathName, const std::string& vDstFilePathName);
+	static size_t GetFileSize(const std::string& vFilePathName);
+	static bool IsFileExist(const std::string& vFilePathName);
+	static std::string GetTmpFilePathName(const std::string& vFilePathName);
+	static std::string GetLoadableFilePathName(const std::string& vFilePathName);
+};
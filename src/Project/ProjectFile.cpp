@@ -19,6 +19,7 @@
 #include "ProjectFile.h"
 
 #include <Helper/Messaging.h>
+#include <Helper/FontPrefetcher.h>
 #include <Helper/SelectionHelper.h>
 #include <ctools/FileHelper.h>
 #include <Gui/ImWidgets.h>
@@ -45,6 +46,9 @@ void ProjectFile::Clear()
 	m_MergedFontPrefix.clear();
 	m_MergedCardGlyphHeightInPixel = 40U;
 	m_MergedCardCountRowsMax = 20U;
+	m_AtlasSdfGlyphSizeInPixel = SDF_ATLAS_DEFAULT_GLYPH_SIZE;
+	m_AtlasSdfPxRange = SDF_ATLAS_DEFAULT_PX_RANGE;
+	m_HeaderRangesGapTolerance = 0U;
 	m_Fonts.clear();
 	m_ShowRangeColoring = false;
 	m_RangeColoringHash = ImVec4(10, 15, 35, 0.5f);
@@ -55,11 +59,14 @@ void ProjectFile::Clear()
 	m_IsLoaded = false;
 	m_IsThereAnyNotSavedChanged = false;
 	m_GenModeFlags = GENERATOR_MODE_CURRENT_HEADER_CARD |
-		GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES;
+		GENERATOR_MODE_FONT_SETTINGS_USE_POST_TABLES |
+		GENERATOR_MODE_SKIP_UNCHANGED_OUTPUTS;
 	m_SourcePane_ShowGlyphTooltip = true;
 	m_FinalPane_ShowGlyphTooltip = true;
 	m_CurrentPane_ShowGlyphTooltip = true;
 	m_FontTestInfos.Clear();
+	m_CompactFile.Clear();
+	FontPrefetcher::Instance()->Clear();
 	SelectionHelper::Instance()->Clear();
 	Messaging::Instance()->Clear();
 }
@@ -98,45 +105,73 @@ bool ProjectFile::LoadAs(const std::string vFilePathName)
 	if (!vFilePathName.empty())
 	{
 		std::string filePathName = FileHelper::Instance()->SimplifyFilePath(vFilePathName);
-		tinyxml2::XMLError xmlError = LoadConfigFile(filePathName);
-		if (xmlError == tinyxml2::XMLError::XML_SUCCESS)
+		if (ProjectCompactFile::IsCompactFile(filePathName))
 		{
-			m_ProjectFilePathName = filePathName;
-			auto ps = FileHelper::Instance()->ParsePathFileName(m_ProjectFilePathName);
-			if (ps.isOk)
+			if (LoadCompactFile(filePathName))
 			{
-				m_ProjectFilePath = ps.path;
+				OnLoaded(filePathName);
 			}
-			if (m_SelectedFont)
+			else
 			{
-				m_LastGeneratedFileName = m_SelectedFont->m_FontFileName;
-			}
-			m_IsLoaded = true;
-			SetProjectChange(false);
+				Clear();
 
-			// we do that after m_IsLoaded
-			SelectionHelper::Instance()->Load(); // first
-			m_FontTestInfos.Load(); // then because use final selection from SelectionHelper
+				Messaging::Instance()->AddError(true, nullptr, nullptr,
+					"The project file %s cant be loaded, Error : bad compact file", filePathName.c_str());
+			}
 		}
 		else
 		{
-			Clear();
+			tinyxml2::XMLError xmlError = LoadConfigFile(filePathName);
+			if (xmlError == tinyxml2::XMLError::XML_SUCCESS)
+			{
+				OnLoaded(filePathName);
+			}
+			else
+			{
+				Clear();
 
-			auto errMsg = getTinyXml2ErrorMessage(xmlError);
-			Messaging::Instance()->AddError(true, nullptr, nullptr,
-				"The project file %s cant be loaded, Error : %s", filePathName.c_str(), errMsg.c_str());
+				auto errMsg = getTinyXml2ErrorMessage(xmlError);
+				Messaging::Instance()->AddError(true, nullptr, nullptr,
+					"The project file %s cant be loaded, Error : %s", filePathName.c_str(), errMsg.c_str());
+			}
 		}
 	}
 
 	return m_IsLoaded;
 }
 
+void ProjectFile::OnLoaded(const std::string& vFilePathName)
+{
+	m_ProjectFilePathName = vFilePathName;
+	auto ps = FileHelper::Instance()->ParsePathFileName(m_ProjectFilePathName);
+	if (ps.isOk)
+	{
+		m_ProjectFilePath = ps.path;
+	}
+	if (m_SelectedFont)
+	{
+		m_LastGeneratedFileName = m_SelectedFont->m_FontFileName;
+	}
+	m_IsLoaded = true;
+	SetProjectChange(false);
+
+	// we do that after m_IsLoaded
+	SelectionHelper::Instance()->Load(); // first
+	m_FontTestInfos.Load(); // then because use final selection from SelectionHelper
+}
+
 bool ProjectFile::Save()
 {
 	if (m_NeverSaved) 
 		return false;
 
-	if (SaveConfigFile(m_ProjectFilePathName))
+	bool res = false;
+	if (ProjectCompactFile::IsCompactFilePathName(m_ProjectFilePathName))
+		res = SaveCompactFile(m_ProjectFilePathName);
+	else // xml, for import / export
+		res = SaveConfigFile(m_ProjectFilePathName);
+
+	if (res)
 	{
 		SetProjectChange(false);
 		return true;
@@ -151,7 +186,9 @@ bool ProjectFile::SaveAs(const std::string& vFilePathName)
 	auto ps = FileHelper::Instance()->ParsePathFileName(filePathName);
 	if (ps.isOk)
 	{
-		m_ProjectFilePathName = FileHelper::Instance()->ComposePath(ps.path, ps.name, "ifs");
+		// the compact format is kept only if asked, else xml
+		const std::string ext = (ps.ext == PROJECT_COMPACT_FILE_EXT) ? PROJECT_COMPACT_FILE_EXT : "ifs";
+		m_ProjectFilePathName = FileHelper::Instance()->ComposePath(ps.path, ps.name, ext);
 		m_ProjectFilePath = ps.path;
 		m_NeverSaved = false;
 		return Save();
@@ -242,6 +279,89 @@ std::shared_ptr<FontInfos> ProjectFile::GetFontWithFontName(const std::string& v
 	return 0;
 }
 
+//////////////////////////////////////////////////////////////////////////////
+//// COMPACT FILE ////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+// the settings are the xml without the glyphs, the glyphs are binary records
+bool ProjectFile::LoadCompactFile(const std::string& vFilePathName)
+{
+	ProjectCompactDatas datas;
+	if (!m_CompactFile.Load(vFilePathName, &datas))
+		return false;
+
+	tinyxml2::XMLDocument doc;
+	if (doc.Parse(datas.settings.c_str(), datas.settings.size()) != tinyxml2::XMLError::XML_SUCCESS)
+		return false;
+
+	tinyxml2::XMLElement* root = doc.FirstChildElement("config");
+	if (!root)
+		return false;
+
+	for (tinyxml2::XMLElement* child = root->FirstChildElement(); child != nullptr; child = child->NextSiblingElement())
+	{
+		RecursParsingConfig(child->ToElement(), root);
+	}
+
+	for (auto& font : datas.glyphs)
+	{
+		auto fontInfos = GetFontWithFontName(font.first);
+		if (fontInfos)
+		{
+			for (auto& it : font.second)
+			{
+				auto& record = it.second;
+				ImFontGlyph g = {};
+				g.Codepoint = record.orgCodePoint;
+				fontInfos->m_SelectedGlyphs[record.orgCodePoint] = GlyphInfos::Create(
+					fontInfos, g, record.orgName, record.newName, record.newCodePoint,
+					ImVec2(record.translation[0], record.translation[1]),
+					ImVec2(record.scale[0], record.scale[1]));
+			}
+		}
+	}
+
+	return true;
+}
+
+bool ProjectFile::SaveCompactFile(const std::string& vFilePathName)
+{
+	ProjectCompactDatas datas;
+	datas.settings = "<config>\n" + getXml("\t", PROJECT_COMPACT_XML_USER_DATAS) + "</config>\n";
+
+	for (const auto& font : m_Fonts)
+	{
+		if (font.second && !font.second->m_SelectedGlyphs.empty())
+		{
+			auto& records = datas.glyphs[font.first];
+			for (const auto& it : font.second->m_SelectedGlyphs)
+			{
+				if (it.second)
+				{
+					auto& record = records[it.first];
+					record.orgCodePoint = it.second->glyph.Codepoint;
+					record.newCodePoint = it.second->newCodePoint;
+					record.orgName = it.second->oldHeaderName;
+					record.newName = it.second->newHeaderName;
+					record.translation[0] = it.second->m_Translation.x;
+					record.translation[1] = it.second->m_Translation.y;
+					record.scale[0] = it.second->m_Scale.x;
+					record.scale[1] = it.second->m_Scale.y;
+				}
+			}
+		}
+	}
+
+	if (!m_CompactFile.Save(vFilePathName, std::move(datas)))
+	{
+		Messaging::Instance()->AddError(true, nullptr, nullptr,
+			"The project file %s cant be saved", vFilePathName.c_str());
+		return false;
+	}
+
+	return true;
+}
+
 bool ProjectFile::CollapsingHeader_Centered(const char* vName, float vWidth, bool& vCollapsed)
 {
 	bool res = false;
@@ -257,7 +377,7 @@ bool ProjectFile::CollapsingHeader_Centered(const char* vName, float vWidth, boo
 	return res;
 }
 
-std::string ProjectFile::getXml(const std::string& vOffset, const std::string& /*vUserDatas*/)
+std::string ProjectFile::getXml(const std::string& vOffset, const std::string& vUserDatas)
 {
 	std::string str;
 
@@ -268,7 +388,7 @@ std::string ProjectFile::getXml(const std::string& vOffset, const std::string& /
 		{
 			if (it.second)
 			{
-				str += it.second->getXml(vOffset + "\t");
+				str += it.second->getXml(vOffset + "\t", vUserDatas);
 			}
 		}
 	}
@@ -280,6 +400,9 @@ std::string ProjectFile::getXml(const std::string& vOffset, const std::string& /
 	str += vOffset + "\t<mergedfontprefix>" + m_MergedFontPrefix + "</mergedfontprefix>\n";
 	str += vOffset + "\t<mergedcardglyhpheight>" + ct::toStr(m_MergedCardGlyphHeightInPixel) + "</mergedcardglyhpheight>\n";
 	str += vOffset + "\t<mergedcardcountrowsmax>" + ct::toStr(m_MergedCardCountRowsMax) + "</mergedcardcountrowsmax>\n";
+	str += vOffset + "\t<atlassdfglyphsize>" + ct::toStr(m_AtlasSdfGlyphSizeInPixel) + "</atlassdfglyphsize>\n";
+	str += vOffset + "\t<atlassdfpxrange>" + ct::toStr(m_AtlasSdfPxRange) + "</atlassdfpxrange>\n";
+	str += vOffset + "\t<headerrangesgap>" + ct::toStr(m_HeaderRangesGapTolerance) + "</headerrangesgap>\n";
 	str += vOffset + "\t<curglyphtooltip>" + (m_CurrentPane_ShowGlyphTooltip ? "true" : "false") + "</curglyphtooltip>\n";
 	str += vOffset + "\t<srcglyphtooltip>" + (m_SourcePane_ShowGlyphTooltip ? "true" : "false") +"</srcglyphtooltip>\n";
 	str += vOffset + "\t<dstglyphtooltip>" + (m_FinalPane_ShowGlyphTooltip ? "true" : "false") +"</dstglyphtooltip>\n";
@@ -362,6 +485,12 @@ bool ProjectFile::setFromXml(tinyxml2::XMLElement* vElem, tinyxml2::XMLElement*
 			m_MergedCardGlyphHeightInPixel = ct::uvariant(strValue).GetU();
 		else if (strName == "mergedcardcountrowsmax")
 			m_MergedCardCountRowsMax = ct::uvariant(strValue).GetU();
+		else if (strName == "atlassdfglyphsize")
+			m_AtlasSdfGlyphSizeInPixel = ct::uvariant(strValue).GetU();
+		else if (strName == "atlassdfpxrange")
+			m_AtlasSdfPxRange = ct::fvariant(strValue).GetF();
+		else if (strName == "headerrangesgap")
+			m_HeaderRangesGapTolerance = ct::uvariant(strValue).GetU();
 		else if (strName == "genmodeflags")
 			m_GenModeFlags = (GenModeFlags)ct::ivariant(strValue).GetI();
 		else if (strName == "fonttomergein")
@@ -22,8 +22,10 @@
 
 #include <Project/FontInfos.h>
 #include <Project/FontTestInfos.h>
+#include <Project/ProjectCompactFile.h>
 #include <Generator/Generator.h>
 #include <Generator/GenMode.h>
+#include <Generator/SdfGenerator.h>
 
 enum SourceFontPaneFlags
 {
@@ -54,6 +56,9 @@ public: // to save
 	std::string m_MergedFontPrefix;
 	uint32_t m_MergedCardGlyphHeightInPixel = 40U; // glyph item height in card
 	uint32_t m_MergedCardCountRowsMax = 20U; // after this max, new columns
+	uint32_t m_AtlasSdfGlyphSizeInPixel = SDF_ATLAS_DEFAULT_GLYPH_SIZE; // glyph height in the distance field atlas
+	float m_AtlasSdfPxRange = SDF_ATLAS_DEFAULT_PX_RANGE; // distance range in texels
+	uint32_t m_HeaderRangesGapTolerance = 0U; // max codepoints gap merged in one range of the header glyph ranges
 	bool m_CurrentPane_ShowGlyphTooltip = true;
 	bool m_SourcePane_ShowGlyphTooltip = true;
 	bool m_FinalPane_ShowGlyphTooltip = true;
@@ -86,6 +91,7 @@ private: // dont save
 	bool m_IsLoaded = false;
 	bool m_NeverSaved = false;
 	bool m_IsThereAnyNotSavedChanged = false;
+	ProjectCompactFile m_CompactFile; // journal state of the compact project file
 
 public:
 	ProjectFile();
@@ -114,6 +120,11 @@ public:
 
 	std::shared_ptr<FontInfos> GetFontWithFontName(const std::string& vFontName);
 
+private: // compact file
+	bool LoadCompactFile(const std::string& vFilePathName);
+	bool SaveCompactFile(const std::string& vFilePathName);
+	void OnLoaded(const std::string& vFilePathName);
+
 public: // UI
 	bool CollapsingHeader_Centered(const char* vName, float vWidth, bool& vCollapsed);
 
@@ -18,7 +18,6 @@ enum PaneFlags_
 	STRUCTURE_PANE = (1 << 5),
 	GLYPH_PANE = (1 << 6),
 	PREVIEW_PANE = (1 << 7),
-#ifdef _DEBUG
-	DEBUG_PANE = (1 << 8)
-#endif
+	DEBUG_PANE = (1 << 8), // glyph points in debug, frame profiler in all builds
+	MEMORY_PANE = (1 << 9)
 };
\ No newline at end of file